@@ -0,0 +1,175 @@
+﻿// © 2025 UnrealStudy. All rights reserved.
+// Author: taru00@gmail.com | https://x.com/3devnote
+
+#include "BallCollisionCorridor.h"
+#include "BallSimKernel.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/World.h"
+#include "Components/PrimitiveComponent.h"
+#include "PhysicsEngine/BodyInstance.h"
+
+static TAutoConsoleVariable<int32> CVarBallCorridorSegments(
+	TEXT("BallSim.Corridor.Segments"),
+	8,
+	TEXT("통로를 나누는 박스 구간 수"));
+
+static TAutoConsoleVariable<float> CVarBallCorridorMaxDuration(
+	TEXT("BallSim.Corridor.MaxDuration"),
+	2.0f,
+	TEXT("한번에 예측하는 통로 길이 (초), 벗어나면 다시 모음"));
+
+static TAutoConsoleVariable<float> CVarBallCorridorMargin(
+	TEXT("BallSim.Corridor.Margin"),
+	50.f,
+	TEXT("통로 박스에 더하는 여유 (cm)"));
+
+void FBallCollisionCorridor::Reset(float InEndTime)
+{
+	Segments.Reset();
+	Candidates.Reset();
+	EndTime = InEndTime;
+	NumGathers = 0;
+}
+
+bool FBallCollisionCorridor::Contains(const FVector& Position, float Inset) const
+{
+	for (const FBox& Segment : Segments)
+	{
+		if (Segment.ExpandBy(-Inset).IsInsideOrOn(Position))
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool FBallCollisionCorridor::HasStaleCandidates() const
+{
+	for (const TWeakObjectPtr<UPrimitiveComponent>& Candidate : Candidates)
+	{
+		const UPrimitiveComponent* Component = Candidate.Get();
+		if (!Component || !Component->IsRegistered())
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void FBallCollisionCorridor::Gather(const FBallSimContext& Context, float Time, const FVector& Position, const FVector& Velocity, const FVector& AngularVelocity)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FBallCollisionCorridor::Gather);
+
+	const FBallSimConstants& C = Context.Constants;
+	const float Radius = Context.CollisionShape.GetSphereRadius();
+	const float Speed = Velocity.Size();
+
+	// 탄도에서 벗어나게 하는 가속도 상한 (감쇠, 마그누스, 항력 / 양력 테이블 최대 계수)
+	float Deviation = Speed * C.LinearDamping + C.SpinMagnusFactor * Speed * AngularVelocity.Size();
+	if (const FBallAeroTable* Aero = C.AeroTable.Get())
+	{
+		float MaxCoefficient = 0.f;
+		for (int32 Index = 0; Index < Aero->Drag.Num(); ++Index)
+		{
+			MaxCoefficient = FMath::Max(MaxCoefficient, FMath::Abs(Aero->Drag[Index]) + FMath::Abs(Aero->Lift[Index]));
+		}
+		Deviation = FMath::Max(Deviation, C.AeroForceScale * Speed * Speed * MaxCoefficient);
+	}
+
+	const int32 NumSegments = FMath::Max(CVarBallCorridorSegments.GetValueOnAnyThread(), 1);
+	const float Duration = FMath::Clamp(EndTime - Time, C.StepInterval, FMath::Max(CVarBallCorridorMaxDuration.GetValueOnAnyThread(), C.StepInterval));
+	// 모은 직후 시작 위치가 Contains 검사 (반지름 + 한 스텝 이동) 를 통과하도록 한 스텝 이동 거리를 더함
+	const float Margin = Radius + Speed * C.StepInterval + CVarBallCorridorMargin.GetValueOnAnyThread();
+
+	auto Estimate = [&](float T)
+	{
+		return Position + Velocity * T + 0.5f * FVector(C.Gravity) * T * T;
+	};
+
+	// 구간마다 양 끝 추정 위치를 감싸는 박스를 편차 상한 (0.5 a t²) 만큼 부풀림
+	Segments.Reset();
+	FVector SegmentStart = Position;
+	for (int32 Index = 1; Index <= NumSegments; ++Index)
+	{
+		const float T = Duration * Index / NumSegments;
+		const FVector SegmentEnd = Estimate(T);
+
+		FBox Segment(ForceInit);
+		Segment += SegmentStart;
+		Segment += SegmentEnd;
+		Segments.Add(Segment.ExpandBy(Margin + 0.5f * Deviation * T * T));
+		SegmentStart = SegmentEnd;
+	}
+
+	// 구간 박스마다 Overlap 해서 블로킹 충돌체를 중복 없이 모음
+	Candidates.Reset();
+	TArray<FOverlapResult> Overlaps;
+	for (const FBox& Segment : Segments)
+	{
+		Overlaps.Reset();
+		Context.World->OverlapMultiByChannel(Overlaps, Segment.GetCenter(), FQuat::Identity, ECC_WorldStatic,
+			FCollisionShape::MakeBox(Segment.GetExtent()), Context.QueryParams);
+
+		for (const FOverlapResult& Overlap : Overlaps)
+		{
+			UPrimitiveComponent* Component = Overlap.GetComponent();
+			if (Overlap.bBlockingHit && Component && Component->IsRegistered())
+			{
+				Candidates.AddUnique(Component);
+			}
+		}
+	}
+
+	INC_DWORD_STAT(STAT_BallCorridorGathers);
+	if (NumGathers > 0)
+	{
+		INC_DWORD_STAT(STAT_BallCorridorRegathers);
+	}
+	SET_DWORD_STAT(STAT_BallCorridorCandidates, Candidates.Num());
+	++NumGathers;
+}
+
+bool FBallCollisionCorridor::Sweep(const FBallSimContext& Context, const FBallSimState& State, const FVector& Start, const FVector& End, FHitResult& OutHit)
+{
+	// 박스는 반지름만큼 부풀려서 모았으므로 구 전체가 박스 안에 있어야 후보 밖 충돌체와 닿지 않음
+	// 시작 위치가 (반지름 + 이동 거리) 만큼 줄인 박스 안이면 이번 Sweep 의 구 전체가 그 박스 안에 있음
+	// 후보가 제거되거나 등록 해제되었으면 그 자리의 충돌체 구성이 바뀌었을 수 있으므로 다시 모음
+	const float Inset = Context.CollisionShape.GetSphereRadius() + FVector::Dist(Start, End);
+	if (Segments.Num() == 0 || !Contains(Start, Inset) || HasStaleCandidates())
+	{
+		Gather(Context, State.Time, Start, FVector(State.LinearVelocity), FVector(State.AngularVelocity));
+	}
+
+	bool bHit = false;
+	FHitResult Hit;
+	for (const TWeakObjectPtr<UPrimitiveComponent>& Candidate : Candidates)
+	{
+		// 검사 이후에 제거될 수 있으므로 Sweep 직전에 다시 확인
+		UPrimitiveComponent* Component = Candidate.Get();
+		if (!Component || !Component->IsRegistered())
+		{
+			continue;
+		}
+
+		if (Component->SweepComponent(Hit, Start, End, FQuat::Identity, Context.CollisionShape, Context.QueryParams.bTraceComplex)
+			&& (!bHit || Hit.Time < OutHit.Time))
+		{
+			OutHit = Hit;
+			bHit = true;
+		}
+	}
+
+	// 컴포넌트 Sweep 은 물리 재질을 채우지 않으므로 바디의 단순 충돌 재질 사용
+	if (bHit && Context.QueryParams.bReturnPhysicalMaterial && !OutHit.PhysMaterial.IsValid())
+	{
+		if (UPrimitiveComponent* Component = OutHit.GetComponent())
+		{
+			if (const FBodyInstance* BodyInstance = Component->GetBodyInstance())
+			{
+				OutHit.PhysMaterial = BodyInstance->GetSimplePhysicalMaterial();
+			}
+		}
+	}
+
+	return bHit;
+}
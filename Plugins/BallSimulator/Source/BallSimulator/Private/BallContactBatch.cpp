@@ -0,0 +1,176 @@
+﻿// © 2025 UnrealStudy. All rights reserved.
+// Author: taru00@gmail.com | https://x.com/3devnote
+
+#include "BallContactBatch.h"
+
+FORCEINLINE void FBallContactBatch::ResolveLane(float* RESTRICT const* Channel, int32 i)
+{
+	// 분기 대신 Min / Max / 선택으로 처리 (HandleCollision 단일 충돌 응답과 같은 모델)
+	const float rx = Channel[ArmX][i], ry = Channel[ArmY][i], rz = Channel[ArmZ][i];
+	const float mx = Channel[ImpactNormalX][i], my = Channel[ImpactNormalY][i], mz = Channel[ImpactNormalZ][i];
+	const float wx = Channel[AngularX][i], wy = Channel[AngularY][i], wz = Channel[AngularZ][i];
+
+	// 접촉점 상대 속도 = v + ω × r - 상대 접촉점 속도
+	const float cx = Channel[LinearX][i] + (wy * rz - wz * ry) - Channel[SurfaceX][i];
+	const float cy = Channel[LinearY][i] + (wz * rx - wx * rz) - Channel[SurfaceY][i];
+	const float cz = Channel[LinearZ][i] + (wx * ry - wy * rx) - Channel[SurfaceZ][i];
+
+	const float vRel = cx * Channel[NormalX][i] + cy * Channel[NormalY][i] + cz * Channel[NormalZ][i];
+
+	// denom = m⁻¹ + m_other⁻¹ + [((I⁻¹ + I_other⁻¹) * (r × n)) × r]⋅n (상대 공의 팔 -r 은 부호가 두 번 바뀌어 같은 항)
+	const float ix = Channel[InvInertiaX][i] + Channel[OtherInvInertiaX][i];
+	const float iy = Channel[InvInertiaY][i] + Channel[OtherInvInertiaY][i];
+	const float iz = Channel[InvInertiaZ][i] + Channel[OtherInvInertiaZ][i];
+	const float tx = ix * (ry * mz - rz * my);
+	const float ty = iy * (rz * mx - rx * mz);
+	const float tz = iz * (rx * my - ry * mx);
+	const float denom = Channel[InvMass][i] + Channel[OtherInvMass][i]
+		+ (ty * rz - tz * ry) * mx + (tz * rx - tx * rz) * my + (tx * ry - ty * rx) * mz;
+	const float invDenom = 1.f / denom;
+
+	const float impulse = FMath::Clamp(-(1.f + Channel[Restitution][i]) * vRel * invDenom, 0.f, Channel[MaxImpulse][i]);
+
+	// 쿠롱 마찰, 접선 속도가 없으면 방향이 0 이므로 마찰 임펄스도 0
+	const float vx = cx - vRel * mx;
+	const float vy = cy - vRel * my;
+	const float vz = cz - vRel * mz;
+	const float tangentSpeed = FMath::Sqrt(vx * vx + vy * vy + vz * vz);
+	const float invTangentSpeed = tangentSpeed > KINDA_SMALL_NUMBER ? 1.f / tangentSpeed : 0.f;
+	const float dx = vx * invTangentSpeed;
+	const float dy = vy * invTangentSpeed;
+	const float dz = vz * invTangentSpeed;
+
+	const float maxFriction = impulse * Channel[Friction][i];
+	const float tangentImpulse = FMath::Clamp(-(cx * dx + cy * dy + cz * dz) * invDenom, -maxFriction, maxFriction);
+	const float fx = tangentImpulse * dx;
+	const float fy = tangentImpulse * dy;
+	const float fz = tangentImpulse * dz;
+
+	Channel[OutRelativeVelocity][i] = vRel;
+	Channel[OutNormalImpulse][i] = impulse;
+	Channel[OutFrictionX][i] = fx;
+	Channel[OutFrictionY][i] = fy;
+	Channel[OutFrictionZ][i] = fz;
+
+	// Δω = I⁻¹ * (r × J)
+	Channel[OutAngularDeltaX][i] = Channel[InvInertiaX][i] * (ry * fz - rz * fy);
+	Channel[OutAngularDeltaY][i] = Channel[InvInertiaY][i] * (rz * fx - rx * fz);
+	Channel[OutAngularDeltaZ][i] = Channel[InvInertiaZ][i] * (rx * fy - ry * fx);
+}
+
+void FBallContactBatch::Reset()
+{
+	Blocks.Reset();
+	NumContacts = 0;
+}
+
+int32 FBallContactBatch::Add(const FBallContactInput& Contact)
+{
+	const int32 Lane = NumContacts % LaneWidth;
+	if (Lane == 0)
+	{
+		// 빈 레인이 0 으로 나누지 않도록 새 블록은 기본 입력으로 채움
+		const int32 BlockStart = Blocks.AddUninitialized(BlockSize);
+		const FBallContactInput Default;
+		for (int32 i = 0; i < LaneWidth; ++i)
+		{
+			WriteLane(Blocks.GetData() + BlockStart, LaneWidth, i, Default);
+		}
+	}
+
+	WriteLane(Blocks.GetData() + (NumContacts / LaneWidth) * BlockSize, LaneWidth, Lane, Contact);
+	return NumContacts++;
+}
+
+void FBallContactBatch::Resolve()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FBallContactBatch::Resolve);
+	INC_DWORD_STAT_BY(STAT_BallBatchedContacts, NumContacts);
+
+	for (int32 BlockStart = 0; BlockStart < Blocks.Num(); BlockStart += BlockSize)
+	{
+		ResolveBlock(Blocks.GetData() + BlockStart);
+	}
+}
+
+FBallContactResult FBallContactBatch::GetResult(int32 Index) const
+{
+	check(Index >= 0 && Index < NumContacts);
+	return ReadLane(Blocks.GetData() + (Index / LaneWidth) * BlockSize, LaneWidth, Index % LaneWidth);
+}
+
+FBallContactResult FBallContactBatch::ResolveSingle(const FBallContactInput& Contact)
+{
+	float Values[NumChannels];
+	float* RESTRICT Channel[NumChannels];
+	for (int32 c = 0; c < NumChannels; ++c)
+	{
+		Channel[c] = Values + c;
+	}
+
+	WriteLane(Values, 1, 0, Contact);
+	ResolveLane(Channel, 0);
+	return ReadLane(Values, 1, 0);
+}
+
+void FBallContactBatch::WriteLane(float* Block, int32 Stride, int32 Lane, const FBallContactInput& Contact)
+{
+	const auto Write = [Block, Stride, Lane](EChannel Channel, float Value) { Block[Channel * Stride + Lane] = Value; };
+
+	Write(ArmX, Contact.Arm.X);
+	Write(ArmY, Contact.Arm.Y);
+	Write(ArmZ, Contact.Arm.Z);
+	Write(NormalX, Contact.Normal.X);
+	Write(NormalY, Contact.Normal.Y);
+	Write(NormalZ, Contact.Normal.Z);
+	Write(ImpactNormalX, Contact.ImpactNormal.X);
+	Write(ImpactNormalY, Contact.ImpactNormal.Y);
+	Write(ImpactNormalZ, Contact.ImpactNormal.Z);
+	Write(LinearX, Contact.LinearVelocity.X);
+	Write(LinearY, Contact.LinearVelocity.Y);
+	Write(LinearZ, Contact.LinearVelocity.Z);
+	Write(AngularX, Contact.AngularVelocity.X);
+	Write(AngularY, Contact.AngularVelocity.Y);
+	Write(AngularZ, Contact.AngularVelocity.Z);
+	Write(SurfaceX, Contact.SurfaceVelocity.X);
+	Write(SurfaceY, Contact.SurfaceVelocity.Y);
+	Write(SurfaceZ, Contact.SurfaceVelocity.Z);
+	Write(InvMass, Contact.InvMass);
+	Write(InvInertiaX, Contact.InvInertia.X);
+	Write(InvInertiaY, Contact.InvInertia.Y);
+	Write(InvInertiaZ, Contact.InvInertia.Z);
+	Write(OtherInvMass, Contact.OtherInvMass);
+	Write(OtherInvInertiaX, Contact.OtherInvInertia.X);
+	Write(OtherInvInertiaY, Contact.OtherInvInertia.Y);
+	Write(OtherInvInertiaZ, Contact.OtherInvInertia.Z);
+	Write(Restitution, Contact.Restitution);
+	Write(Friction, Contact.Friction);
+	Write(MaxImpulse, Contact.MaxImpulse);
+}
+
+FBallContactResult FBallContactBatch::ReadLane(const float* Block, int32 Stride, int32 Lane)
+{
+	const auto Read = [Block, Stride, Lane](EChannel Channel) { return Block[Channel * Stride + Lane]; };
+
+	FBallContactResult Result;
+	Result.vRel = Read(OutRelativeVelocity);
+	Result.NormalImpulse = Read(OutNormalImpulse);
+	Result.FrictionImpulse = FVector3f(Read(OutFrictionX), Read(OutFrictionY), Read(OutFrictionZ));
+	Result.AngularDelta = FVector3f(Read(OutAngularDeltaX), Read(OutAngularDeltaY), Read(OutAngularDeltaZ));
+	return Result;
+}
+
+void FBallContactBatch::ResolveBlock(float* Block)
+{
+	float* RESTRICT Channel[NumChannels];
+	for (int32 c = 0; c < NumChannels; ++c)
+	{
+		Channel[c] = Block + c * LaneWidth;
+	}
+
+	// 레인마다 같은 수식, 분기 없는 인라인 레인 함수라 컴파일러가 벡터화
+	for (int32 i = 0; i < LaneWidth; ++i)
+	{
+		ResolveLane(Channel, i);
+	}
+}
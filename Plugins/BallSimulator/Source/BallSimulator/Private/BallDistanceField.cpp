@@ -0,0 +1,230 @@
+﻿// © 2025 UnrealStudy. All rights reserved.
+// Author: taru00@gmail.com | https://x.com/3devnote
+
+#include "BallDistanceField.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/World.h"
+#include "Engine/LevelBounds.h"
+#include "EngineUtils.h"
+#include "Components/PrimitiveComponent.h"
+#include "Async/ParallelFor.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogBallDistanceField, Log, All);
+DEFINE_LOG_CATEGORY(LogBallDistanceField);
+
+static TAutoConsoleVariable<int32> CVarBallDistanceFieldEnable(
+	TEXT("BallSim.DistanceField.Enable"),
+	1,
+	TEXT("0 : 거리장이 있어도 매 스텝 Sweep"));
+
+static TAutoConsoleVariable<int32> CVarBallDistanceFieldBakeOnBeginPlay(
+	TEXT("BallSim.DistanceField.BakeOnBeginPlay"),
+	0,
+	TEXT("1 : BeginPlay 시 레벨 경계로 거리장 굽기"));
+
+static TAutoConsoleVariable<float> CVarBallDistanceFieldCellSize(
+	TEXT("BallSim.DistanceField.CellSize"),
+	50.f,
+	TEXT("거리장 셀 크기 (cm)"));
+
+static TAutoConsoleVariable<float> CVarBallDistanceFieldMaxDistance(
+	TEXT("BallSim.DistanceField.MaxDistance"),
+	2000.f,
+	TEXT("거리장에 저장하는 최대 여유 거리 (cm)"));
+
+namespace BallDistanceField
+{
+	// 이진 탐색 반복 횟수, 오차는 탐색 범위 / 2^N
+	static constexpr int32 SearchIterations = 8;
+
+	// Center 에 놓은 구가 정적 충돌체와 겹치지 않는 최대 반지름 (MaxRadius 이하, 내림)
+	static float FindFreeRadius(const UWorld* World, const FVector& Center, float MaxRadius, const FCollisionQueryParams& Params)
+	{
+		auto IsBlocked = [&](float Radius)
+		{
+			return World->OverlapBlockingTestByChannel(Center, FQuat::Identity, ECC_WorldStatic, FCollisionShape::MakeSphere(Radius), Params);
+		};
+
+		if (!IsBlocked(MaxRadius))
+		{
+			return MaxRadius;
+		}
+
+		float Free = 0.f;
+		float Blocked = MaxRadius;
+		for (int32 Iteration = 0; Iteration < SearchIterations; ++Iteration)
+		{
+			const float Radius = 0.5f * (Free + Blocked);
+			if (IsBlocked(Radius))
+			{
+				Blocked = Radius;
+			}
+			else
+			{
+				Free = Radius;
+			}
+		}
+		return Free;
+	}
+}
+
+void FBallDistanceField::Bake(UWorld* World, const FBox& Bounds, float InCellSize, float MaxDistance)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FBallDistanceField::Bake);
+
+	BrickClearance.Reset();
+	BrickDetail.Reset();
+	Detail.Reset();
+
+	if (!World || !Bounds.IsValid || InCellSize <= 0.f || MaxDistance <= 0.f)
+	{
+		return;
+	}
+
+	Origin = Bounds.Min;
+	CellSize = InCellSize;
+	InvCellSize = 1.f / InCellSize;
+
+	const float BrickSize = CellSize * BrickCells;
+	const FVector Size = Bounds.GetSize();
+	NumBricks = FIntVector(
+		FMath::Max(FMath::CeilToInt(Size.X / BrickSize), 1),
+		FMath::Max(FMath::CeilToInt(Size.Y / BrickSize), 1),
+		FMath::Max(FMath::CeilToInt(Size.Z / BrickSize), 1));
+	NumCells = NumBricks * BrickCells;
+
+	// 셀 값은 8 비트, 셀 크기 16 배까지 표현 (그보다 먼 셀은 보통 균일 브릭)
+	const float MaxCellDistance = FMath::Min(MaxDistance, CellSize * 16.f);
+	QuantizationStep = MaxCellDistance / 255.f;
+
+	FCollisionQueryParams Params(SCENE_QUERY_STAT(BallDistanceFieldBake), true);
+	Params.MobilityType = EQueryMobilityType::Static;
+
+	const int32 TotalBricks = NumBricks.X * NumBricks.Y * NumBricks.Z;
+	BrickClearance.SetNumZeroed(TotalBricks);
+	BrickDetail.Init(INDEX_NONE, TotalBricks);
+
+	// 브릭 중심의 여유 거리에서 브릭 외접구 반지름을 빼면 브릭 안 모든 점의 하한
+	// 셀 하나보다 가까우면 셀 단위로 다시 구움
+	const float BrickHalfDiagonal = 0.5f * BrickSize * UE_SQRT_3;
+	TArray<bool> NeedsDetail;
+	NeedsDetail.SetNumZeroed(TotalBricks);
+
+	ParallelFor(TotalBricks, [&](int32 Brick)
+	{
+		const int32 BX = Brick % NumBricks.X;
+		const int32 BY = (Brick / NumBricks.X) % NumBricks.Y;
+		const int32 BZ = Brick / (NumBricks.X * NumBricks.Y);
+		const FVector Center = Origin + (FVector(BX, BY, BZ) + 0.5f) * BrickSize;
+
+		const float Clearance = BallDistanceField::FindFreeRadius(World, Center, MaxDistance + BrickHalfDiagonal, Params) - BrickHalfDiagonal;
+		BrickClearance[Brick] = FMath::Max(Clearance, 0.f);
+		NeedsDetail[Brick] = Clearance < CellSize;
+	});
+
+	TArray<int32> DetailBricks;
+	for (int32 Brick = 0; Brick < TotalBricks; ++Brick)
+	{
+		if (NeedsDetail[Brick])
+		{
+			BrickDetail[Brick] = DetailBricks.Add(Brick);
+		}
+	}
+	Detail.SetNumZeroed(DetailBricks.Num() * CellsPerBrick);
+
+	const float CellHalfDiagonal = 0.5f * CellSize * UE_SQRT_3;
+	ParallelFor(DetailBricks.Num() * CellsPerBrick, [&](int32 Index)
+	{
+		const int32 Brick = DetailBricks[Index / CellsPerBrick];
+		const int32 Cell = Index % CellsPerBrick;
+		const int32 X = (Brick % NumBricks.X) * BrickCells + (Cell & BrickMask);
+		const int32 Y = ((Brick / NumBricks.X) % NumBricks.Y) * BrickCells + ((Cell >> BrickShift) & BrickMask);
+		const int32 Z = (Brick / (NumBricks.X * NumBricks.Y)) * BrickCells + (Cell >> (2 * BrickShift));
+		const FVector Center = Origin + (FVector(X, Y, Z) + 0.5f) * CellSize;
+
+		const float Clearance = BallDistanceField::FindFreeRadius(World, Center, MaxCellDistance + CellHalfDiagonal, Params) - CellHalfDiagonal;
+		Detail[Index] = (uint8)FMath::Clamp(FMath::FloorToInt(Clearance / QuantizationStep), 0, 255);
+	});
+
+	UE_LOG(LogBallDistanceField, Log, TEXT("Baked distance field : %d bricks (%d detailed), %.1f KB"),
+		TotalBricks, DetailBricks.Num(), GetAllocatedSize() / 1024.f);
+}
+
+bool UBallDistanceFieldSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	if (!Super::ShouldCreateSubsystem(Outer))
+	{
+		return false;
+	}
+
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void UBallDistanceFieldSubsystem::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	if (CVarBallDistanceFieldBakeOnBeginPlay.GetValueOnGameThread() != 0)
+	{
+		BakeDistanceField(FBox(ForceInit));
+	}
+}
+
+void UBallDistanceFieldSubsystem::BakeDistanceField(FBox Bounds)
+{
+	UWorld* World = GetWorld();
+	if (!World)
+	{
+		return;
+	}
+
+	if (!Bounds.IsValid && World->PersistentLevel)
+	{
+		Bounds = ALevelBounds::CalculateLevelBounds(World->PersistentLevel);
+	}
+
+	TSharedRef<FBallDistanceField, ESPMode::ThreadSafe> Field = MakeShared<FBallDistanceField, ESPMode::ThreadSafe>();
+	Field->Bake(World, Bounds, CVarBallDistanceFieldCellSize.GetValueOnGameThread(), CVarBallDistanceFieldMaxDistance.GetValueOnGameThread());
+	DistanceField = Field->IsEmpty() ? nullptr : TSharedPtr<const FBallDistanceField, ESPMode::ThreadSafe>(Field);
+}
+
+TSharedPtr<const FBallDistanceField, ESPMode::ThreadSafe> UBallDistanceFieldSubsystem::GetDistanceField() const
+{
+	return CVarBallDistanceFieldEnable.GetValueOnGameThread() != 0 ? DistanceField : nullptr;
+}
+
+TSharedPtr<const TArray<FBallMovableProxy>, ESPMode::ThreadSafe> UBallDistanceFieldSubsystem::GetMovableProxies()
+{
+	check(IsInGameThread());
+
+	// 같은 프레임의 시뮬레이션은 같은 목록을 공유, 진행 중인 시뮬레이션은 이전 목록을 유지
+	if (MovableProxies.IsValid() && MovableProxiesFrame == GFrameCounter)
+	{
+		return MovableProxies;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(UBallDistanceFieldSubsystem::GetMovableProxies);
+
+	TSharedRef<TArray<FBallMovableProxy>, ESPMode::ThreadSafe> Proxies = MakeShared<TArray<FBallMovableProxy>, ESPMode::ThreadSafe>();
+	for (TActorIterator<AActor> It(GetWorld()); It; ++It)
+	{
+		It->ForEachComponent<UPrimitiveComponent>(false, [&Proxies, Actor = *It](const UPrimitiveComponent* Primitive)
+		{
+			if (Primitive->Mobility == EComponentMobility::Movable
+				&& Primitive->IsRegistered()
+				&& Primitive->IsQueryCollisionEnabled()
+				&& Primitive->GetCollisionResponseToChannel(ECC_WorldStatic) == ECR_Block)
+			{
+				FBallMovableProxy& Proxy = Proxies->AddDefaulted_GetRef();
+				Proxy.Center = Primitive->Bounds.Origin;
+				Proxy.Radius = Primitive->Bounds.SphereRadius;
+				Proxy.ActorId = Actor->GetUniqueID();
+			}
+		});
+	}
+
+	MovableProxies = Proxies;
+	MovableProxiesFrame = GFrameCounter;
+	return MovableProxies;
+}
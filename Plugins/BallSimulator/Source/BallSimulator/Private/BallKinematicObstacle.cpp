@@ -0,0 +1,310 @@
+﻿// © 2025 UnrealStudy. All rights reserved.
+// Author: taru00@gmail.com | https://x.com/3devnote
+
+#include "BallKinematicObstacle.h"
+#include "Algo/UpperBound.h"
+#include "Algo/LowerBound.h"
+
+FVector FBallKinematicObstacle::GetPositionAtTime(float Time) const
+{
+	if (PoseKeys.Num() == 0)
+	{
+		return Position + Velocity * Time;
+	}
+
+	if (Time <= PoseKeys[0].Time)
+	{
+		return PoseKeys[0].Position;
+	}
+
+	if (Time >= PoseKeys.Last().Time)
+	{
+		return PoseKeys.Last().Position;
+	}
+
+	const int32 IndexB = Algo::UpperBoundBy(PoseKeys, Time, &FBallObstaclePoseKey::Time);
+	const FBallObstaclePoseKey& KeyA = PoseKeys[IndexB - 1];
+	const FBallObstaclePoseKey& KeyB = PoseKeys[IndexB];
+	const float KeyDuration = KeyB.Time - KeyA.Time;
+	const float Alpha = KeyDuration > KINDA_SMALL_NUMBER ? (Time - KeyA.Time) / KeyDuration : 1.f;
+
+	return FMath::Lerp(KeyA.Position, KeyB.Position, Alpha);
+}
+
+void FBallObstacleSet::Reset()
+{
+	Obstacles.Reset();
+	Windows.Reset();
+}
+
+void FBallObstacleSet::Build(TArrayView<const FBallKinematicObstacle> InObstacles, float InBallRadius, float InWindowDuration, float InEndTime)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FBallObstacleSet::Build);
+
+	Reset();
+
+	if (InObstacles.Num() == 0)
+	{
+		return;
+	}
+
+	Obstacles.Append(InObstacles.GetData(), InObstacles.Num());
+	BallRadius = InBallRadius;
+	WindowDuration = FMath::Max(InWindowDuration, KINDA_SMALL_NUMBER);
+
+	const int32 NumWindows = FMath::Max(FMath::CeilToInt(InEndTime / WindowDuration), 1);
+	Windows.SetNum(NumWindows);
+
+	// 윈도우별 (장애물, 이동 범위), 모두 구한 뒤 축을 골라 정렬
+	TArray<TArray<TPair<int32, FBox>>> WindowEntries;
+	WindowEntries.SetNum(NumWindows);
+
+	for (int32 ObstacleIndex = 0; ObstacleIndex < Obstacles.Num(); ++ObstacleIndex)
+	{
+		FBallKinematicObstacle& Obstacle = Obstacles[ObstacleIndex];
+		Obstacle.Axis = Obstacle.Axis.GetSafeNormal(SMALL_NUMBER, FVector::UpVector);
+		Obstacle.PoseKeys.StableSort([](const FBallObstaclePoseKey& A, const FBallObstaclePoseKey& B) { return A.Time < B.Time; });
+
+		// 캡슐 축 방향 반길이 + 반지름 + 공 반지름 만큼 확장
+		const FVector SegmentExtent = (Obstacle.Axis * Obstacle.GetSegmentHalfLength()).GetAbs();
+		const FVector Inflate = SegmentExtent + FVector(Obstacle.Radius + BallRadius);
+
+		for (int32 WindowIndex = 0; WindowIndex < NumWindows; ++WindowIndex)
+		{
+			const float WindowStart = WindowIndex * WindowDuration;
+			const float WindowEnd = WindowStart + WindowDuration;
+
+			// 윈도우 경계 위치 + 윈도우 내부의 키 위치로 이동 범위 계산 (키 사이는 선형이므로 정확함)
+			FBox Bounds(ForceInit);
+			Bounds += Obstacle.GetPositionAtTime(WindowStart);
+			Bounds += Obstacle.GetPositionAtTime(WindowEnd);
+			for (const FBallObstaclePoseKey& Key : Obstacle.PoseKeys)
+			{
+				if (Key.Time > WindowStart && Key.Time < WindowEnd)
+				{
+					Bounds += Key.Position;
+				}
+			}
+
+			WindowEntries[WindowIndex].Emplace(ObstacleIndex, Bounds.ExpandBy(Inflate));
+		}
+	}
+
+	for (int32 WindowIndex = 0; WindowIndex < NumWindows; ++WindowIndex)
+	{
+		TArray<TPair<int32, FBox>>& Entries = WindowEntries[WindowIndex];
+		FTimeWindow& Window = Windows[WindowIndex];
+
+		// 장애물 중심이 가장 넓게 퍼진 축으로 정렬 (수비벽처럼 한 줄로 선 경우에도 구간이 잘 나뉘도록)
+		FBox CenterBounds(ForceInit);
+		for (const TPair<int32, FBox>& Entry : Entries)
+		{
+			CenterBounds += Entry.Value.GetCenter();
+		}
+		const FVector Spread = CenterBounds.GetSize();
+		Window.SortAxis = Spread.X >= Spread.Y ? (Spread.X >= Spread.Z ? 0 : 2) : (Spread.Y >= Spread.Z ? 1 : 2);
+
+		const int32 Axis = Window.SortAxis;
+		Entries.Sort([Axis](const TPair<int32, FBox>& A, const TPair<int32, FBox>& B) { return A.Value.Min[Axis] < B.Value.Min[Axis]; });
+
+		Window.Candidates.Reserve(Entries.Num());
+		Window.Bounds.Reserve(Entries.Num());
+		Window.SortKeys.Reserve(Entries.Num());
+		for (const TPair<int32, FBox>& Entry : Entries)
+		{
+			Window.Candidates.Add(Entry.Key);
+			Window.Bounds.Add(Entry.Value);
+			Window.SortKeys.Add(Entry.Value.Min[Axis]);
+			Window.MaxExtent = FMath::Max(Window.MaxExtent, (float)(Entry.Value.Max[Axis] - Entry.Value.Min[Axis]));
+		}
+	}
+}
+
+void FBallObstacleSet::FTimeWindow::GetCandidateRange(const FBox& Query, int32& OutFirst, int32& OutLast) const
+{
+	// Min 이 Query.Max 보다 크면 겹치지 않음, Min 이 Query.Min - MaxExtent 보다 작으면 Max 가 Query.Min 에 닿지 못함
+	OutFirst = Algo::LowerBound(SortKeys, (float)(Query.Min[SortAxis] - MaxExtent));
+	OutLast = Algo::UpperBound(SortKeys, (float)Query.Max[SortAxis]);
+}
+
+int32 FBallObstacleSet::GetWindowIndex(float Time) const
+{
+	return FMath::Clamp(FMath::FloorToInt(Time / WindowDuration), 0, Windows.Num() - 1);
+}
+
+float FBallObstacleSet::IntersectSegmentCapsule(const FVector& S, const FVector& D, const FVector& A, const FVector& B, float R)
+{
+	const float RR = R * R;
+	const float DD = D | D;
+	const FVector BA = B - A;
+	const float BABA = BA | BA;
+
+	// 축 선분의 몸통(원기둥) 부분
+	if (BABA > KINDA_SMALL_NUMBER && DD > KINDA_SMALL_NUMBER)
+	{
+		const FVector OA = S - A;
+		const float BAD = BA | D;
+		const float BAOA = BA | OA;
+		const float DOA = D | OA;
+		const float OAOA = OA | OA;
+
+		const float a = BABA * DD - BAD * BAD;
+		const float b = BABA * DOA - BAOA * BAD;
+		const float c = BABA * OAOA - BAOA * BAOA - RR * BABA;
+		const float h = b * b - a * c;
+		if (a > KINDA_SMALL_NUMBER && h >= 0.f)
+		{
+			const float s = (-b - FMath::Sqrt(h)) / a;
+			const float y = BAOA + s * BAD;
+			if (y > 0.f && y < BABA)
+			{
+				return (s >= 0.f && s <= 1.f) ? s : -1.f;
+			}
+		}
+	}
+
+	// 양 끝 반구 (구체 장애물은 A == B)
+	if (DD <= KINDA_SMALL_NUMBER)
+	{
+		return -1.f;
+	}
+
+	float Result = -1.f;
+	for (const FVector& Cap : { A, B })
+	{
+		const FVector OC = S - Cap;
+		const float b = D | OC;
+		const float c = (OC | OC) - RR;
+		const float h = b * b - DD * c;
+		if (h >= 0.f)
+		{
+			const float s = (-b - FMath::Sqrt(h)) / DD;
+			if (s >= 0.f && s <= 1.f && (Result < 0.f || s < Result))
+			{
+				Result = s;
+			}
+		}
+	}
+	return Result;
+}
+
+bool FBallObstacleSet::Sweep(
+	const FVector& Start,
+	const FVector& End,
+	float StartTime,
+	float DeltaTime,
+	FHitResult& OutHit,
+	int32& OutObstacleIndex,
+	FVector& OutSurfaceVelocity) const
+{
+	if (Obstacles.Num() == 0 || DeltaTime <= KINDA_SMALL_NUMBER)
+	{
+		return false;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(FBallObstacleSet::Sweep);
+
+	const float EndTime = StartTime + DeltaTime;
+	const FBox SweepBounds = FBox(Start.ComponentMin(End), Start.ComponentMax(End));
+
+	float BestTime = 2.f;
+	int32 BestIndex = INDEX_NONE;
+	FVector BestObstacleStart = FVector::ZeroVector;
+	FVector BestObstacleVelocity = FVector::ZeroVector;
+
+	const int32 FirstWindow = GetWindowIndex(StartTime);
+	const int32 LastWindow = GetWindowIndex(EndTime);
+
+	// 시작 시점에 이미 겹쳐 있는 장애물이 있으면 가장 먼저 처리 (Hit.Time = 0)
+	{
+		const FTimeWindow& Window = Windows[FirstWindow];
+		int32 First, Last;
+		Window.GetCandidateRange(FBox(Start, Start), First, Last);
+		for (int32 i = First; i < Last; ++i)
+		{
+			if (!Window.Bounds[i].IsInside(Start))
+			{
+				continue;
+			}
+
+			const FBallKinematicObstacle& Obstacle = Obstacles[Window.Candidates[i]];
+			const FVector ObstacleStart = Obstacle.GetPositionAtTime(StartTime);
+			const FVector Offset = Obstacle.Axis * Obstacle.GetSegmentHalfLength();
+			const FVector Closest = FMath::ClosestPointOnSegment(Start, ObstacleStart - Offset, ObstacleStart + Offset);
+			if (FVector::DistSquared(Start, Closest) < FMath::Square(Obstacle.Radius + BallRadius))
+			{
+				BestTime = 0.f;
+				BestIndex = Window.Candidates[i];
+				BestObstacleStart = ObstacleStart;
+				BestObstacleVelocity = (Obstacle.GetPositionAtTime(EndTime) - ObstacleStart) / DeltaTime;
+				break;
+			}
+		}
+	}
+
+	// SubStep 이 윈도우 경계에 걸치면 양쪽 윈도우를 모두 검사 (같은 장애물 중복 검사는 허용)
+	for (int32 WindowIndex = FirstWindow; BestIndex == INDEX_NONE && WindowIndex <= LastWindow; ++WindowIndex)
+	{
+		const FTimeWindow& Window = Windows[WindowIndex];
+		int32 First, Last;
+		Window.GetCandidateRange(SweepBounds, First, Last);
+		for (int32 i = First; i < Last; ++i)
+		{
+			if (!Window.Bounds[i].Intersect(SweepBounds))
+			{
+				continue;
+			}
+
+			INC_DWORD_STAT(STAT_BallObstacleCandidates);
+
+			const int32 ObstacleIndex = Window.Candidates[i];
+			const FBallKinematicObstacle& Obstacle = Obstacles[ObstacleIndex];
+
+			// SubStep 구간 동안 장애물은 등속으로 근사, 장애물 기준 상대 이동으로 변환
+			const FVector ObstacleStart = Obstacle.GetPositionAtTime(StartTime);
+			const FVector ObstacleDelta = Obstacle.GetPositionAtTime(EndTime) - ObstacleStart;
+			const FVector Offset = Obstacle.Axis * Obstacle.GetSegmentHalfLength();
+			const FVector RelativeDelta = (End - Start) - ObstacleDelta;
+
+			const float HitTime = IntersectSegmentCapsule(Start, RelativeDelta, ObstacleStart - Offset, ObstacleStart + Offset, Obstacle.Radius + BallRadius);
+			if (HitTime >= 0.f && HitTime < BestTime)
+			{
+				BestTime = HitTime;
+				BestIndex = ObstacleIndex;
+				BestObstacleStart = ObstacleStart;
+				BestObstacleVelocity = ObstacleDelta / DeltaTime;
+			}
+		}
+	}
+
+	if (BestIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	// 접촉 시점의 공 중심과 장애물 축 선분 상의 최근접점으로 노멀 계산
+	const FBallKinematicObstacle& Obstacle = Obstacles[BestIndex];
+	const FVector Offset = Obstacle.Axis * Obstacle.GetSegmentHalfLength();
+	const FVector BallCenter = FMath::Lerp(Start, End, BestTime);
+	const FVector ObstacleCenter = BestObstacleStart + BestObstacleVelocity * (DeltaTime * BestTime);
+	const FVector Closest = FMath::ClosestPointOnSegment(BallCenter, ObstacleCenter - Offset, ObstacleCenter + Offset);
+	const FVector ToBall = BallCenter - Closest;
+	const float Distance = ToBall.Size();
+	const FVector Normal = Distance > KINDA_SMALL_NUMBER ? ToBall / Distance : -(End - Start).GetSafeNormal(SMALL_NUMBER, FVector::UpVector);
+
+	OutHit = FHitResult(Start, End);
+	OutHit.bBlockingHit = true;
+	OutHit.Time = BestTime;
+	OutHit.Distance = FVector::Dist(Start, BallCenter);
+	OutHit.Location = BallCenter;
+	OutHit.ImpactPoint = BallCenter - Normal * BallRadius;
+	OutHit.Normal = Normal;
+	OutHit.ImpactNormal = Normal;
+	OutHit.Item = BestIndex;
+	OutHit.bStartPenetrating = (BestTime <= 0.f) && Distance < Obstacle.Radius + BallRadius;
+	OutHit.PenetrationDepth = OutHit.bStartPenetrating ? (Obstacle.Radius + BallRadius - Distance) : 0.f;
+
+	OutObstacleIndex = BestIndex;
+	OutSurfaceVelocity = BestObstacleVelocity;
+	return true;
+}
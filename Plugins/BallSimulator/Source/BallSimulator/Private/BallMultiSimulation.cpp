@@ -0,0 +1,380 @@
+﻿// © 2025 UnrealStudy. All rights reserved.
+// Author: taru00@gmail.com | https://x.com/3devnote
+
+#include "BallMultiSimulation.h"
+#include "Async/ParallelFor.h"
+
+void FBallSpatialHash::Reset(float InCellSize, int32 NumBalls)
+{
+	CellSize = FMath::Max(InCellSize, KINDA_SMALL_NUMBER);
+	InvCellSize = 1.f / CellSize;
+
+	Cells.Reset();
+	BallCells.SetNumUninitialized(NumBalls);
+	Inserted.Init(false, NumBalls);
+}
+
+FIntVector FBallSpatialHash::GetCell(const FVector3f& Position) const
+{
+	return FIntVector(
+		FMath::FloorToInt(Position.X * InvCellSize),
+		FMath::FloorToInt(Position.Y * InvCellSize),
+		FMath::FloorToInt(Position.Z * InvCellSize));
+}
+
+void FBallSpatialHash::Update(int32 BallIndex, const FVector3f& Position)
+{
+	const FIntVector Cell = GetCell(Position);
+	if (Inserted[BallIndex])
+	{
+		if (BallCells[BallIndex] == Cell)
+		{
+			return;
+		}
+		Cells.FindChecked(BallCells[BallIndex]).RemoveSingleSwap(BallIndex, false);
+	}
+
+	Cells.FindOrAdd(Cell).Add(BallIndex);
+	BallCells[BallIndex] = Cell;
+	Inserted[BallIndex] = true;
+}
+
+void FBallSpatialHash::GatherPairs(TArray<TPair<int32, int32>>& OutPairs) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FBallSpatialHash::GatherPairs);
+
+	for (int32 A = 0; A < BallCells.Num(); ++A)
+	{
+		if (!Inserted[A])
+		{
+			continue;
+		}
+
+		const FIntVector& Cell = BallCells[A];
+		for (int32 Z = -1; Z <= 1; ++Z)
+		{
+			for (int32 Y = -1; Y <= 1; ++Y)
+			{
+				for (int32 X = -1; X <= 1; ++X)
+				{
+					const TArray<int32>* Neighbors = Cells.Find(Cell + FIntVector(X, Y, Z));
+					if (!Neighbors)
+					{
+						continue;
+					}
+
+					// 각 공은 한 셀에만 있으므로 A < B 조건만으로 중복 없음
+					for (const int32 B : *Neighbors)
+					{
+						if (A < B)
+						{
+							OutPairs.Emplace(A, B);
+						}
+					}
+				}
+			}
+		}
+	}
+}
+
+void FBallMultiSimulation::Initialize(const FBallSimContext& InContext, EBallSimFeature InFeatures, TArrayView<const FBallSimState> InStates, bool bInRecordSnapshots)
+{
+	Context = InContext;
+	Context.Snapshots = nullptr;
+	Context.Hits = nullptr;
+	Context.Bounces = nullptr;
+	Context.RotationKeys = nullptr;
+	Context.Checkpoints = nullptr;
+
+	// 이벤트와 정지 조건은 공 하나의 궤적 기준이므로 사용하지 않음
+	Context.Events = nullptr;
+	Context.EventQuery = nullptr;
+
+	// 공별 스텝을 병렬로 진행할 수 있으므로 공유 캐시와 통로 (진행 중 갱신됨) 는 사용하지 않음
+	Context.SurfaceCache = nullptr;
+	Context.Corridor = nullptr;
+
+	// 공끼리 부딪혀 다시 움직일 수 있으므로 강체 물리로 넘기는 정지 조건 없이 진행
+	Context.Constants.bStopOnRollingContact = false;
+	Context.Constants.MinSpeed = 0.f;
+	Context.Constants.MaxAllowedBounce = -1;
+
+	Features = InFeatures;
+	Kernel = &FBallSimKernel::Get(Features);
+
+	States = TArray<FBallSimState>(InStates.GetData(), InStates.Num());
+	StartPositions.SetNumUninitialized(States.Num());
+	HitCounts.Init(0, States.Num());
+	NumBallContacts = 0;
+
+	bRecordSnapshots = bInRecordSnapshots;
+	Snapshots.Reset();
+	if (bRecordSnapshots)
+	{
+		Snapshots.SetNum(States.Num());
+		RecordSnapshots();
+	}
+
+	// 셀 크기는 첫 UpdateBroadphase 에서 이동 거리에 맞게 결정
+	SpatialHash.Reset(0.f, States.Num());
+}
+
+void FBallMultiSimulation::Run(int32 LastStep)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FBallMultiSimulation::Run);
+
+	while (States.Num() > 0 && States[0].StepIndex < LastStep)
+	{
+		Step();
+	}
+
+	for (FBallSimState& State : States)
+	{
+		FBallSimKernel::FlushRotation(State);
+	}
+}
+
+void FBallMultiSimulation::Step()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FBallMultiSimulation::Step);
+
+	for (int32 i = 0; i < States.Num(); ++i)
+	{
+		StartPositions[i] = States[i].Position;
+	}
+
+	StepBalls();
+	UpdateBroadphase();
+	ResolveContacts();
+
+	if (bRecordSnapshots)
+	{
+		RecordSnapshots();
+	}
+}
+
+void FBallMultiSimulation::StepBalls()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FBallMultiSimulation::StepBalls);
+
+	// 각 공의 월드 충돌은 서로 독립적이고 Context 에 출력 버퍼가 없으므로 공별로 병렬 진행 가능
+	auto StepBall = [this](int32 Index)
+	{
+		HitCounts[Index] = Kernel->Step(Context, States[Index]);
+	};
+
+	if (States.Num() >= ParallelThreshold)
+	{
+		ParallelFor(States.Num(), StepBall);
+	}
+	else
+	{
+		for (int32 Index = 0; Index < States.Num(); ++Index)
+		{
+			StepBall(Index);
+		}
+	}
+}
+
+void FBallMultiSimulation::UpdateBroadphase()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FBallMultiSimulation::UpdateBroadphase);
+
+	// 스텝 안에서 접촉한 쌍은 스텝 끝에 최대 (지름 + 두 공의 이동 거리) 만큼 떨어져 있음
+	float MaxDisplacement = 0.f;
+	for (int32 i = 0; i < States.Num(); ++i)
+	{
+		MaxDisplacement = FMath::Max(MaxDisplacement, FVector3f::Dist(StartPositions[i], States[i].Position));
+	}
+
+	const float RequiredCellSize = 2.f * Context.Constants.Radius + 2.f * MaxDisplacement;
+	if (RequiredCellSize > SpatialHash.GetCellSize())
+	{
+		// 빠른 공이 생겼을 때만 여유를 두고 셀을 키워서 전체 재구성
+		SpatialHash.Reset(RequiredCellSize * 1.5f, States.Num());
+	}
+
+	for (int32 i = 0; i < States.Num(); ++i)
+	{
+		SpatialHash.Update(i, States[i].Position);
+	}
+
+	Pairs.Reset();
+	SpatialHash.GatherPairs(Pairs);
+	INC_DWORD_STAT_BY(STAT_BallPairCandidates, Pairs.Num());
+}
+
+float FBallMultiSimulation::GetFirstContactTime(const FVector3f& D0, const FVector3f& Delta, float ContactDistance)
+{
+	// |D0 + s * Delta| = ContactDistance 의 작은 근
+	const float c = (D0 | D0) - ContactDistance * ContactDistance;
+	if (c <= 0.f)
+	{
+		// 시작 시점에 이미 겹쳐 있음
+		return 0.f;
+	}
+
+	const float a = Delta | Delta;
+	const float b = D0 | Delta;
+	if (a <= KINDA_SMALL_NUMBER || b >= 0.f)
+	{
+		return -1.f;
+	}
+
+	const float h = b * b - a * c;
+	if (h < 0.f)
+	{
+		return -1.f;
+	}
+
+	const float s = (-b - FMath::Sqrt(h)) / a;
+	return s <= 1.f ? s : -1.f;
+}
+
+void FBallMultiSimulation::ResolveContacts()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FBallMultiSimulation::ResolveContacts);
+
+	const float ContactDistance = 2.f * Context.Constants.Radius;
+
+	Contacts.Reset();
+	for (const TPair<int32, int32>& Pair : Pairs)
+	{
+		const FVector3f D0 = StartPositions[Pair.Key] - StartPositions[Pair.Value];
+		const FVector3f D1 = States[Pair.Key].Position - States[Pair.Value].Position;
+		const float Time = GetFirstContactTime(D0, D1 - D0, ContactDistance);
+		if (Time >= 0.f)
+		{
+			Contacts.Add({ Pair.Key, Pair.Value, Time });
+		}
+	}
+
+	if (Contacts.Num() == 0)
+	{
+		return;
+	}
+
+	Contacts.Sort([](const FBallContact& L, const FBallContact& R) { return L.Time < R.Time; });
+
+	// 공이 겹치지 않는 연속된 접촉끼리 묶어서 응답을 한번에 계산
+	// 묶음 안의 접촉은 서로 독립이므로 시간 순으로 하나씩 처리한 결과와 같음
+	for (int32 GroupStart = 0; GroupStart < Contacts.Num();)
+	{
+		TArray<int32, TInlineAllocator<2 * FBallContactBatch::LaneWidth>> GroupBalls;
+		int32 GroupEnd = GroupStart;
+		while (GroupEnd < Contacts.Num() && GroupEnd - GroupStart < FBallContactBatch::LaneWidth
+			&& !GroupBalls.Contains(Contacts[GroupEnd].A) && !GroupBalls.Contains(Contacts[GroupEnd].B))
+		{
+			GroupBalls.Add(Contacts[GroupEnd].A);
+			GroupBalls.Add(Contacts[GroupEnd].B);
+			++GroupEnd;
+		}
+
+		ResolveContactGroup(GroupStart, GroupEnd);
+		GroupStart = GroupEnd;
+	}
+}
+
+void FBallMultiSimulation::ResolveContactGroup(int32 GroupStart, int32 GroupEnd)
+{
+	const float ContactDistance = 2.f * Context.Constants.Radius;
+
+	ContactBatch.Reset();
+	PendingContacts.Reset();
+
+	for (int32 Index = GroupStart; Index < GroupEnd; ++Index)
+	{
+		const FBallContact& Contact = Contacts[Index];
+		const FBallSimState& A = States[Contact.A];
+		const FBallSimState& B = States[Contact.B];
+
+		// 앞선 접촉으로 경로가 바뀌었을 수 있으므로 현재 경로로 다시 계산
+		const FVector3f D0 = StartPositions[Contact.A] - StartPositions[Contact.B];
+		const FVector3f D1 = A.Position - B.Position;
+		const float Time = GetFirstContactTime(D0, D1 - D0, ContactDistance);
+		if (Time < 0.f)
+		{
+			continue;
+		}
+
+		// 접촉 시점 위치에서 응답
+		FPendingContact& Pending = PendingContacts.AddDefaulted_GetRef();
+		Pending.A = Contact.A;
+		Pending.B = Contact.B;
+		Pending.Time = Time;
+		Pending.ContactA = FMath::Lerp(StartPositions[Contact.A], A.Position, Time);
+		Pending.ContactB = FMath::Lerp(StartPositions[Contact.B], B.Position, Time);
+		Pending.Normal = (Pending.ContactA - Pending.ContactB).GetSafeNormal(UE_SMALL_NUMBER, FVector3f::UpVector);
+		ContactBatch.Add(FBallSimKernel::MakeBallContactInput(Context.Constants, Features, A, B, Pending.Normal));
+	}
+
+	ContactBatch.Resolve();
+
+	for (int32 Index = 0; Index < PendingContacts.Num(); ++Index)
+	{
+		const FPendingContact& Pending = PendingContacts[Index];
+		FBallSimState& A = States[Pending.A];
+		FBallSimState& B = States[Pending.B];
+
+		if (FBallSimKernel::ApplyBallContact(Context.Constants, A, B, Pending.Normal, ContactBatch.GetResult(Index)) > 0.f)
+		{
+			++HitCounts[Pending.A];
+			++HitCounts[Pending.B];
+			++NumBallContacts;
+			INC_DWORD_STAT(STAT_BallPairContacts);
+
+			// 남은 시간은 접촉 위치에서 커널 SubStep 으로 다시 진행 (튕겨 나간 공도 벽, 바닥과 충돌)
+			SweepRemainder(Pending.A, Pending.ContactA, Pending.Time);
+			SweepRemainder(Pending.B, Pending.ContactB, Pending.Time);
+		}
+
+		// 겹친 채로 시작했거나 멀어지는 속도가 부족하면 침투 깊이의 절반씩 밀어냄
+		const FVector3f Separation = A.Position - B.Position;
+		const float Distance = Separation.Size();
+		if (Distance < ContactDistance)
+		{
+			const FVector3f PushDirection = Distance > UE_SMALL_NUMBER ? Separation / Distance : Pending.Normal;
+			const FVector3f PushBack = PushDirection * (0.5f * (ContactDistance - Distance) + KINDA_SMALL_NUMBER);
+			A.Position += PushBack;
+			B.Position -= PushBack;
+		}
+	}
+}
+
+void FBallMultiSimulation::SweepRemainder(int32 BallIndex, const FVector3f& ContactPosition, float ContactTime)
+{
+	const float StepInterval = Context.Constants.StepInterval;
+	const float RemainingTime = (1.f - ContactTime) * StepInterval;
+	FBallSimState& State = States[BallIndex];
+
+	// 스텝 끝 속도에는 남은 시간의 중력이 이미 들어 있으므로 빼고 SubStep 에서 다시 적용
+	State.Position = ContactPosition;
+	State.LinearVelocity -= Context.Constants.Gravity * RemainingTime;
+	State.Time = (State.StepIndex - 1 + ContactTime) * StepInterval;
+	HitCounts[BallIndex] += Kernel->HandleCollision(Context, State, RemainingTime, 1);
+
+	// 이후 접촉 계산용 경로는 접촉 시점에 ContactPosition 을 지나 새 위치에서 끝나는 직선
+	const float RemainingRatio = 1.f - ContactTime;
+	StartPositions[BallIndex] = RemainingRatio > KINDA_SMALL_NUMBER
+		? ContactPosition + (ContactPosition - State.Position) * (ContactTime / RemainingRatio)
+		: ContactPosition;
+}
+
+void FBallMultiSimulation::RecordSnapshots()
+{
+	const float StepInterval = Context.Constants.StepInterval;
+	for (int32 i = 0; i < States.Num(); ++i)
+	{
+		const FBallSimState& State = States[i];
+
+		FBallSimSnapshot& Snapshot = Snapshots[i].AddDefaulted_GetRef();
+		Snapshot.Time = State.StepIndex * StepInterval;
+		Snapshot.Position = State.Position;
+		Snapshot.Direction = State.LinearVelocity.GetSafeNormal();
+		Snapshot.Speed = State.LinearVelocity.Size();
+		Snapshot.SpinAxis = State.AngularVelocity.GetSafeNormal();
+		Snapshot.SpinSpeed = State.AngularVelocity.Size();
+		Snapshot.hitCount = HitCounts[i];
+		Snapshot.BounceIndex = State.LastBounceIndex;
+	}
+}
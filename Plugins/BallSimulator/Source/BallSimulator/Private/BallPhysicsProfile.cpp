@@ -0,0 +1,174 @@
+﻿// © 2025 UnrealStudy. All rights reserved.
+// Author: taru00@gmail.com | https://x.com/3devnote
+
+#include "BallPhysicsProfile.h"
+
+EBallSimFeature UBallPhysicsProfile::GetFeatures() const
+{
+	EBallSimFeature Features = EBallSimFeature::None;
+	if (bEnableMagnus)			Features |= EBallSimFeature::Magnus;
+	if (bEnableDamping)			Features |= EBallSimFeature::Damping;
+	if (bUsePhysicalMaterial)	Features |= EBallSimFeature::PhysMaterial;
+	if (bClampImpulse)			Features |= EBallSimFeature::ImpulseClamp;
+	if (bCollideWithObstacles)	Features |= EBallSimFeature::Obstacles;
+	if (bUseAerodynamicTables && AeroTable.IsValid())	Features |= EBallSimFeature::Aerodynamics;
+	return Features;
+}
+
+FBallSimConstants UBallPhysicsProfile::MakeConstants(float StepInterval, float InMass, float InRadius) const
+{
+	FBallSimConstants Constants;
+	Constants.Gravity = FVector3f(GravityVector);
+	Constants.StepInterval = StepInterval;
+	Constants.LinearDamping = LinearDamping;
+	Constants.AngularDamping = AngularDamping;
+	Constants.MinSpinForMagnus = MinSpinForMagnus;
+	Constants.SpinMagnusFactor = SpinMagnusFactor;
+	Constants.BouncedSpinMultiplier = BouncedSpinMultiplier;
+	Constants.SpinToRotateMultiply = SpinToRotateMultiply;
+	Constants.DefaultRestitution = DefaultRestitution;
+	Constants.DefaultFriction = DefaultFriction;
+	Constants.MaxAllowedImpulse = MaxAllowedImpulse;
+	Constants.BounceThreshold = BounceThreshold;
+	Constants.ContactSkin = ContactSkin;
+	Constants.ContactSolverIterations = ContactSolverIterations;
+	Constants.SurfaceTable = SurfaceTable;
+	Constants.SetMassProperties(InMass > 0.f ? InMass : Mass, InRadius > 0.f ? InRadius : Radius, InertiaTensorScale);
+	Constants.UpdateStepScales();
+
+	if (AeroTable.IsValid())
+	{
+		// Re = v·D/ν (SI), 시뮬레이션 단위는 cm
+		const float BallMass = InMass > 0.f ? InMass : Mass;
+		Constants.AeroTable = AeroTable;
+		Constants.ReynoldsPerSpeed = 2.f * Constants.Radius * 1.e-4f / FMath::Max(KinematicViscosity, UE_SMALL_NUMBER);
+		Constants.AeroForceScale = 0.5f * AirDensity * 1.e-6f * PI * Constants.Radius * Constants.Radius / FMath::Max(BallMass, UE_KINDA_SMALL_NUMBER);
+	}
+	return Constants;
+}
+
+void UBallPhysicsProfile::PostLoad()
+{
+	Super::PostLoad();
+
+	BakeAeroTable();
+	BakeSurfaceTable();
+}
+
+#if WITH_EDITOR
+void UBallPhysicsProfile::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	BakeAeroTable();
+	BakeSurfaceTable();
+}
+#endif
+
+void UBallPhysicsProfile::BakeAeroTable()
+{
+	AeroTable.Reset();
+	if (AeroCurves.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<const FBallAeroCurve*> Rows;
+	for (const FBallAeroCurve& Curve : AeroCurves)
+	{
+		Rows.Add(&Curve);
+	}
+	Rows.Sort([](const FBallAeroCurve& A, const FBallAeroCurve& B) { return A.SpinRatio < B.SpinRatio; });
+
+	// 레이놀즈 수 범위는 모든 커브 키 범위의 합집합, 범위 밖은 끝 값 유지
+	float ReynoldsMin = TNumericLimits<float>::Max();
+	float ReynoldsMax = TNumericLimits<float>::Lowest();
+	for (const FBallAeroCurve* Row : Rows)
+	{
+		for (const FRuntimeFloatCurve* Curve : { &Row->DragCoefficient, &Row->LiftCoefficient })
+		{
+			if (const FRichCurve* RichCurve = Curve->GetRichCurveConst())
+			{
+				if (RichCurve->GetNumKeys() > 0)
+				{
+					float TimeMin, TimeMax;
+					RichCurve->GetTimeRange(TimeMin, TimeMax);
+					ReynoldsMin = FMath::Min(ReynoldsMin, TimeMin);
+					ReynoldsMax = FMath::Max(ReynoldsMax, TimeMax);
+				}
+			}
+		}
+	}
+	if (ReynoldsMin > ReynoldsMax)
+	{
+		return;
+	}
+
+	TSharedRef<FBallAeroTable, ESPMode::ThreadSafe> Table = MakeShared<FBallAeroTable, ESPMode::ThreadSafe>();
+	Table->NumReynolds = FMath::Clamp(AeroReynoldsSamples, 2, 1024);
+	Table->NumSpinRatios = FMath::Clamp(AeroSpinRatioSamples, 2, 256);
+	Table->Drag.SetNumUninitialized(Table->NumReynolds * Table->NumSpinRatios);
+	Table->Lift.SetNumUninitialized(Table->NumReynolds * Table->NumSpinRatios);
+
+	const float ReynoldsStep = FMath::Max(ReynoldsMax - ReynoldsMin, 1.f) / (Table->NumReynolds - 1);
+	const float SpinRatioStep = FMath::Max(Rows.Last()->SpinRatio, UE_KINDA_SMALL_NUMBER) / (Table->NumSpinRatios - 1);
+	Table->ReynoldsMin = ReynoldsMin;
+	Table->InvReynoldsStep = 1.f / ReynoldsStep;
+	Table->InvSpinRatioStep = 1.f / SpinRatioStep;
+
+	for (int32 SpinIndex = 0; SpinIndex < Table->NumSpinRatios; ++SpinIndex)
+	{
+		// 스핀비를 감싸는 두 행 사이 보간
+		const float SpinRatio = SpinIndex * SpinRatioStep;
+		int32 Upper = 0;
+		while (Upper < Rows.Num() - 1 && Rows[Upper]->SpinRatio < SpinRatio)
+		{
+			++Upper;
+		}
+		const int32 Lower = FMath::Max(Upper - 1, 0);
+		const float RowSpan = Rows[Upper]->SpinRatio - Rows[Lower]->SpinRatio;
+		const float Alpha = RowSpan > UE_KINDA_SMALL_NUMBER ? FMath::Clamp((SpinRatio - Rows[Lower]->SpinRatio) / RowSpan, 0.f, 1.f) : 0.f;
+
+		for (int32 ReynoldsIndex = 0; ReynoldsIndex < Table->NumReynolds; ++ReynoldsIndex)
+		{
+			const float Reynolds = ReynoldsMin + ReynoldsIndex * ReynoldsStep;
+			const int32 Index = SpinIndex * Table->NumReynolds + ReynoldsIndex;
+			Table->Drag[Index] = FMath::Lerp(Rows[Lower]->DragCoefficient.GetRichCurveConst()->Eval(Reynolds), Rows[Upper]->DragCoefficient.GetRichCurveConst()->Eval(Reynolds), Alpha);
+			Table->Lift[Index] = FMath::Lerp(Rows[Lower]->LiftCoefficient.GetRichCurveConst()->Eval(Reynolds), Rows[Upper]->LiftCoefficient.GetRichCurveConst()->Eval(Reynolds), Alpha);
+		}
+	}
+
+	AeroTable = Table;
+}
+
+void UBallPhysicsProfile::BakeSurfaceTable()
+{
+	SurfaceTable.Reset();
+	if (SurfaceResponses.Num() == 0)
+	{
+		return;
+	}
+
+	// 지정하지 않은 종류는 물리 재질 값 사용, 재질이 없으면 Default 값
+	TSharedRef<FBallSurfaceTable, ESPMode::ThreadSafe> Table = MakeShared<FBallSurfaceTable, ESPMode::ThreadSafe>();
+	for (FBallSurfaceResponse& Response : Table->Responses)
+	{
+		Response.Restitution = DefaultRestitution;
+		Response.Friction = DefaultFriction;
+		Response.BounceSpinMultiplier = BouncedSpinMultiplier;
+	}
+
+	// 같은 종류가 여러 번 있으면 마지막 항목 사용
+	for (const FBallSurfaceTuning& Tuning : SurfaceResponses)
+	{
+		FBallSurfaceResponse& Response = Table->Responses[Tuning.SurfaceType.GetValue()];
+		Response.Restitution = Tuning.Restitution;
+		Response.Friction = Tuning.Friction;
+		Response.SpinFriction = FMath::Clamp(Tuning.SpinFriction, 0.f, 1.f);
+		Response.RollingResistance = FMath::Max(Tuning.RollingResistance, 0.f);
+		Response.BounceSpinMultiplier = Tuning.BounceSpinMultiplier;
+		Response.bUseMaterial = false;
+	}
+
+	SurfaceTable = Table;
+}
@@ -0,0 +1,171 @@
+﻿// © 2025 UnrealStudy. All rights reserved.
+// Author: taru00@gmail.com | https://x.com/3devnote
+
+#include "BallPlaybackLOD.h"
+#include "BallSimulatorActor.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+
+static TAutoConsoleVariable<int32> CVarBallPlaybackLODEnable(
+	TEXT("BallSim.PlaybackLOD.Enable"),
+	1,
+	TEXT("0 : 모든 재생 공을 Near 로 갱신"));
+
+static TAutoConsoleVariable<float> CVarBallPlaybackNearScreenSize(
+	TEXT("BallSim.PlaybackLOD.NearScreenSize"),
+	0.01f,
+	TEXT("공 지름이 화면 폭에서 차지하는 비율이 이 값 이상이면 Near"));
+
+static TAutoConsoleVariable<int32> CVarBallPlaybackFarUpdateInterval(
+	TEXT("BallSim.PlaybackLOD.FarUpdateInterval"),
+	3,
+	TEXT("Far 공의 위치 갱신 간격 (프레임)"));
+
+static TAutoConsoleVariable<int32> CVarBallPlaybackHiddenUpdateInterval(
+	TEXT("BallSim.PlaybackLOD.HiddenUpdateInterval"),
+	10,
+	TEXT("화면 밖 공의 위치 갱신 간격 (프레임)"));
+
+static TAutoConsoleVariable<int32> CVarBallPlaybackDecimationStep(
+	TEXT("BallSim.PlaybackLOD.DecimationStep"),
+	4,
+	TEXT("Far / Hidden 재생용 감소 궤적 스텝 간격 (충돌 스텝은 항상 유지)"));
+
+int32 UBallPlaybackLODSubsystem::GetDecimationStep()
+{
+	return FMath::Max(CVarBallPlaybackDecimationStep.GetValueOnGameThread(), 1);
+}
+
+TStatId UBallPlaybackLODSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UBallPlaybackLODSubsystem, STATGROUP_Tickables);
+}
+
+void UBallPlaybackLODSubsystem::Register(ABallSimulatorActor* Actor)
+{
+	if (Actor)
+	{
+		PlayingActors.AddUnique(Actor);
+	}
+}
+
+void UBallPlaybackLODSubsystem::Unregister(ABallSimulatorActor* Actor)
+{
+	PlayingActors.RemoveSingleSwap(Actor);
+}
+
+void UBallPlaybackLODSubsystem::GatherViews(TArray<FPlaybackView, TInlineAllocator<4>>& OutViews) const
+{
+	for (FConstPlayerControllerIterator It = GetWorld()->GetPlayerControllerIterator(); It; ++It)
+	{
+		const APlayerController* PlayerController = It->Get();
+		if (!PlayerController || !PlayerController->IsLocalController() || !PlayerController->PlayerCameraManager)
+		{
+			continue;
+		}
+
+		const APlayerCameraManager* CameraManager = PlayerController->PlayerCameraManager;
+		FPlaybackView& View = OutViews.AddDefaulted_GetRef();
+		View.Location = CameraManager->GetCameraLocation();
+		View.Forward = CameraManager->GetCameraRotation().Vector();
+		View.TanHalfFOV = FMath::Tan(FMath::DegreesToRadians(FMath::Clamp(CameraManager->GetFOVAngle(), 1.f, 170.f) * 0.5f));
+	}
+}
+
+EBallPlaybackLOD UBallPlaybackLODSubsystem::ComputeLOD(const FVector& Location, float Radius, TArrayView<const FPlaybackView> Views, float NearScreenSize)
+{
+	bool bVisible = false;
+	for (const FPlaybackView& View : Views)
+	{
+		const FVector ToBall = Location - View.Location;
+		const float Depth = ToBall | View.Forward;
+		if (Depth < -Radius)
+		{
+			continue;
+		}
+
+		// 화면 비율을 모르므로 수평 FOV 를 대각선 정도로 넓힌 원뿔로 보수적으로 판정
+		const float Lateral = FMath::Sqrt(FMath::Max(ToBall.SizeSquared() - Depth * Depth, 0.f));
+		if (Lateral - Radius > FMath::Max(Depth, 0.f) * View.TanHalfFOV * 1.2f)
+		{
+			continue;
+		}
+		bVisible = true;
+
+		// 공 지름 / 화면 폭 (투영 거리 기준)
+		const float ScreenSize = Radius / (FMath::Max(Depth, 1.f) * View.TanHalfFOV);
+		if (ScreenSize >= NearScreenSize)
+		{
+			return EBallPlaybackLOD::Near;
+		}
+	}
+
+	return bVisible ? EBallPlaybackLOD::Far : EBallPlaybackLOD::Hidden;
+}
+
+void UBallPlaybackLODSubsystem::Tick(float DeltaTime)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UBallPlaybackLODSubsystem::Tick);
+
+	++FrameCounter;
+	NumAtLOD[0] = NumAtLOD[1] = NumAtLOD[2] = 0;
+
+	const float NearScreenSize = CVarBallPlaybackNearScreenSize.GetValueOnGameThread();
+	const int32 FarInterval = FMath::Max(CVarBallPlaybackFarUpdateInterval.GetValueOnGameThread(), 1);
+	const int32 HiddenInterval = FMath::Max(CVarBallPlaybackHiddenUpdateInterval.GetValueOnGameThread(), 1);
+
+	SET_FLOAT_STAT(STAT_BallPlaybackNearScreenSize, NearScreenSize);
+	SET_DWORD_STAT(STAT_BallPlaybackFarUpdateInterval, FarInterval);
+	SET_DWORD_STAT(STAT_BallPlaybackHiddenUpdateInterval, HiddenInterval);
+
+	if (PlayingActors.Num() == 0)
+	{
+		return;
+	}
+
+	// 뷰가 없으면 (에디터 미리보기 등) 모두 Near
+	TArray<FPlaybackView, TInlineAllocator<4>> Views;
+	if (CVarBallPlaybackLODEnable.GetValueOnGameThread() != 0)
+	{
+		GatherViews(Views);
+	}
+
+	TickActors = PlayingActors;
+	BatchedUpdates.Reset();
+
+	for (int32 Index = 0; Index < TickActors.Num(); ++Index)
+	{
+		ABallSimulatorActor* Actor = TickActors[Index];
+		if (!IsValid(Actor))
+		{
+			PlayingActors.RemoveSingleSwap(Actor);
+			continue;
+		}
+
+		const EBallPlaybackLOD LOD = Views.Num() > 0
+			? ComputeLOD(Actor->GetBallLocation(), Actor->GetBallRadius(), Views, NearScreenSize)
+			: EBallPlaybackLOD::Near;
+		Actor->SetPlaybackLOD(LOD);
+		++NumAtLOD[(int32)LOD];
+
+		// 갱신 프레임을 공마다 어긋나게 해서 프레임당 비용을 고르게 분산
+		const int32 Interval = LOD == EBallPlaybackLOD::Far ? FarInterval : HiddenInterval;
+		if (LOD != EBallPlaybackLOD::Near && (FrameCounter + Index) % Interval == 0)
+		{
+			BatchedUpdates.Add(Actor);
+		}
+	}
+
+	// Far / Hidden 공은 한 번에 위치만 갱신 (오버랩 갱신 없음, 렌더 트랜스폼은 프레임 끝에 모아서 전송)
+	for (ABallSimulatorActor* Actor : BatchedUpdates)
+	{
+		Actor->UpdatePlayback(false);
+	}
+
+	SET_DWORD_STAT(STAT_BallPlaybackNear, NumAtLOD[(int32)EBallPlaybackLOD::Near]);
+	SET_DWORD_STAT(STAT_BallPlaybackFar, NumAtLOD[(int32)EBallPlaybackLOD::Far]);
+	SET_DWORD_STAT(STAT_BallPlaybackHidden, NumAtLOD[(int32)EBallPlaybackLOD::Hidden]);
+	SET_DWORD_STAT(STAT_BallPlaybackBatchedUpdates, BatchedUpdates.Num());
+}
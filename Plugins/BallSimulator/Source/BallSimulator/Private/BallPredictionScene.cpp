@@ -0,0 +1,390 @@
+﻿// © 2025 UnrealStudy. All rights reserved.
+// Author: taru00@gmail.com | https://x.com/3devnote
+
+#include "BallPredictionScene.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "Async/Async.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "Components/StaticMeshComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/SphereComponent.h"
+#include "Components/BoxComponent.h"
+#include "Components/CapsuleComponent.h"
+#include "Materials/MaterialInterface.h"
+#include "Physics/Experimental/PhysScene_Chaos.h"
+#include "PhysicsEngine/PhysicsSettings.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogBallPredictionScene, Log, All);
+DEFINE_LOG_CATEGORY(LogBallPredictionScene);
+
+FBallPredictionSceneWorker::FBallPredictionSceneWorker(UWorld* InWorld)
+	: World(InWorld)
+	, bStopRequested(false)
+	, NumPendingTasks(0)
+{
+}
+
+FBallPredictionSceneWorker::~FBallPredictionSceneWorker()
+{
+	Shutdown();
+}
+
+bool FBallPredictionSceneWorker::Start()
+{
+	bStopRequested = false;
+	WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	Thread = FRunnableThread::Create(this, TEXT("BallPredictionScene"), 0, TPri_BelowNormal);
+	return Thread != nullptr;
+}
+
+void FBallPredictionSceneWorker::Shutdown()
+{
+	if (!Thread)
+	{
+		return;
+	}
+
+	Stop();
+	Thread->WaitForCompletion();
+	delete Thread;
+	Thread = nullptr;
+
+	FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	WakeEvent = nullptr;
+
+	// 종료 후 남은 작업은 실행하지 않고 버림 (완료 콜백도 호출되지 않음)
+	Tasks.Empty();
+	NumPendingTasks = 0;
+}
+
+void FBallPredictionSceneWorker::Enqueue(TUniqueFunction<void(UWorld*)> Work, TUniqueFunction<void()> OnComplete)
+{
+	if (!Thread)
+	{
+		return;
+	}
+
+	INC_DWORD_STAT(STAT_BallPredictionSceneTasks);
+	++NumPendingTasks;
+	Tasks.Enqueue(FTask{ MoveTemp(Work), MoveTemp(OnComplete) });
+	WakeEvent->Trigger();
+}
+
+void FBallPredictionSceneWorker::Flush()
+{
+	if (!Thread)
+	{
+		return;
+	}
+
+	FEvent* DoneEvent = FPlatformProcess::GetSynchEventFromPool(true);
+	Enqueue([DoneEvent](UWorld*) { DoneEvent->Trigger(); }, nullptr);
+	DoneEvent->Wait();
+	FPlatformProcess::ReturnSynchEventToPool(DoneEvent);
+}
+
+uint32 FBallPredictionSceneWorker::Run()
+{
+	while (!bStopRequested)
+	{
+		WakeEvent->Wait(100);
+		ProcessTasks();
+	}
+	return 0;
+}
+
+void FBallPredictionSceneWorker::Stop()
+{
+	bStopRequested = true;
+	if (WakeEvent)
+	{
+		WakeEvent->Trigger();
+	}
+}
+
+void FBallPredictionSceneWorker::ProcessTasks()
+{
+	FTask Task;
+	while (!bStopRequested && Tasks.Dequeue(Task))
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FBallPredictionSceneWorker::ProcessTask);
+
+		DEC_DWORD_STAT(STAT_BallPredictionSceneTasks);
+		if (Task.Work)
+		{
+			Task.Work(World);
+		}
+		--NumPendingTasks;
+
+		if (Task.OnComplete)
+		{
+			AsyncTask(ENamedThreads::GameThread, MoveTemp(Task.OnComplete));
+		}
+	}
+}
+
+void UBallPredictionScene::StepScene(UWorld* InWorld, float DeltaTime)
+{
+	check(IsInGameThread());
+
+	FPhysScene* Scene = InWorld ? InWorld->GetPhysicsScene() : nullptr;
+	if (!Scene)
+	{
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(UBallPredictionScene::StepScene);
+
+	// 예측 씬에는 정적 충돌체만 있으므로 스텝은 추가/이동된 바디를 Scene Query 구조에 반영하는 용도
+	const FVector Gravity(0.f, 0.f, UPhysicsSettings::Get()->DefaultGravityZ);
+	const float StepTime = FMath::Max(DeltaTime, UE_KINDA_SMALL_NUMBER);
+	Scene->SetUpForFrame(&Gravity, StepTime, 0.f, StepTime, StepTime, 1, false);
+	Scene->StartFrame();
+	Scene->WaitPhysScenes();
+	Scene->EndFrame();
+}
+
+bool UBallPredictionScene::ShouldCreateSubsystem(UObject* Outer) const
+{
+	if (!Super::ShouldCreateSubsystem(Outer))
+	{
+		return false;
+	}
+
+	// 게임/PIE 월드에만 생성 (예측 월드 자신은 Inactive 이므로 제외됨)
+	const UWorld* World = Cast<UWorld>(Outer);
+	return World && World->IsGameWorld();
+}
+
+void UBallPredictionScene::OnWorldBeginPlay(UWorld& InWorld)
+{
+	Super::OnWorldBeginPlay(InWorld);
+
+	CreatePredictionWorld();
+	if (!PredictionWorld)
+	{
+		return;
+	}
+
+	// 복사한 충돌체가 Sweep 에 잡히도록 워커 시작 전에 게임 스레드에서 스텝
+	CopyStaticCollision(&InWorld);
+	StepScene(PredictionWorld, 0.f);
+
+	Worker = MakeUnique<FBallPredictionSceneWorker>(PredictionWorld);
+	if (!Worker->Start())
+	{
+		UE_LOG(LogBallPredictionScene, Warning, TEXT("Failed to start prediction scene worker"));
+		Worker.Reset();
+	}
+}
+
+void UBallPredictionScene::Deinitialize()
+{
+	if (Worker)
+	{
+		Worker->Shutdown();
+		Worker.Reset();
+	}
+
+	DestroyPredictionWorld();
+	Super::Deinitialize();
+}
+
+void UBallPredictionScene::RefreshStaticCollision()
+{
+	UWorld* SourceWorld = GetWorld();
+	if (!IsRunning() || !SourceWorld)
+	{
+		return;
+	}
+
+	// 워커가 예측 월드를 사용 중이지 않을 때만 충돌체 교체
+	Worker->Flush();
+
+	if (CollisionHolder)
+	{
+		PredictionWorld->DestroyActor(CollisionHolder);
+		CollisionHolder = nullptr;
+	}
+
+	CopyStaticCollision(SourceWorld);
+	StepScene(PredictionWorld, 0.f);
+}
+
+void UBallPredictionScene::RequestStep(float DeltaTime)
+{
+	if (!IsRunning() || !Worker->IsIdle())
+	{
+		return;
+	}
+
+	StepScene(PredictionWorld, DeltaTime);
+}
+
+void UBallPredictionScene::EnqueueTask(TUniqueFunction<void(UWorld*)> Task, TUniqueFunction<void()> OnComplete)
+{
+	if (!IsRunning())
+	{
+		return;
+	}
+
+	Worker->Enqueue(MoveTemp(Task), MoveTemp(OnComplete));
+}
+
+void UBallPredictionScene::Flush()
+{
+	if (IsRunning())
+	{
+		Worker->Flush();
+	}
+}
+
+void UBallPredictionScene::CreatePredictionWorld()
+{
+	// 렌더링, 오디오, 내비게이션 없이 Scene Query 용 물리 씬만 가지는 월드
+	UWorld::InitializationValues IVS;
+	IVS.InitializeScenes(false)
+		.AllowAudioPlayback(false)
+		.RequiresHitProxies(false)
+		.CreatePhysicsScene(true)
+		.CreateNavigation(false)
+		.CreateAISystem(false)
+		.ShouldSimulatePhysics(false)
+		.EnableTraceCollision(true)
+		.SetTransactional(false)
+		.CreateFXSystem(false);
+
+	const FName WorldName = MakeUniqueObjectName(this, UWorld::StaticClass(), TEXT("BallPredictionWorld"));
+	PredictionWorld = UWorld::CreateWorld(EWorldType::Inactive, false, WorldName, nullptr, false, ERHIFeatureLevel::Num, &IVS);
+	if (!PredictionWorld)
+	{
+		UE_LOG(LogBallPredictionScene, Warning, TEXT("Failed to create prediction world"));
+	}
+}
+
+void UBallPredictionScene::DestroyPredictionWorld()
+{
+	CollisionHolder = nullptr;
+	NumCopiedComponents = 0;
+	NumSkippedComponents = 0;
+
+	if (PredictionWorld)
+	{
+		PredictionWorld->DestroyWorld(false);
+		PredictionWorld = nullptr;
+	}
+}
+
+bool UBallPredictionScene::ShouldCopyComponent(const UPrimitiveComponent* Component)
+{
+	// 시뮬레이터 Sweep 은 ECC_WorldStatic 채널을 사용하므로 이 채널을 Block 하는 정적 충돌체만 복사
+	return Component
+		&& Component->IsRegistered()
+		&& Component->Mobility == EComponentMobility::Static
+		&& Component->IsQueryCollisionEnabled()
+		&& Component->GetCollisionResponseToChannel(ECC_WorldStatic) == ECR_Block;
+}
+
+void UBallPredictionScene::CopyStaticCollision(UWorld* SourceWorld)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UBallPredictionScene::CopyStaticCollision);
+
+	NumCopiedComponents = 0;
+	NumSkippedComponents = 0;
+	CollisionHolder = PredictionWorld->SpawnActor<AActor>();
+	if (!CollisionHolder)
+	{
+		return;
+	}
+
+	TInlineComponentArray<UPrimitiveComponent*> Components;
+	for (TActorIterator<AActor> It(SourceWorld); It; ++It)
+	{
+		It->GetComponents(Components);
+		for (UPrimitiveComponent* Source : Components)
+		{
+			if (!ShouldCopyComponent(Source))
+			{
+				continue;
+			}
+
+			// 충돌 형상만 새로 만들어서 복사 (원본 컴포넌트는 게임 월드 소유이므로 참조하지 않음)
+			UPrimitiveComponent* Clone = nullptr;
+			if (const UInstancedStaticMeshComponent* InstancedSource = Cast<UInstancedStaticMeshComponent>(Source))
+			{
+				UInstancedStaticMeshComponent* InstancedClone = NewObject<UInstancedStaticMeshComponent>(CollisionHolder);
+				InstancedClone->SetStaticMesh(InstancedSource->GetStaticMesh());
+				for (int32 InstanceIndex = 0; InstanceIndex < InstancedSource->GetInstanceCount(); ++InstanceIndex)
+				{
+					FTransform InstanceTransform;
+					InstancedSource->GetInstanceTransform(InstanceIndex, InstanceTransform, false);
+					InstancedClone->AddInstance(InstanceTransform);
+				}
+				CopyMaterials(InstancedSource, InstancedClone);
+				Clone = InstancedClone;
+			}
+			else if (const UStaticMeshComponent* MeshSource = Cast<UStaticMeshComponent>(Source))
+			{
+				UStaticMeshComponent* MeshClone = NewObject<UStaticMeshComponent>(CollisionHolder);
+				MeshClone->SetStaticMesh(MeshSource->GetStaticMesh());
+				CopyMaterials(MeshSource, MeshClone);
+				Clone = MeshClone;
+			}
+			else if (const USphereComponent* SphereSource = Cast<USphereComponent>(Source))
+			{
+				USphereComponent* SphereClone = NewObject<USphereComponent>(CollisionHolder);
+				SphereClone->InitSphereRadius(SphereSource->GetUnscaledSphereRadius());
+				Clone = SphereClone;
+			}
+			else if (const UBoxComponent* BoxSource = Cast<UBoxComponent>(Source))
+			{
+				UBoxComponent* BoxClone = NewObject<UBoxComponent>(CollisionHolder);
+				BoxClone->InitBoxExtent(BoxSource->GetUnscaledBoxExtent());
+				Clone = BoxClone;
+			}
+			else if (const UCapsuleComponent* CapsuleSource = Cast<UCapsuleComponent>(Source))
+			{
+				UCapsuleComponent* CapsuleClone = NewObject<UCapsuleComponent>(CollisionHolder);
+				CapsuleClone->InitCapsuleSize(CapsuleSource->GetUnscaledCapsuleRadius(), CapsuleSource->GetUnscaledCapsuleHalfHeight());
+				Clone = CapsuleClone;
+			}
+			else
+			{
+				// BSP, 브러시, 랜드스케이프 등 형상을 복사할 수 없는 충돌체, 하나라도 있으면 IsReady 가 false (게임 월드 Sweep 사용)
+				UE_LOG(LogBallPredictionScene, Warning, TEXT("Skipped static collision : %s (%s)"), *Source->GetPathName(), *Source->GetClass()->GetName());
+				++NumSkippedComponents;
+				continue;
+			}
+
+			Clone->SetMobility(EComponentMobility::Static);
+			Clone->SetWorldTransform(Source->GetComponentTransform());
+			Clone->BodyInstance.CopyBodyInstancePropertiesFrom(&Source->BodyInstance);
+			Clone->RegisterComponentWithWorld(PredictionWorld);
+			CollisionHolder->AddInstanceComponent(Clone);
+			++NumCopiedComponents;
+		}
+	}
+
+	if (NumSkippedComponents > 0)
+	{
+		UE_LOG(LogBallPredictionScene, Warning, TEXT("Prediction scene copied %d static collision components, %d could not be copied. Simulators fall back to the game world."), NumCopiedComponents, NumSkippedComponents);
+	}
+	else
+	{
+		UE_LOG(LogBallPredictionScene, Log, TEXT("Prediction scene copied %d static collision components"), NumCopiedComponents);
+	}
+}
+
+void UBallPredictionScene::CopyMaterials(const UMeshComponent* Source, UMeshComponent* Clone)
+{
+	// 오버라이드 머티리얼의 물리 머티리얼이 Sweep 결과의 표면 종류를 결정하므로 그대로 복사
+	for (int32 MaterialIndex = 0; MaterialIndex < Source->GetNumOverrideMaterials(); ++MaterialIndex)
+	{
+		if (UMaterialInterface* Material = Source->OverrideMaterials[MaterialIndex])
+		{
+			Clone->SetMaterial(MaterialIndex, Material);
+		}
+	}
+}
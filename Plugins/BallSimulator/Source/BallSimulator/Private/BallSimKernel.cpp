@@ -0,0 +1,1079 @@
+﻿// © 2025 UnrealStudy. All rights reserved.
+// Author: taru00@gmail.com | https://x.com/3devnote
+
+#include "BallSimKernel.h"
+#include "BallDistanceField.h"
+#include "BallCollisionCorridor.h"
+#include "BallContactBatch.h"
+#include "Engine/World.h"
+#include "PhysicalMaterials/PhysicalMaterial.h"
+#include "Components/PrimitiveComponent.h"
+#include "Templates/IntegerSequence.h"
+#include "Algo/BinarySearch.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogBallSimKernel, Log, All);
+DEFINE_LOG_CATEGORY(LogBallSimKernel);
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Ball Contact Manifolds"), STAT_BallContactManifolds, STATGROUP_Game);
+
+void FBallSimConstants::SetMassProperties(float BallMass, float BallRadius, const FVector& InertiaTensorScale)
+{
+	Radius = BallRadius;
+	InvMass = (BallMass > KINDA_SMALL_NUMBER) ? (1.0f / BallMass) : 0.01f;
+
+	// 구체 관성 텐서 공식 (대각행렬 성분)
+	// I = (2/5) * m * r^2  |  m = 0.5kg (질량)  |  r = 0.11m (반지름)
+	const float BaseInertia = 0.4f * BallMass * BallRadius * BallRadius;
+	const FVector3f ScaledInertia = FVector3f(BaseInertia) * FVector3f(InertiaTensorScale);
+	InvInertiaTensor.X = (ScaledInertia.X > KINDA_SMALL_NUMBER) ? (1.0f / ScaledInertia.X) : 0.0f;
+	InvInertiaTensor.Y = (ScaledInertia.Y > KINDA_SMALL_NUMBER) ? (1.0f / ScaledInertia.Y) : 0.0f;
+	InvInertiaTensor.Z = (ScaledInertia.Z > KINDA_SMALL_NUMBER) ? (1.0f / ScaledInertia.Z) : 0.0f;
+}
+
+void FBallSimConstants::UpdateStepScales()
+{
+	LinearDampingStepScale = FMath::Clamp(1.0f - LinearDamping * StepInterval, 0.0f, 1.0f);
+	AngularDampingStepScale = FMath::Clamp(1.0f - AngularDamping * StepInterval, 0.0f, 1.0f);
+}
+
+FBallSurfaceCache::FEntry FBallSurfaceCache::MakeEntry(const FBallSimConstants& Constants, const TWeakObjectPtr<UPhysicalMaterial>& Material)
+{
+	FEntry Entry;
+	Entry.Material = Material;
+	Entry.Response.Friction = Constants.DefaultFriction;
+	Entry.Response.Restitution = Constants.DefaultRestitution;
+	Entry.Response.BounceSpinMultiplier = Constants.BouncedSpinMultiplier;
+
+	const UPhysicalMaterial* PhysMat = Material.Get();
+	Entry.SurfaceId = PhysMat ? (uint8)PhysMat->SurfaceType.GetValue() : (uint8)SurfaceType_Default;
+
+	if (Constants.SurfaceTable.IsValid() && !Constants.SurfaceTable->Get(Entry.SurfaceId).bUseMaterial)
+	{
+		Entry.Response = Constants.SurfaceTable->Get(Entry.SurfaceId);
+	}
+	else if (PhysMat)
+	{
+		// 표에 없는 종류는 기본 엔진 속성 (Material Editor에서 설정 가능)
+		Entry.Response.Friction = PhysMat->Friction;
+		Entry.Response.Restitution = PhysMat->Restitution;
+	}
+	return Entry;
+}
+
+const FBallSurfaceCache::FEntry& FBallSurfaceCache::Resolve(const FBallSimConstants& Constants, const TWeakObjectPtr<UPhysicalMaterial>& Material)
+{
+	// 핸들 비교는 객체를 해석하지 않음
+	for (const FEntry& Entry : Entries)
+	{
+		if (Entry.Material.HasSameIndexAndSerialNumber(Material))
+		{
+			return Entry;
+		}
+	}
+	return Entries.Add_GetRef(MakeEntry(Constants, Material));
+}
+
+void FBallSimKernel::ApplySpinToRotation(const FVector3f& AngularVelocity, float DeltaTime, FQuat4f& InOutRotation)
+{
+	// 회전 벡터 ω·Δt 의 지수 사상 (월드 기준 각속도이므로 왼쪽에서 곱함)
+	const FVector3f RotationVector = AngularVelocity * DeltaTime;
+	const float Angle = RotationVector.Size();
+	if (Angle < UE_SMALL_NUMBER)
+	{
+		return;
+	}
+
+	InOutRotation = FQuat4f(RotationVector / Angle, Angle) * InOutRotation;
+	InOutRotation.Normalize();
+}
+
+void FBallSimKernel::FlushRotation(FBallSimState& State)
+{
+	if (State.PendingSpinAngle > UE_SMALL_NUMBER)
+	{
+		State.Rotation = FQuat4f(State.PendingSpinAxis, State.PendingSpinAngle) * State.Rotation;
+		State.Rotation.Normalize();
+	}
+	State.PendingSpinAngle = 0.f;
+}
+
+float FBallSimKernel::ResolveBallContact(const FBallSimConstants& C, EBallSimFeature Features, FBallSimState& A, FBallSimState& B, const FVector3f& Normal)
+{
+	return ApplyBallContact(C, A, B, Normal, FBallContactBatch::ResolveSingle(MakeBallContactInput(C, Features, A, B, Normal)));
+}
+
+FBallContactInput FBallSimKernel::MakeBallContactInput(const FBallSimConstants& C, EBallSimFeature Features, const FBallSimState& A, const FBallSimState& B, const FVector3f& Normal)
+{
+	// 접촉점 P 에서 각 공의 질량중심으로 가는 벡터 r = P - C (Normal 은 B → A)
+	const FVector3f rA = -Normal * C.Radius;
+	const FVector3f rB = Normal * C.Radius;
+
+	// 접촉점의 상대 속도 = A 접촉점 속도 - B 접촉점 속도
+	// denom = m_A⁻¹ + m_B⁻¹ + [(I⁻¹ * (r_A × n)) × r_A]⋅n + [(I⁻¹ * (r_B × n)) × r_B]⋅n
+	FBallContactInput Contact;
+	Contact.Arm = rA;
+	Contact.Normal = Normal;
+	Contact.ImpactNormal = Normal;
+	Contact.LinearVelocity = A.LinearVelocity;
+	Contact.AngularVelocity = A.AngularVelocity;
+	Contact.SurfaceVelocity = B.LinearVelocity + FVector3f::CrossProduct(B.AngularVelocity, rB);
+	Contact.InvMass = C.InvMass;
+	Contact.InvInertia = C.InvInertiaTensor;
+	Contact.OtherInvMass = C.InvMass;
+	Contact.OtherInvInertia = C.InvInertiaTensor;
+	Contact.Restitution = C.DefaultRestitution;
+	Contact.Friction = C.DefaultFriction;
+	Contact.MaxImpulse = EnumHasAnyFlags(Features, EBallSimFeature::ImpulseClamp) ? C.MaxAllowedImpulse : UE_BIG_NUMBER;
+	return Contact;
+}
+
+float FBallSimKernel::ApplyBallContact(const FBallSimConstants& C, FBallSimState& A, FBallSimState& B, const FVector3f& Normal, const FBallContactResult& Result)
+{
+	if (Result.vRel > 0.f)
+	{
+		return 0.f;
+	}
+
+	// 작용 반작용 (법선 + 마찰 임펄스)
+	const FVector3f Impulse = Result.NormalImpulse * Normal + Result.FrictionImpulse;
+	A.LinearVelocity += Impulse * C.InvMass;
+	B.LinearVelocity -= Impulse * C.InvMass;
+
+	// 바운스인 경우에만 각속도 추가 감쇠 (접촉 유지 상태는 HandleCollision 의 슬라이딩과 같이 감쇠 없음)
+	if (Result.NormalImpulse > C.BounceThreshold)
+	{
+		A.AngularVelocity *= C.BouncedSpinMultiplier;
+		B.AngularVelocity *= C.BouncedSpinMultiplier;
+	}
+
+	// 두 공의 마찰 각속도 변화는 같음 (반대 팔, 반대 임펄스)
+	A.AngularVelocity += Result.AngularDelta * C.SpinToRotateMultiply;
+	B.AngularVelocity += Result.AngularDelta * C.SpinToRotateMultiply;
+
+	return Result.NormalImpulse;
+}
+
+FQuat FBallSimKernel::ReconstructRotation(
+	TArrayView<const FBallSimSnapshot> Snapshots,
+	TArrayView<const FBallRotationKey> RotationKeys,
+	float StepInterval,
+	float Time)
+{
+	if (Snapshots.Num() == 0 || RotationKeys.Num() == 0 || StepInterval <= 0.f)
+	{
+		return FQuat::Identity;
+	}
+
+	const int32 LastStep = Snapshots.Num() - 1;
+	const float StepTime = FMath::Clamp(Time / StepInterval, 0.f, (float)LastStep);
+	const int32 StepBefore = FMath::Min(FMath::FloorToInt(StepTime), LastStep);
+	const float Alpha = StepTime - StepBefore;
+
+	// StepBefore 이하의 마지막 키프레임
+	int32 KeyIndex = Algo::UpperBoundBy(RotationKeys, StepBefore, &FBallRotationKey::StepIndex) - 1;
+	KeyIndex = FMath::Max(KeyIndex, 0);
+
+	FQuat4f Rotation = FQuat4f(RotationKeys[KeyIndex].Rotation);
+	for (int32 i = RotationKeys[KeyIndex].StepIndex + 1; i <= StepBefore; ++i)
+	{
+		ApplySpinToRotation(Snapshots[i].SpinAxis * Snapshots[i].SpinSpeed, StepInterval, Rotation);
+	}
+
+	// 스텝 내부 구간은 다음 스텝의 각속도로 부분 적분
+	if (Alpha > 0.f && StepBefore < LastStep)
+	{
+		const FBallSimSnapshot& Next = Snapshots[StepBefore + 1];
+		ApplySpinToRotation(Next.SpinAxis * Next.SpinSpeed, Alpha * StepInterval, Rotation);
+	}
+
+	return FQuat(Rotation);
+}
+
+void FBallSimKernel::RecordInitialSnapshot(const FBallSimContext& Context, const FBallSimState& State)
+{
+	if (!Context.Snapshots)
+	{
+		return;
+	}
+
+	if (Context.RotationKeys)
+	{
+		FBallRotationKey& Key = Context.RotationKeys->AddDefaulted_GetRef();
+		Key.StepIndex = State.StepIndex;
+		Key.Rotation = FQuat(State.Rotation);
+	}
+
+	FBallSimSnapshot& snapshot = Context.Snapshots->AddDefaulted_GetRef();
+	snapshot.Time = State.StepIndex * Context.Constants.StepInterval;
+	snapshot.Position = State.Position;
+	snapshot.Direction = State.LinearVelocity.GetSafeNormal();
+	snapshot.Speed = State.LinearVelocity.Size();
+	snapshot.SpinAxis = State.AngularVelocity.GetSafeNormal();
+	snapshot.SpinSpeed = State.AngularVelocity.Size();
+	snapshot.hitCount = 0;
+	snapshot.BounceIndex = State.LastBounceIndex;
+}
+
+void FBallSimKernel::RecordCheckpoint(const FBallSimContext& Context, const FBallSimState& State)
+{
+	if (!Context.Checkpoints)
+	{
+		return;
+	}
+
+	FBallSimCheckpoint& Checkpoint = Context.Checkpoints->AddDefaulted_GetRef();
+	Checkpoint.State = State;
+	Checkpoint.NumSnapshots = Context.Snapshots ? Context.Snapshots->Num() : 0;
+	Checkpoint.NumHits = Context.Hits ? Context.Hits->Num() : 0;
+	Checkpoint.NumBounces = Context.Bounces ? Context.Bounces->Num() : 0;
+	Checkpoint.NumRotationKeys = Context.RotationKeys ? Context.RotationKeys->Num() : 0;
+	Checkpoint.NumEvents = Context.Events ? Context.Events->Num() : 0;
+}
+
+void FBallSimKernel::DetectEvents(const FBallSimContext& Context, FBallSimState& State, const FVector3f& LocalStartPosition, const FVector3f& StartVelocity, int32 NumHitsBefore, int32 PreviousBounceIndex)
+{
+	const float StepInterval = Context.Constants.StepInterval;
+	const float StepStartTime = (State.StepIndex - 1) * StepInterval;
+	// 트리거 (평면, 영역) 는 월드 기준
+	const FVector StartPosition = Context.ToWorld(LocalStartPosition);
+	const FVector EndPosition = Context.ToWorld(State.Position);
+	const FVector3f& EndVelocity = State.LinearVelocity;
+	const int32 NumEventsBefore = Context.Events->Num();
+
+	// 스텝 안의 위치는 시작, 끝 위치 사이 선형 보간 (오일러 적분의 스텝 경로와 같음)
+	auto AddEvent = [&](EBallSimEventType Type, float Alpha, int32 TriggerIndex = INDEX_NONE) -> FBallSimEvent&
+	{
+		FBallSimEvent& Event = Context.Events->AddDefaulted_GetRef();
+		Event.Type = Type;
+		Event.Time = StepStartTime + Alpha * StepInterval;
+		Event.StepIndex = State.StepIndex;
+		Event.Position = FMath::Lerp(StartPosition, EndPosition, Alpha);
+		Event.LinearVelocity = FVector(FMath::Lerp(StartVelocity, EndVelocity, Alpha));
+		Event.TriggerIndex = TriggerIndex;
+		return Event;
+	};
+
+	// 바운스 / 슬라이딩 시작, 스텝의 첫 충돌 시점 기준
+	const bool bHit = Context.Hits && Context.Hits->Num() > NumHitsBefore;
+	if (bHit)
+	{
+		const FBallSimBounce& FirstHit = (*Context.Hits)[NumHitsBefore];
+		const FBallSimBounce& LastHit = Context.Hits->Last();
+		const float Alpha = FMath::Clamp(FirstHit.TimeToBeforeHit / StepInterval, 0.f, 1.f);
+
+		const bool bWasSliding = Context.Hits->IsValidIndex(PreviousBounceIndex)
+			&& (*Context.Hits)[PreviousBounceIndex].bIsSliding
+			&& (*Context.Hits)[PreviousBounceIndex].SnapshotIndex == State.StepIndex - 1;
+
+		if (!LastHit.bIsSliding || !bWasSliding)
+		{
+			FBallSimEvent& Event = AddEvent(LastHit.bIsSliding ? EBallSimEventType::SlideStart : EBallSimEventType::Bounce, Alpha);
+			Event.Position = Context.ToWorld(FirstHit.ImpactPoint + FirstHit.ImpactNormal * Context.Constants.Radius);
+			Event.LinearVelocity = FVector(LastHit.BouncedDirection * LastHit.BouncedSpeed);
+		}
+	}
+
+	// 최고점, 충돌이 없는 스텝에서 수직 속도 부호가 바뀌는 시점 (스텝 안에서 속도는 선형 변화)
+	if (!bHit && StartVelocity.Z > 0.f && EndVelocity.Z <= 0.f)
+	{
+		AddEvent(EBallSimEventType::Apex, StartVelocity.Z / (StartVelocity.Z - EndVelocity.Z));
+	}
+
+	if (State.HandoffReason == EBallHandoffReason::Rest)
+	{
+		AddEvent(EBallSimEventType::Rest, 1.f);
+	}
+
+	if (const FBallSimEventQuery* Query = Context.EventQuery)
+	{
+		for (int32 Index = 0; Index < Query->Planes.Num(); ++Index)
+		{
+			const FBallSimEventPlane& Plane = Query->Planes[Index];
+			const float StartDistance = (float)((StartPosition - Plane.Origin) | Plane.Normal);
+			const float EndDistance = (float)((EndPosition - Plane.Origin) | Plane.Normal);
+			if ((StartDistance < 0.f) != (EndDistance < 0.f))
+			{
+				AddEvent(EBallSimEventType::PlaneCrossing, StartDistance / (StartDistance - EndDistance), Index);
+			}
+		}
+
+		const FVector Delta = EndPosition - StartPosition;
+		for (int32 Index = 0; Index < Query->Volumes.Num(); ++Index)
+		{
+			const FBox& Bounds = Query->Volumes[Index].Bounds;
+			if (!Bounds.IsValid)
+			{
+				continue;
+			}
+
+			// 선분과 박스의 교차 구간 [Enter, Exit] (슬랩 클리핑), 한 스텝 안에 통과하는 경우도 진입 / 이탈 모두 기록
+			float Enter = 0.f;
+			float Exit = 1.f;
+			for (int32 Axis = 0; Axis < 3 && Enter <= Exit; ++Axis)
+			{
+				if (FMath::Abs(Delta[Axis]) <= UE_SMALL_NUMBER)
+				{
+					if (StartPosition[Axis] < Bounds.Min[Axis] || StartPosition[Axis] > Bounds.Max[Axis])
+					{
+						Exit = -1.f;
+					}
+					continue;
+				}
+
+				float Near = (float)((Bounds.Min[Axis] - StartPosition[Axis]) / Delta[Axis]);
+				float Far = (float)((Bounds.Max[Axis] - StartPosition[Axis]) / Delta[Axis]);
+				if (Near > Far)
+				{
+					Swap(Near, Far);
+				}
+				Enter = FMath::Max(Enter, Near);
+				Exit = FMath::Min(Exit, Far);
+			}
+
+			if (Enter > Exit)
+			{
+				continue;
+			}
+
+			if (!Bounds.IsInsideOrOn(StartPosition))
+			{
+				AddEvent(EBallSimEventType::VolumeEnter, Enter, Index);
+			}
+			if (!Bounds.IsInsideOrOn(EndPosition))
+			{
+				AddEvent(EBallSimEventType::VolumeExit, Exit, Index);
+			}
+		}
+	}
+
+	// 스텝 안에서 시간 순으로 정렬 후 정지 조건 확인
+	TArrayView<FBallSimEvent> StepEvents = MakeArrayView(Context.Events->GetData() + NumEventsBefore, Context.Events->Num() - NumEventsBefore);
+	if (StepEvents.Num() > 1)
+	{
+		StepEvents.StableSort([](const FBallSimEvent& A, const FBallSimEvent& B) { return A.Time < B.Time; });
+	}
+
+	if (Context.EventQuery && State.HandoffReason == EBallHandoffReason::None)
+	{
+		for (const FBallSimEvent& Event : StepEvents)
+		{
+			if (Context.EventQuery->ShouldStop(Event))
+			{
+				State.HandoffReason = EBallHandoffReason::StopEvent;
+				break;
+			}
+		}
+	}
+}
+
+// Start → End 이동이 어떤 충돌체와도 닿을 수 없으면 true (Scene Query 없이 거리장과 경계 구만 검사)
+static bool CanSkipSweep(const FBallSimContext& Context, const FVector& Start, const FVector& End)
+{
+	if (!Context.DistanceField || !Context.MovableProxies)
+	{
+		return false;
+	}
+
+	const float Radius = Context.CollisionShape.GetSphereRadius();
+	if (Context.DistanceField->GetClearance(Start) <= (End - Start).Size() + Radius)
+	{
+		return false;
+	}
+
+	for (const FBallMovableProxy& Proxy : *Context.MovableProxies)
+	{
+		if (FMath::PointDistToSegmentSquared(Proxy.Center, Start, End) <= FMath::Square(Proxy.Radius + Radius)
+			&& !Context.QueryParams.GetIgnoredActors().Contains(Proxy.ActorId))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+template<uint32 Features>
+struct TBallSimKernel
+{
+	static constexpr bool bMagnus = (Features & (uint32)EBallSimFeature::Magnus) != 0;
+	static constexpr bool bDamping = (Features & (uint32)EBallSimFeature::Damping) != 0;
+	static constexpr bool bPhysMaterial = (Features & (uint32)EBallSimFeature::PhysMaterial) != 0;
+	static constexpr bool bImpulseClamp = (Features & (uint32)EBallSimFeature::ImpulseClamp) != 0;
+	static constexpr bool bObstacles = (Features & (uint32)EBallSimFeature::Obstacles) != 0;
+	static constexpr bool bAerodynamics = (Features & (uint32)EBallSimFeature::Aerodynamics) != 0;
+
+	static FBallSimKernel MakeKernel()
+	{
+		FBallSimKernel Kernel;
+		Kernel.Step = &Step;
+		Kernel.Run = &Run;
+		Kernel.HandleCollision = &HandleCollision;
+		Kernel.Features = (EBallSimFeature)Features;
+		return Kernel;
+	}
+
+	static void Run(const FBallSimContext& Context, FBallSimState& State, int32 LastStep)
+	{
+		const bool bCheckpoints = Context.Checkpoints && Context.CheckpointInterval > 0;
+		while (State.StepIndex < LastStep && State.HandoffReason == EBallHandoffReason::None)
+		{
+			Step(Context, State);
+
+			if (bCheckpoints && State.StepIndex % Context.CheckpointInterval == 0)
+			{
+				FBallSimKernel::RecordCheckpoint(Context, State);
+			}
+		}
+
+		// 종료 상태 (Handoff, 체크포인트 이어가기) 의 Rotation 이 정확하도록 반영
+		FBallSimKernel::FlushRotation(State);
+	}
+
+	static int32 Step(const FBallSimContext& Context, FBallSimState& State)
+	{
+		const FBallSimConstants& C = Context.Constants;
+		const int32 i = ++State.StepIndex;
+		State.Time = (i - 1) * C.StepInterval;
+
+		const FVector3f StartPosition = State.Position;
+		const FVector3f StartVelocity = State.LinearVelocity;
+		const int32 PreviousBounceIndex = State.LastBounceIndex;
+
+		// 위치, 속도 업데이트, 중력, 마찰력, 충돌 처리 (재귀)
+		const int32 NumHitsBefore = Context.Hits ? Context.Hits->Num() : 0;
+		int hitCount = HandleCollision(Context, State, C.StepInterval, 0);
+		if (hitCount > 0)
+		{
+			// 충돌 SubStep 처리 후 남은 현재 Step의 최종 바운스만 기록
+			State.BounceCount++;
+
+			if (Context.Hits && Context.Hits->Num() > NumHitsBefore)
+			{
+				const FBallSimBounce& BallBounce = Context.Hits->Last();
+				if (Context.Bounces)
+				{
+					Context.Bounces->Add(BallBounce);
+				}
+
+				State.LastBounceIndex = Context.Hits->Num() - 1;
+
+				if (BallBounce.bIsSliding)
+				{
+					UE_LOG(LogBallSimKernel, Verbose, TEXT("Rolling contact detected!!"));
+
+					// 시뮬레이션 정지, 물리 상태로 전환
+					if (C.bStopOnRollingContact)
+					{
+						State.HandoffReason = EBallHandoffReason::RollingContact;
+					}
+				}
+			}
+		}
+
+		FVector3f& linearVelocity = State.LinearVelocity;
+		const FVector3f& angularVelocity = State.AngularVelocity;
+
+		// 새로운 속도 및 방향, 스냅샷 저장용
+		const FVector3f direction = linearVelocity.GetSafeNormal();
+		const float speed = linearVelocity.Size();
+
+		// 바운스로 인해 축이 변경될 수 있음, 스냅샷 저장용
+		const FVector3f spinAxis = angularVelocity.GetSafeNormal();
+		const float spinSpeed = angularVelocity.Size();
+
+		// 속도와 스핀비로 계수 테이블을 조회해서 항력 (속도 반대) 과 양력 (ω × v 방향) 적용
+		// 항력 위기, 저회전 (너클) 구간의 양력 변화는 테이블이 표현함
+		if constexpr (bAerodynamics)
+		{
+			if (const FBallAeroTable* Aero = C.AeroTable.Get())
+			{
+				float dragCoefficient, liftCoefficient;
+				const float spinRatio = speed > UE_KINDA_SMALL_NUMBER ? spinSpeed * C.Radius / speed : 0.f;
+				Aero->Sample(speed * C.ReynoldsPerSpeed, spinRatio, dragCoefficient, liftCoefficient);
+
+				// |spinAxis × v| = v sinθ 이므로 회전축의 속도 수직 성분만 양력에 기여
+				const FVector3f aeroAcceleration = (FVector3f::CrossProduct(spinAxis, linearVelocity) * liftCoefficient - linearVelocity * dragCoefficient) * (C.AeroForceScale * speed);
+				linearVelocity += aeroAcceleration * C.StepInterval;
+			}
+		}
+		// 마그누스로 인한 횡력 적용 , 회전 속도가 충분히 클 때만 적용
+		else if constexpr (bMagnus)
+		{
+			if (spinSpeed > C.MinSpinForMagnus)
+			{
+				FVector3f magnusForce = FVector3f::CrossProduct(-direction * speed, angularVelocity) * C.SpinMagnusFactor;
+				linearVelocity += magnusForce * C.StepInterval;
+			}
+		}
+
+		// Δt 동안 회전, 스텝마다 쿼터니언을 적분하지 않고 같은 축의 회전각만 누적
+		// 축이 바뀌는 경우 (충돌) 와 키프레임에서만 Rotation 에 반영
+		if (spinSpeed > UE_SMALL_NUMBER)
+		{
+			if ((spinAxis | State.PendingSpinAxis) < 1.f - 1.e-6f)
+			{
+				FBallSimKernel::FlushRotation(State);
+				State.PendingSpinAxis = spinAxis;
+			}
+			State.PendingSpinAngle += spinSpeed * C.StepInterval;
+		}
+
+		if (Context.RotationKeys && Context.RotationKeyInterval > 0 && i % Context.RotationKeyInterval == 0)
+		{
+			FBallSimKernel::FlushRotation(State);
+
+			FBallRotationKey& Key = Context.RotationKeys->AddDefaulted_GetRef();
+			Key.StepIndex = i;
+			Key.Rotation = FQuat(State.Rotation);
+		}
+
+		// 스냅샷 저장
+		if (Context.Snapshots)
+		{
+			FBallSimSnapshot& snapshot = Context.Snapshots->AddDefaulted_GetRef();
+			snapshot.Time = i * C.StepInterval;
+			snapshot.Position = State.Position;
+			snapshot.Direction = direction;
+			snapshot.Speed = speed;
+			snapshot.SpinAxis = spinAxis;
+			snapshot.SpinSpeed = spinSpeed;
+			snapshot.hitCount = hitCount;
+			snapshot.BounceIndex = State.LastBounceIndex;
+		}
+
+		if (State.HandoffReason == EBallHandoffReason::None)
+		{
+			if (C.MaxAllowedBounce >= 0 && State.BounceCount >= C.MaxAllowedBounce)
+			{
+				State.HandoffReason = EBallHandoffReason::MaxBounce;
+			}
+			else if (hitCount > 0 && linearVelocity.SizeSquared() < FMath::Square(C.MinSpeed))
+			{
+				State.HandoffReason = EBallHandoffReason::Rest;
+			}
+		}
+
+		if (Context.Events)
+		{
+			FBallSimKernel::DetectEvents(Context, State, StartPosition, StartVelocity, NumHitsBefore, PreviousBounceIndex);
+		}
+
+		return hitCount;
+	}
+
+	static int32 HandleCollision(const FBallSimContext& Context, FBallSimState& State, const float DeltaTime, int32 Depth)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FBallSimKernel::HandleCollision);
+
+		const FBallSimConstants& C = Context.Constants;
+		FVector3f& pos = State.Position;
+		FVector3f& linearVelocity = State.LinearVelocity;
+		FVector3f& angularVelocity = State.AngularVelocity;
+
+		// SubStep 정지 조건
+		if (Depth > 10 || DeltaTime <= KINDA_SMALL_NUMBER)
+		{
+			return Depth;
+		}
+
+		// 다음 속도 및 위치 계산 (오일러 적분)
+		// 속도 변화 업데이트 (중력가속도 적용)
+		linearVelocity += C.Gravity * DeltaTime;
+
+		// 선형 감쇠 적용 (선형 감쇠는 Chaos에서 damping factor로 처리)
+		if constexpr (bDamping)
+		{
+			// Aerodynamics 에서는 항력 테이블이 선형 감쇠를 대신함
+			if (Depth == 0)
+			{
+				if constexpr (!bAerodynamics)
+				{
+					linearVelocity *= C.LinearDampingStepScale;
+				}
+				angularVelocity *= C.AngularDampingStepScale;
+			}
+			else
+			{
+				if constexpr (!bAerodynamics)
+				{
+					linearVelocity *= FMath::Clamp(1.0f - C.LinearDamping * DeltaTime, 0.0f, 1.0f);
+				}
+				angularVelocity *= FMath::Clamp(1.0f - C.AngularDamping * DeltaTime, 0.0f, 1.0f);
+			}
+		}
+
+		// 충돌이 없을 경우 사용될 nextPos 후보
+		FVector3f nextPos = pos + linearVelocity * DeltaTime;
+
+		// Scene Query 는 월드 기준, 결과는 다시 원점 기준으로 변환
+		const FVector worldPos = Context.ToWorld(pos);
+		const FVector worldNextPos = Context.ToWorld(nextPos);
+
+		// 거리장 여유 거리 안이고 움직이는 충돌체 경계 구와도 먼 이동은 Sweep 생략 (키네마틱 장애물은 아래에서 따로 검사)
+		FHitResult hit;
+		bool bHit = false;
+		if (!CanSkipSweep(Context, worldPos, worldNextPos))
+		{
+			INC_DWORD_STAT(STAT_BallSweeps);
+			if (Context.Corridor)
+			{
+				bHit = Context.Corridor->Sweep(Context, State, worldPos, worldNextPos, hit);
+			}
+			else
+			{
+				bHit = Context.World->SweepSingleByChannel(
+					hit,
+					worldPos,
+					worldNextPos,
+					FQuat::Identity,               // 회전 불필요
+					ECC_WorldStatic,
+					Context.CollisionShape,
+					Context.QueryParams
+				);
+			}
+		}
+		else
+		{
+			INC_DWORD_STAT(STAT_BallSweepsSkipped);
+		}
+
+		// 키네마틱 장애물은 SubStep 의 실제 시간 기준으로 검사, 월드 충돌보다 먼저 닿으면 대체
+		const FBallKinematicObstacle* HitObstacle = nullptr;
+		FVector3f SurfaceVelocity = FVector3f::ZeroVector;
+		if constexpr (bObstacles)
+		{
+			FHitResult ObstacleHit;
+			int32 ObstacleIndex = INDEX_NONE;
+			FVector ObstacleVelocity;
+			if (Context.Obstacles
+				&& Context.Obstacles->Sweep(worldPos, worldNextPos, State.Time, DeltaTime, ObstacleHit, ObstacleIndex, ObstacleVelocity)
+				&& (!bHit || !hit.bBlockingHit || ObstacleHit.Time < hit.Time))
+			{
+				hit = ObstacleHit;
+				bHit = true;
+				HitObstacle = &Context.Obstacles->GetObstacle(ObstacleIndex);
+				SurfaceVelocity = FVector3f(ObstacleVelocity);
+			}
+		}
+
+		if (!bHit || !hit.bBlockingHit)
+		{
+			pos = nextPos;
+			return Depth;
+		}
+
+		const FVector3f impactPoint = Context.ToLocal(hit.ImpactPoint);
+		const FVector3f impactNormal = FVector3f(hit.ImpactNormal);
+
+		FBallSimBounce HitCache;
+		HitCache.Direction = linearVelocity.GetSafeNormal();
+		HitCache.Speed = linearVelocity.Size();
+		HitCache.Spin = angularVelocity.Size();
+		HitCache.AngularVelocity = angularVelocity;
+		HitCache.StartPos = pos; // hit.TraceStart;
+		HitCache.ImpactPoint = impactPoint;
+		HitCache.ImpactNormal = impactNormal;
+
+		const float hitTimeRatio = hit.Time;
+
+		// 침투 방지 또는 해결을 위한 소량의 여유 마진
+		const float SmallMargin = KINDA_SMALL_NUMBER;
+		const float timeToBeforeHit = DeltaTime * hitTimeRatio - SmallMargin;
+
+		// 남은 시간으로 재귀 호출
+		const float remainingTime = DeltaTime - timeToBeforeHit;
+
+		// 히트 노멀 방향으로의 속도 비율 (음수이면 충돌면 쪽으로 이동 중)
+		const float LVdotN = (linearVelocity.GetSafeNormal() | impactNormal);
+
+		bool bIsSliding = false;
+		const bool bMultiHit = (Context.WorldTime - State.PreviousHitTime <= UE_KINDA_SMALL_NUMBER && timeToBeforeHit <= UE_KINDA_SMALL_NUMBER);
+
+		// 짧은 시간에 (주로 SubStep 에서) 연속적으로 hit가 발생  && 이전 충돌과 거의 동일한 노멀 방향
+		const float DotTolerance = 0.01f;
+		bIsSliding = (bMultiHit && FVector3f::Coincident(State.PreviousHitNormal, impactNormal)) ||
+			(FMath::Abs(LVdotN) <= DotTolerance);
+
+		State.PreviousHitTime = Context.WorldTime;
+		State.PreviousHitNormal = impactNormal;
+
+		/* 출동 직전 지점 까지 위치 업데이트
+		pos---------*----------------nextPos
+					↑
+					hit.Location(≈ Lerp(pos, nextPos, hit.Time - SmallMargin))
+		*/
+		pos = pos + linearVelocity * timeToBeforeHit;
+
+		// 충돌면 응답 계수, 장애물은 자체 값, 그 외는 재질별로 한번 계산한 응답 (충돌면 종류 ID 로 응답 표 조회)
+		FBallSurfaceResponse Surface;
+		Surface.Friction = C.DefaultFriction;
+		Surface.Restitution = C.DefaultRestitution;
+		Surface.BounceSpinMultiplier = C.BouncedSpinMultiplier;
+
+		if (HitObstacle)
+		{
+			Surface.Friction = HitObstacle->Friction;
+			Surface.Restitution = HitObstacle->Restitution;
+		}
+		else if constexpr (bPhysMaterial)
+		{
+			const FBallSurfaceCache::FEntry Entry = Context.SurfaceCache
+				? Context.SurfaceCache->Resolve(C, hit.PhysMaterial)
+				: FBallSurfaceCache::MakeEntry(C, hit.PhysMaterial);
+			HitCache.SurfaceType = (EPhysicalSurface)Entry.SurfaceId;
+			Surface = Entry.Response;
+		}
+		const float Friction = Surface.Friction;
+		const float Restitution = Surface.Restitution;
+
+		const float PenetrationDepthThreshold = 0.1f;     // 끼인 것으로 판단할 최소 깊이
+
+		// 같은 스텝 안에서 연속 충돌 (코너, 골대-바닥, 골망 모서리에 끼임) 이거나 침투 상태이면
+		// 충돌마다 재귀 Sweep 하지 않고 주변 접촉을 한번에 모아서 동시에 해결
+		if (!HitObstacle && C.ContactSolverIterations > 0
+			&& ((Depth > 0 && bMultiHit) || hit.bStartPenetrating || hit.PenetrationDepth > PenetrationDepthThreshold))
+		{
+			return ResolveContactManifold(Context, State, hit, HitCache, Surface, remainingTime, Depth);
+		}
+
+		// 충돌 임펄스 계산 (질량, 관성 텐서 반영)
+		// J = −((1+e)vRel) ​​/ (m⁻¹​+n⋅((I⁻¹(r×n))×r)(1+e)), 마찰은 쿠롱 모델 (μ * 법선 임펄스 이내)
+		// 응답 수식은 FBallContactBatch 레인 함수를 공유 (단일 접촉은 입력 정밀도 한 레인으로 계산)
+		FBallContactInput ContactInput;
+		// 접촉점 P 에서 구 질량중심 C 로 가는 벡터 (접촉점 - 구 중심) r = P - C
+		ContactInput.Arm = impactPoint - pos;
+		ContactInput.Normal = FVector3f(hit.Normal);
+		ContactInput.ImpactNormal = impactNormal;
+		ContactInput.LinearVelocity = linearVelocity;
+		ContactInput.AngularVelocity = angularVelocity;
+		// 충돌면의 속도 (이동 장애물)
+		ContactInput.SurfaceVelocity = SurfaceVelocity;
+		ContactInput.InvMass = C.InvMass;
+		ContactInput.InvInertia = C.InvInertiaTensor;
+		ContactInput.Restitution = Restitution;
+		ContactInput.Friction = Friction;
+		// (선택) 충격 임펄스 클램핑으로 과도한 임펄스 방지
+		ContactInput.MaxImpulse = bImpulseClamp ? C.MaxAllowedImpulse : UE_BIG_NUMBER;
+
+		const FBallContactResult Response = FBallContactBatch::ResolveSingle(ContactInput);
+
+		// 접촉점의 상대 속도 ContactVelocity를 히트 노멀 방향 으로 프로젝션해서 얻은 NormalVelocity(vRel) 값
+		const float vRel = Response.vRel;
+		HitCache.vRel = vRel;
+
+		// 접촉점이 서로 멀어지는 중이면 충돌 처리 불필요
+		if (vRel > 0.f)
+		{
+			pos = nextPos;
+			return Depth;
+		}
+
+		const float impulseMagnitude = Response.NormalImpulse;
+
+		// 임펄스 크기 impulseMagnitude (또는 법선 방향 상대 속도 vRel)가 충분히 크면 Bounce, 아니면 Sliding
+		if (impulseMagnitude <= C.BounceThreshold)
+		{
+			bIsSliding = true;
+			UE_LOG(LogBallSimKernel, Verbose, TEXT("Sliding detected! impulseMagnitude:%f"), impulseMagnitude);
+		}
+
+		// 임펄스 벡터 (법선 방향으로 impulseMagnitude 곱)
+		const FVector3f normalImpulse = impulseMagnitude * impactNormal;
+		HitCache.NormalImpulse = normalImpulse;
+
+		// 선형 속도 업데이트  v = v + impulse * InvMass
+		HitCache.LinearImpulse = normalImpulse * C.InvMass;
+		linearVelocity += HitCache.LinearImpulse;
+
+		// 마찰 임펄스 적용, 마찰로 인한 각속도 변화량 Δω = I⁻¹ * (r × J)
+		HitCache.FrictionImpulse = Response.FrictionImpulse;
+		HitCache.FrictionDelta = Response.FrictionImpulse * C.InvMass;
+		linearVelocity += HitCache.FrictionDelta;
+
+		const FVector3f angularDelta = Response.AngularDelta;
+		const float angularDeltaSize = angularDelta.Size();
+
+		//const float PenetrationVelocityDamping = 0.5f;    // 감속 계수
+
+		// trace started in penetration, i.e. with an initial blocking overlap.
+		const bool bIsStuck = hit.bStartPenetrating || hit.PenetrationDepth > PenetrationDepthThreshold;
+
+		HitCache.NextPos = Context.ToLocal(hit.Location) + linearVelocity * remainingTime;
+		HitCache.TimeToBeforeHit = timeToBeforeHit;
+		HitCache.RemainingTime = remainingTime;
+		HitCache.SnapshotIndex = State.StepIndex;
+		HitCache.BouncedDirection = linearVelocity.GetSafeNormal();
+		HitCache.BouncedSpeed = linearVelocity.Size();
+		HitCache.BouncedSpin = angularVelocity.Size();
+		HitCache.BouncedAngularVelocity = angularVelocity;
+		HitCache.PenetrationDepth = hit.PenetrationDepth;
+		HitCache.bIsSliding = bIsSliding;
+		HitCache.bWasStuck = bIsStuck;
+		HitCache.AngularDelta = angularDelta;
+		HitCache.AngularDeltaSize = angularDeltaSize;
+		if (Context.Hits)
+		{
+			Context.Hits->Add(HitCache);
+		}
+
+		if (bIsStuck)
+		{
+			// TBD - 재현 방법 및 동작 여부 확인 필요
+			// 침투 깊이만큼 푸시백
+			const FVector3f PenetrationDirection = hit.Normal.IsNearlyZero() ? FVector3f::UpVector : FVector3f(hit.Normal);
+			const float PushBack = hit.PenetrationDepth + SmallMargin;
+			pos += PenetrationDirection * PushBack;
+
+			UE_LOG(LogBallSimKernel, Verbose, TEXT("Penetration resolved: depth = %.3f, push = %s"), hit.PenetrationDepth, *PenetrationDirection.ToString());
+
+			return Depth + 1;
+		}
+
+		if (bIsSliding)
+		{
+			UE_LOG(LogBallSimKernel, Verbose, TEXT("Sliding detected : MultiHit = %s, LVdotN = %.4f, PreviousHitTime = %.4f"),
+				(bMultiHit ? TEXT("True") : TEXT("False")), LVdotN, State.PreviousHitTime);
+
+			// 충돌면 구름 저항 (잔디 길이, 젖은 잔디 등)
+			linearVelocity *= FMath::Max(1.f - Surface.RollingResistance * remainingTime, 0.f);
+
+			// 잔여 시간 동안 이동 (슬라이딩 상태에서의 위치 업데이트)
+			pos = pos + linearVelocity * remainingTime;
+
+			// 슬라이딩 상태인 경우 바운스로 인한 각속도 감쇠 (BouncedSpinMultiplier) 적용 안함
+			angularVelocity += angularDelta * C.SpinToRotateMultiply;
+			ApplySpinFriction(Surface, impactNormal, angularVelocity);
+
+			// 접촉 상태로 굴러가는 중이므로 SubStep 충돌 검사는 생략
+			return Depth + 1;	// 슬라이드 판정 시점 현재의 SubStep을 Hit Count에 반영
+		}
+
+		angularVelocity *= Surface.BounceSpinMultiplier; // 바운스로 인한 각속도 추가 감쇠
+		angularVelocity += angularDelta * C.SpinToRotateMultiply;
+		ApplySpinFriction(Surface, impactNormal, angularVelocity);
+
+		State.Time += timeToBeforeHit;
+		return HandleCollision(Context, State, remainingTime, Depth + 1);
+	}
+
+	// 충돌면 법선 축 회전 감쇠 (SpinFriction 이 0 이면 변화 없음)
+	static FORCEINLINE void ApplySpinFriction(const FBallSurfaceResponse& Surface, const FVector3f& Normal, FVector3f& AngularVelocity)
+	{
+		AngularVelocity -= Normal * ((AngularVelocity | Normal) * Surface.SpinFriction);
+	}
+
+	// 구 + ContactSkin 오버랩 한번으로 주변 정적 충돌체의 접촉을 모으고 (충돌체마다 MTD 한개)
+	// Sequential Impulse (누적 임펄스 클램핑) 로 법선, 마찰 임펄스를 동시에 풀어서 남은 시간만큼 진행
+	// 해결 후 속도는 모든 접촉에서 멀어지거나 접선 방향 (떨어진 접촉은 남은 시간 안에 간격 이내로만 접근) 이므로 재귀 Sweep 없이 진행
+	static int32 ResolveContactManifold(const FBallSimContext& Context, FBallSimState& State, const FHitResult& Hit, FBallSimBounce& HitCache,
+		const FBallSurfaceResponse& Surface, const float RemainingTime, int32 Depth)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FBallSimKernel::ResolveContactManifold);
+		INC_DWORD_STAT(STAT_BallContactManifolds);
+
+		static constexpr int32 MaxContacts = 4;
+
+		const FBallSimConstants& C = Context.Constants;
+		const float Friction = Surface.Friction;
+		const float Restitution = Surface.Restitution;
+		FVector3f& pos = State.Position;
+		FVector3f& linearVelocity = State.LinearVelocity;
+		FVector3f& angularVelocity = State.AngularVelocity;
+
+		struct FContact
+		{
+			FVector3f Normal;
+			// 음수이면 아직 떨어져 있는 거리 (ContactSkin 이내의 예측 접촉)
+			float Penetration;
+			float TargetVelocity;
+			float NormalImpulse;
+			FVector3f FrictionImpulse;
+		};
+		TArray<FContact, TInlineAllocator<MaxContacts>> Contacts;
+
+		auto AddContact = [&Contacts](const FVector3f& Normal, float Penetration)
+		{
+			if (Normal.IsNearlyZero())
+			{
+				return;
+			}
+
+			// 같은 면의 중복 접촉은 깊은 쪽만 유지
+			for (FContact& Existing : Contacts)
+			{
+				if ((Existing.Normal | Normal) > 0.99f)
+				{
+					Existing.Penetration = FMath::Max(Existing.Penetration, Penetration);
+					return;
+				}
+			}
+
+			if (Contacts.Num() < MaxContacts)
+			{
+				Contacts.Add({ Normal, Penetration, 0.f, 0.f, FVector3f::ZeroVector });
+			}
+		};
+
+		const FVector3f ImpactNormal = FVector3f(Hit.ImpactNormal);
+		AddContact(ImpactNormal, Hit.bStartPenetrating ? Hit.PenetrationDepth : 0.f);
+
+		const float Radius = Context.CollisionShape.GetSphereRadius();
+		const FCollisionShape SkinShape = FCollisionShape::MakeSphere(Radius + C.ContactSkin);
+
+		const FVector WorldPosition = Context.ToWorld(pos);
+		TArray<FOverlapResult> Overlaps;
+		Context.World->OverlapMultiByChannel(Overlaps, WorldPosition, FQuat::Identity, ECC_WorldStatic, SkinShape, Context.QueryParams);
+		for (const FOverlapResult& Overlap : Overlaps)
+		{
+			UPrimitiveComponent* Component = Overlap.GetComponent();
+			FMTDResult MTD;
+			if (Overlap.bBlockingHit && Component && Component->ComputePenetration(MTD, SkinShape, WorldPosition, FQuat::Identity))
+			{
+				AddContact(FVector3f(MTD.Direction), MTD.Distance - C.ContactSkin);
+			}
+		}
+
+		// 구의 접촉점은 항상 중심에서 -n * Radius 이므로 r × n = 0, 법선 방향 유효 질량은 질량 그대로
+		const float NormalMass = 1.f / C.InvMass;
+		const float MaxImpulse = bImpulseClamp ? C.MaxAllowedImpulse : UE_BIG_NUMBER;
+
+		// 반발 목표 속도는 해결 전 상대 속도 기준, 임펄스가 BounceThreshold 이하인 접촉은 반발 없음 (구름, 끼임)
+		// 떨어져 있는 예측 접촉은 남은 시간 안에 간격을 넘지 않을 만큼만 접근 허용 (닿기 전에 반발하지 않음)
+		const float InvRemainingTime = 1.f / FMath::Max(RemainingTime, KINDA_SMALL_NUMBER);
+		float ApproachSpeed = 0.f;
+		for (FContact& Contact : Contacts)
+		{
+			const FVector3f r = -Contact.Normal * Radius;
+			const float vRel = (linearVelocity + FVector3f::CrossProduct(angularVelocity, r)) | Contact.Normal;
+			if (Contact.Penetration < 0.f)
+			{
+				Contact.TargetVelocity = Contact.Penetration * InvRemainingTime;
+				continue;
+			}
+			Contact.TargetVelocity = (-vRel * NormalMass > C.BounceThreshold) ? -Restitution * vRel : 0.f;
+			ApproachSpeed = FMath::Min(ApproachSpeed, vRel);
+		}
+		HitCache.vRel = ApproachSpeed;
+
+		FVector3f angularDelta = FVector3f::ZeroVector;
+		for (int32 Iteration = 0; Iteration < C.ContactSolverIterations; ++Iteration)
+		{
+			for (FContact& Contact : Contacts)
+			{
+				const FVector3f r = -Contact.Normal * Radius;
+
+				// 법선 임펄스, 누적값이 음수 (당기는 힘) 가 되지 않도록 클램핑
+				FVector3f ContactVelocity = linearVelocity + FVector3f::CrossProduct(angularVelocity, r);
+				const float NormalImpulse = FMath::Clamp(Contact.NormalImpulse + (Contact.TargetVelocity - (ContactVelocity | Contact.Normal)) * NormalMass, 0.f, MaxImpulse);
+				linearVelocity += Contact.Normal * ((NormalImpulse - Contact.NormalImpulse) * C.InvMass);
+				Contact.NormalImpulse = NormalImpulse;
+
+				// 쿨롱 마찰, 누적 마찰 임펄스를 μ * 법선 임펄스 원 안으로 클램핑
+				ContactVelocity = linearVelocity + FVector3f::CrossProduct(angularVelocity, r);
+				const FVector3f tangentVelocity = ContactVelocity - (ContactVelocity | Contact.Normal) * Contact.Normal;
+				const float tangentSpeed = tangentVelocity.Size();
+				if (tangentSpeed <= KINDA_SMALL_NUMBER)
+				{
+					continue;
+				}
+
+				const FVector3f tangentDirection = tangentVelocity / tangentSpeed;
+				const FVector3f inertiaTerm = C.InvInertiaTensor * FVector3f::CrossProduct(r, tangentDirection);
+				const float denom = C.InvMass + FVector3f::DotProduct(FVector3f::CrossProduct(inertiaTerm, r), tangentDirection);
+
+				FVector3f FrictionImpulse = Contact.FrictionImpulse - tangentDirection * (tangentSpeed / denom);
+				const float MaxFrictionImpulse = Friction * Contact.NormalImpulse;
+				if (FrictionImpulse.SizeSquared() > FMath::Square(MaxFrictionImpulse))
+				{
+					FrictionImpulse = FrictionImpulse.GetSafeNormal() * MaxFrictionImpulse;
+				}
+
+				const FVector3f FrictionDelta = FrictionImpulse - Contact.FrictionImpulse;
+				Contact.FrictionImpulse = FrictionImpulse;
+
+				const FVector3f ContactAngularDelta = C.InvInertiaTensor * FVector3f::CrossProduct(r, FrictionDelta);
+				linearVelocity += FrictionDelta * C.InvMass;
+				angularVelocity += ContactAngularDelta * C.SpinToRotateMultiply;
+				angularDelta += ContactAngularDelta;
+			}
+		}
+
+		// 침투 해소 후 남은 시간 동안 진행
+		// 모든 접촉의 침투 깊이를 만족하는 하나의 보정 벡터로 밀어냄 (비슷한 방향의 법선끼리 보정이 중복되지 않음)
+		FVector3f Correction = FVector3f::ZeroVector;
+		for (int32 Pass = 0; Pass < MaxContacts; ++Pass)
+		{
+			for (const FContact& Contact : Contacts)
+			{
+				const float Deficit = Contact.Penetration + KINDA_SMALL_NUMBER - (Correction | Contact.Normal);
+				if (Contact.Penetration > 0.f && Deficit > 0.f)
+				{
+					Correction += Contact.Normal * Deficit;
+				}
+			}
+		}
+		pos += Correction;
+
+		FVector3f TotalNormalImpulse = FVector3f::ZeroVector;
+		FVector3f TotalFrictionImpulse = FVector3f::ZeroVector;
+		float MaxPenetration = 0.f;
+		for (const FContact& Contact : Contacts)
+		{
+			TotalNormalImpulse += Contact.Normal * Contact.NormalImpulse;
+			TotalFrictionImpulse += Contact.FrictionImpulse;
+			MaxPenetration = FMath::Max(MaxPenetration, Contact.Penetration);
+		}
+
+		const bool bIsSliding = TotalNormalImpulse.Size() <= C.BounceThreshold;
+		if (!bIsSliding)
+		{
+			angularVelocity *= Surface.BounceSpinMultiplier; // 바운스로 인한 각속도 추가 감쇠
+		}
+		else
+		{
+			linearVelocity *= FMath::Max(1.f - Surface.RollingResistance * RemainingTime, 0.f);
+		}
+		ApplySpinFriction(Surface, ImpactNormal, angularVelocity);
+
+		pos += linearVelocity * RemainingTime;
+
+		HitCache.NormalImpulse = TotalNormalImpulse;
+		HitCache.LinearImpulse = TotalNormalImpulse * C.InvMass;
+		HitCache.FrictionImpulse = TotalFrictionImpulse;
+		HitCache.FrictionDelta = TotalFrictionImpulse * C.InvMass;
+		HitCache.AngularDelta = angularDelta;
+		HitCache.AngularDeltaSize = angularDelta.Size();
+		HitCache.NextPos = pos;
+		HitCache.TimeToBeforeHit = 0.f;
+		HitCache.RemainingTime = RemainingTime;
+		HitCache.SnapshotIndex = State.StepIndex;
+		HitCache.BouncedDirection = linearVelocity.GetSafeNormal();
+		HitCache.BouncedSpeed = linearVelocity.Size();
+		HitCache.BouncedSpin = angularVelocity.Size();
+		HitCache.BouncedAngularVelocity = angularVelocity;
+		HitCache.PenetrationDepth = MaxPenetration;
+		HitCache.bIsSliding = bIsSliding;
+		HitCache.bWasStuck = MaxPenetration > 0.f;
+		HitCache.NumContacts = Contacts.Num();
+		if (Context.Hits)
+		{
+			Context.Hits->Add(HitCache);
+		}
+
+		UE_LOG(LogBallSimKernel, Verbose, TEXT("Contact manifold resolved : %d contacts, normal impulse = %.3f"), Contacts.Num(), TotalNormalImpulse.Size());
+
+		return Depth + 1;
+	}
+};
+
+template<uint32... FeatureMasks>
+static const FBallSimKernel* MakeBallSimKernelTable(TIntegerSequence<uint32, FeatureMasks...>)
+{
+	static const FBallSimKernel Table[] = { TBallSimKernel<FeatureMasks>::MakeKernel()... };
+	return Table;
+}
+
+const FBallSimKernel& FBallSimKernel::Get(EBallSimFeature Features)
+{
+	static const FBallSimKernel* Table = MakeBallSimKernelTable(TMakeIntegerSequence<uint32, (uint32)EBallSimFeature::All + 1>());
+	return Table[(uint32)(Features & EBallSimFeature::All)];
+}
@@ -0,0 +1,175 @@
+﻿// © 2025 UnrealStudy. All rights reserved.
+// Author: taru00@gmail.com | https://x.com/3devnote
+
+#include "BallSimulationScheduler.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/World.h"
+
+static TAutoConsoleVariable<float> CVarBallSchedulerBudgetMs(
+	TEXT("BallSim.Scheduler.BudgetMs"),
+	2.0f,
+	TEXT("프레임당 스케줄러 시뮬레이션 예산 (ms)"));
+
+static TAutoConsoleVariable<int32> CVarBallSchedulerSliceSteps(
+	TEXT("BallSim.Scheduler.SliceSteps"),
+	8,
+	TEXT("예산 확인 사이에 진행하는 스텝 수"));
+
+TStatId UBallSimulationScheduler::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UBallSimulationScheduler, STATGROUP_Tickables);
+}
+
+void UBallSimulationScheduler::Deinitialize()
+{
+	for (FEntry& Entry : Queue)
+	{
+		Complete(MoveTemp(Entry), EBallSimRequestStatus::Cancelled);
+	}
+	Queue.Reset();
+	FlushCompletions();
+
+	Super::Deinitialize();
+}
+
+int32 UBallSimulationScheduler::Submit(FBallSimSchedulerRequest&& Request)
+{
+	// 같은 키의 대기 중 요청은 결과가 필요 없으므로 대체
+	if (Request.CoalesceKey != FObjectKey())
+	{
+		for (int32 Index = Queue.Num() - 1; Index >= 0; --Index)
+		{
+			if (Queue[Index].Request.CoalesceKey == Request.CoalesceKey)
+			{
+				Complete(MoveTemp(Queue[Index]), EBallSimRequestStatus::Coalesced);
+				Queue.RemoveAt(Index, 1, false);
+			}
+		}
+	}
+
+	FEntry& Entry = Queue.AddDefaulted_GetRef();
+	Entry.Handle = NextHandle++;
+	Entry.Request = MoveTemp(Request);
+	return Entry.Handle;
+}
+
+bool UBallSimulationScheduler::Cancel(int32 Handle)
+{
+	const int32 Index = Queue.IndexOfByPredicate([Handle](const FEntry& Entry) { return Entry.Handle == Handle; });
+	if (Index == INDEX_NONE)
+	{
+		return false;
+	}
+
+	Complete(MoveTemp(Queue[Index]), EBallSimRequestStatus::Cancelled);
+	Queue.RemoveAt(Index, 1, false);
+	return true;
+}
+
+void UBallSimulationScheduler::Complete(FEntry&& Entry, EBallSimRequestStatus Status)
+{
+	if (Status == EBallSimRequestStatus::Completed)
+	{
+		INC_DWORD_STAT(STAT_BallSchedulerCompleted);
+	}
+	else
+	{
+		INC_DWORD_STAT(STAT_BallSchedulerDropped);
+	}
+
+	Completions.Emplace(MoveTemp(Entry), Status);
+}
+
+void UBallSimulationScheduler::FlushCompletions()
+{
+	TArray<TPair<FEntry, EBallSimRequestStatus>> Pending = MoveTemp(Completions);
+	Completions.Reset();
+
+	for (TPair<FEntry, EBallSimRequestStatus>& Completion : Pending)
+	{
+		const FBallSimSchedulerRequest& Request = Completion.Key.Request;
+		if (Request.OnComplete)
+		{
+			Request.OnComplete(Request, Completion.Value);
+		}
+	}
+}
+
+void UBallSimulationScheduler::Tick(float DeltaTime)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UBallSimulationScheduler::Tick);
+
+	const float BudgetMs = FMath::Max(CVarBallSchedulerBudgetMs.GetValueOnGameThread(), 0.f);
+	const int32 SliceSteps = FMath::Max(CVarBallSchedulerSliceSteps.GetValueOnGameThread(), 1);
+	const double Now = GetWorld()->GetTimeSeconds();
+
+	// 기한이 지난 요청은 진행하지 않고 버림
+	for (int32 Index = Queue.Num() - 1; Index >= 0; --Index)
+	{
+		const double Deadline = Queue[Index].Request.Deadline;
+		if (Deadline > 0.0 && Now > Deadline)
+		{
+			Complete(MoveTemp(Queue[Index]), EBallSimRequestStatus::Expired);
+			Queue.RemoveAt(Index, 1, false);
+		}
+	}
+
+	// 우선순위 > 기한이 가까운 순 > 제출 순
+	Queue.Sort([](const FEntry& A, const FEntry& B)
+	{
+		if (A.Request.Priority != B.Request.Priority)
+		{
+			return A.Request.Priority > B.Request.Priority;
+		}
+
+		const double DeadlineA = A.Request.Deadline > 0.0 ? A.Request.Deadline : DBL_MAX;
+		const double DeadlineB = B.Request.Deadline > 0.0 ? B.Request.Deadline : DBL_MAX;
+		if (DeadlineA != DeadlineB)
+		{
+			return DeadlineA < DeadlineB;
+		}
+		return A.Handle < B.Handle;
+	});
+
+	const double StartTime = FPlatformTime::Seconds();
+	const double EndTime = StartTime + BudgetMs * 0.001;
+	int32 NumSteps = 0;
+
+	while (Queue.Num() > 0)
+	{
+		FBallSimSchedulerRequest& Request = Queue[0].Request;
+		const FBallSimKernel& Kernel = FBallSimKernel::Get(Request.Features);
+
+		bool bOutOfBudget = false;
+		while (Request.State.StepIndex < Request.LastStep && Request.State.HandoffReason == EBallHandoffReason::None)
+		{
+			// 예산을 넘겨도 프레임마다 최소 한 조각은 진행 (기아 방지)
+			if (NumSteps > 0 && FPlatformTime::Seconds() >= EndTime)
+			{
+				bOutOfBudget = true;
+				break;
+			}
+
+			const int32 StepBefore = Request.State.StepIndex;
+			Kernel.Run(Request.Context, Request.State, FMath::Min(StepBefore + SliceSteps, Request.LastStep));
+			NumSteps += Request.State.StepIndex - StepBefore;
+		}
+
+		if (bOutOfBudget)
+		{
+			break;
+		}
+
+		Complete(MoveTemp(Queue[0]), EBallSimRequestStatus::Completed);
+		Queue.RemoveAt(0, 1, false);
+	}
+
+	LastBudgetUsedMs = (float)((FPlatformTime::Seconds() - StartTime) * 1000.0);
+
+	SET_DWORD_STAT(STAT_BallSchedulerQueueDepth, Queue.Num());
+	INC_DWORD_STAT_BY(STAT_BallSchedulerSteps, NumSteps);
+	SET_FLOAT_STAT(STAT_BallSchedulerBudget, BudgetMs);
+	SET_FLOAT_STAT(STAT_BallSchedulerBudgetUsed, LastBudgetUsedMs);
+
+	FlushCompletions();
+}
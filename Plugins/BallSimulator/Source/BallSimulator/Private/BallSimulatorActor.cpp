@@ -2,16 +2,33 @@
 // Author: taru00@gmail.com | https://x.com/3devnote
 
 #include "BallSimulatorActor.h"
+#include "BallPredictionScene.h"
 #include "DrawDebugHelpers.h"
-//#include "Chaos/ChaosEngineInterface.h"
-//#include "PhysicsProxy/SingleParticlePhysicsProxy.h"
-//#include "Chaos/ChaosSolver.h"
-//#include "Chaos/PhysicsMaterials.h"
+#include "Engine/Engine.h"
+#include "Engine/CollisionProfile.h"
+#include "EngineUtils.h"
+#include "Misc/SlowTask.h"
+#include "HAL/IConsoleManager.h"
+
+static FAutoConsoleCommandWithWorld CmdBallSimRegenerateSetPieces(
+    TEXT("BallSim.RegenerateSetPieces"),
+    TEXT("월드의 모든 시뮬레이터 액터 세트피스를 병렬로 다시 생성"),
+    FConsoleCommandWithWorldDelegate::CreateLambda([](UWorld* World)
+    {
+        TArray<ABallSimulatorActor*> Actors;
+        for (TActorIterator<ABallSimulatorActor> It(World); It; ++It)
+        {
+            Actors.Add(*It);
+        }
+        ABallSimulatorActor::RegenerateSetPieces(World, Actors);
+    }));
 
 // Sets default values
 ABallSimulatorActor::ABallSimulatorActor()
 {    
-    PrimaryActorTick.bCanEverTick = false;
+    // 재생 중에만 Tick
+    PrimaryActorTick.bCanEverTick = true;
+    PrimaryActorTick.bStartWithTickEnabled = false;
  
     // Root
     RootComponent = CreateDefaultSubobject<USceneComponent>(TEXT("Root"));
@@ -28,8 +45,11 @@ ABallSimulatorActor::ABallSimulatorActor()
     BallMeshComp->SetupAttachment(RootComponent);
 
     // SimSphereComp
+    // Handoff 전까지 물리 바디를 만들지 않도록 충돌 비활성
     SimSphereComp = CreateDefaultSubobject<USphereComponent>(TEXT("SimSphereComp"));
     SimSphereComp->SetupAttachment(RootComponent);
+    SimSphereComp->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    SimSphereComp->SetSimulatePhysics(false);
 
     // Sphere Collision Component
     SphereCollisionComp = CreateDefaultSubobject<USphereComponent>(TEXT("CollisionComponent"));
@@ -42,68 +62,199 @@ void ABallSimulatorActor::Tick(float DeltaTime)
 {
     Super::Tick(DeltaTime);
 
+    // Near 재생만 액터 Tick 으로 갱신
+    UpdatePlayback(true);
+}
+
+bool ABallSimulatorActor::UpdatePlayback(bool bFullFidelity)
+{
     if (!bIsPlayingAnimation)
-        return;
+        return false;
 
-    PlaybackTime += DeltaTime;
+    PlaybackTime = GetWorld()->GetTimeSeconds() - PlaybackStartTime;
 
-    FVector Position;
-    FQuat Rotation;
+    // 키네마틱 구간이 끝나면 강체 물리로 전환 (이벤트 정지 조건으로 끝난 경우 제외)
+    const EBallHandoffReason HandoffReason = BallSimulatorComp->HandoffReason;
+    if (HandoffReason != EBallHandoffReason::None && HandoffReason != EBallHandoffReason::StopEvent && PlaybackTime >= BallSimulatorComp->SimulationEndTime)
+    {
+        HandoffToPhysics();
+        return false;
+    }
 
-    if (BallSimulatorComp->GetBallPositionAndRotationAtSplineTime(SplineComp, PlaybackTime, Position, Rotation))
-    {        
-        BallMeshComp->SetWorldLocationAndRotation(Position, Rotation);
+    if (!bFullFidelity)
+    {
+        // 원거리 재생은 감소 궤적 위치만 사용, 회전 생략
+        BallMeshComp->SetWorldLocation(BallSimulatorComp->GetDecimatedPositionAtTime(PlaybackTime));
     }
     else
     {
-        bIsPlayingAnimation = false; // 끝났으면 정지
+        FVector Position;
+        FQuat Rotation;
+
+        if (BallSimulatorComp->GetBallPositionAndRotationAtSplineTime(SplineComp, PlaybackTime, Position, Rotation))
+        {
+            BallMeshComp->SetWorldLocationAndRotation(Position, Rotation);
+        }
+        else
+        {
+            FinishPlayback(); // 끝났으면 정지
+            return false;
+        }
+    }
+
+    if (PlaybackTime >= BallSimulatorComp->SimulationEndTime)
+    {
+        FinishPlayback();
+        return false;
     }
+    return true;
 }
 
-void ABallSimulatorActor::BeginPlay()
+void ABallSimulatorActor::SetPlaybackLOD(EBallPlaybackLOD LOD)
 {
-    //if (!SimWorld)
-    //{
-    //    SimWorld = UWorld::CreateWorld(EWorldType::None, false);      
-    //    NewWorld->bIsWorldInitialized = false;
+    if (PlaybackLOD == LOD)
+    {
+        return;
+    }
 
-    //    NewWorld->InitializeNewWorld();
+    const bool bWasNear = PlaybackLOD == EBallPlaybackLOD::Near;
+    PlaybackLOD = LOD;
 
-    //    NewWorld->SetFlags(RF_Standalone);
-    //}
+    const bool bNear = LOD == EBallPlaybackLOD::Near;
+    SetActorTickEnabled(bNear && bIsPlayingAnimation);
+
+    // 원거리 공은 이동 시 오버랩 갱신 생략
+    SphereCollisionComp->SetGenerateOverlapEvents(bNear);
+
+    // Near 로 돌아오면 생략했던 회전을 바로 복원
+    if (bNear && !bWasNear)
+    {
+        UpdatePlayback(true);
+    }
 }
 
-void ABallSimulatorActor::InitializeSimPhysicsScene()
+void ABallSimulatorActor::PlayTrajectory()
 {
-    //// ChaosPhysicsFactory 가 현재 엔진 Physics Factory임을 가정
-    //IPhysicsFactory* PhysicsFactory = Chaos::FChaosEngineInterface::Get()->GetPhysicsFactory();
+    if (BallSimulatorComp->GetSnapshots().Num() < 2)
+    {
+        return;
+    }
 
-    //// Chaos Solver 생성
-    //SimSolver = MakeUnique<FChaosSolver>();
-    //SimSolver->SetSolverMode(Chaos::ESolverMode::SingleThread);
-    //SimSolver->SetEnableAsyncMode(false);
+    ResetToKinematic();
 
-    //// Physics Scene 생성
-    //SimPhysicsScene = MakeUnique<FPhysScene_Chaos>(PhysicsFactory, SimSolver.Get());
+    BallSimulatorComp->ConvertSnapshotsToBezierSpline(BallSimulatorComp->K2_GetSnapshots(), SplineComp);
+    BallSimulatorComp->BuildDecimatedTrajectory(UBallPlaybackLODSubsystem::GetDecimationStep());
+    PlaybackTime = 0.f;
+    PlaybackStartTime = GetWorld()->GetTimeSeconds();
+    bIsPlayingAnimation = true;
+    SetActorTickEnabled(PlaybackLOD == EBallPlaybackLOD::Near);
 
-    //// 씬 초기화
-    //SimPhysicsScene->Init();
+    if (UBallPlaybackLODSubsystem* PlaybackLODSubsystem = GetWorld()->GetSubsystem<UBallPlaybackLODSubsystem>())
+    {
+        PlaybackLODSubsystem->Register(this);
+    }
+}
 
-    //// Solver에 씬 등록
-    //SimSolver->AddScene(SimPhysicsScene.Get());
+void ABallSimulatorActor::StopTrajectory()
+{
+    FinishPlayback();
 }
 
-// 별도 물리 시뮬레이션 Step 함수
-void ABallSimulatorActor::StepSimPhysicsScene(float DeltaTime)
+void ABallSimulatorActor::FinishPlayback()
+{
+    bIsPlayingAnimation = false;
+    SetActorTickEnabled(false);
+    SetPlaybackLOD(EBallPlaybackLOD::Near);
+
+    if (UBallPlaybackLODSubsystem* PlaybackLODSubsystem = GetWorld() ? GetWorld()->GetSubsystem<UBallPlaybackLODSubsystem>() : nullptr)
+    {
+        PlaybackLODSubsystem->Unregister(this);
+    }
+}
+
+void ABallSimulatorActor::HandoffToPhysics()
+{
+    FinishPlayback();
+
+    float HandoffTime;
+    FVector Position, LinearVelocity, AngularVelocity;
+    FQuat Rotation;
+    if (!BallSimulatorComp->GetHandoffState(HandoffTime, Position, Rotation, LinearVelocity, AngularVelocity))
+    {
+        return;
+    }
+
+    // 시뮬레이터의 마지막 상태를 그대로 강체 초기 상태로 사용
+    SimSphereComp->SetSphereRadius(SimulatedRadius);
+    SimSphereComp->SetWorldLocationAndRotation(Position, Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+    SimSphereComp->SetCollisionProfileName(UCollisionProfile::PhysicsActor_ProfileName);
+    SimSphereComp->SetCollisionEnabled(ECollisionEnabled::QueryAndPhysics);
+    SimSphereComp->SetMassOverrideInKg(NAME_None, BallMass, true);
+    SimSphereComp->SetSimulatePhysics(true);
+    SimSphereComp->SetPhysicsLinearVelocity(LinearVelocity);
+    SimSphereComp->SetPhysicsAngularVelocityInRadians(AngularVelocity);
+
+    // 메시는 강체를 따라감
+    BallMeshComp->SetWorldLocationAndRotation(Position, Rotation);
+    BallMeshComp->AttachToComponent(SimSphereComp, FAttachmentTransformRules::KeepWorldTransform);
+
+    bIsPhysicsHandedOff = true;
+}
+
+void ABallSimulatorActor::ResetToKinematic()
 {
-    //if (!SimPhysicsScene.IsValid())
-    //    return;
+    if (!bIsPhysicsHandedOff)
+    {
+        return;
+    }
 
-    //// 물리 시뮬레이션 수행
-    //SimPhysicsScene->Simulate(DeltaTime);
+    SimSphereComp->SetSimulatePhysics(false);
+    SimSphereComp->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+    SimSphereComp->AttachToComponent(RootComponent, FAttachmentTransformRules::KeepWorldTransform);
+    BallMeshComp->AttachToComponent(RootComponent, FAttachmentTransformRules::KeepWorldTransform);
 
-    // 필요 시 SimPhysicsScene 내 액터, 컴포넌트의 위치/회전값 읽기
-    // 예: SimPhysicsScene->GetRigidBodies() 등
+    bIsPhysicsHandedOff = false;
+}
+
+void ABallSimulatorActor::BeginPlay()
+{
+    Super::BeginPlay();
+
+    InitializeSimPhysicsScene();
+}
+
+void ABallSimulatorActor::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    FinishPlayback();
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void ABallSimulatorActor::InitializeSimPhysicsScene()
+{
+    UWorld* World = GetWorld();
+    UBallPredictionScene* PredictionScene = World ? World->GetSubsystem<UBallPredictionScene>() : nullptr;
+
+    // 컴포넌트가 예측 씬 사용을 선택한 경우에만 연결 (기본값은 게임 월드 Sweep)
+    if (!BallSimulatorComp->bUsePredictionScene || !PredictionScene || !PredictionScene->IsReady())
+    {
+        SimWorld = nullptr;
+        return;
+    }
+
+    // 예측 Sweep 은 게임 월드 대신 예측 씬에서 수행
+    SimWorld = PredictionScene->GetPredictionWorld();
+}
+
+// 별도 물리 시뮬레이션 Step 함수
+void ABallSimulatorActor::StepSimPhysicsScene(float DeltaTime)
+{
+    UWorld* World = GetWorld();
+    UBallPredictionScene* PredictionScene = World ? World->GetSubsystem<UBallPredictionScene>() : nullptr;
+    if (PredictionScene)
+    {
+        PredictionScene->RequestStep(DeltaTime);
+    }
 }
 
 void ABallSimulatorActor::SimulateBallPhysics(    
@@ -119,45 +270,105 @@ void ABallSimulatorActor::SimulateBallPhysics(
     UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
     if (!World) return;
 
-    //if (!SimWorld)
-    //{
-    //    if (GEngine)
-    //    {
-    //        GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Red, TEXT("Error: SimWorld is null! This function is available only after BeginPlay() has called."));
-    //    }
-    //    return;
-    //}
-
-/*    if(StepInterval <= 0.0f)
+    if(StepInterval <= 0.0f)
         return;
 
-    int TotalStepCount = SimulationTime / StepInterval;
-    OutSnapshots.Empty();
-    OutSnapshots.Reserve(TotalStepCount);
+    if (!SimWorld && BallSimulatorComp->bUsePredictionScene && GEngine)
+    {
+        GEngine->AddOnScreenDebugMessage(-1, 5.f, FColor::Yellow, TEXT("SimWorld is null, simulating against the game world. The prediction scene is available only after BeginPlay() has called."));
+    }
+
+    SimulatedRadius = SphereCollisionRadius;
+
+    const int32 TotalStepCount = FMath::Clamp(FMath::FloorToInt(SimulationTime / StepInterval), 1, UBallSimulatorComponent::MaxAllowedSimulationStep);
+
+    BallSimulatorComp->SimulateBallPhysics(
+        World,
+        BallMass,
+        SphereCollisionRadius,
+        InitialPosition,
+        FQuat::Identity,
+        InitialVelocity.GetSafeNormal(),
+        InitialVelocity.Size(),
+        InitialSpin.GetSafeNormal(),
+        InitialSpin.Size(),
+        TotalStepCount,
+        StepInterval);
 
-    SimSphereComp->SetWorldLocation(InitialPosition);
-    SimSphereComp->SetPhysicsLinearVelocity(InitialVelocity);
-    SimSphereComp->SetPhysicsAngularVelocityInRadians(InitialSpin);
-    SimSphereComp->SetSphereRadius(SphereCollisionRadius);
+    OutSnapshots = BallSimulatorComp->K2_GetSnapshots();
+}
+
+void ABallSimulatorActor::SimulateSetPiece()
+{
+    ABallSimulatorActor* Self = this;
+    RegenerateSetPieces(GetWorld(), MakeArrayView(&Self, 1));
+}
 
-    float TimeElapsed = 0.0f;
+void ABallSimulatorActor::RegenerateLevelSetPieces()
+{
+    UWorld* World = GetWorld();
+    if (!World)
+    {
+        return;
+    }
 
-    while (TimeElapsed < SimulationTime)
+    TArray<ABallSimulatorActor*> Actors;
+    for (TActorIterator<ABallSimulatorActor> It(World); It; ++It)
     {
-        SimWorld->Tick(ELevelTick::LEVELTICK_All, StepInterval);
+        Actors.Add(*It);
+    }
+    RegenerateSetPieces(World, Actors);
+}
+
+int32 ABallSimulatorActor::RegenerateSetPieces(UWorld* World, TArrayView<ABallSimulatorActor* const> Actors)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(ABallSimulatorActor::RegenerateSetPieces);
 
-        FBallSnapshot Snapshot;
-        Snapshot.Position = SimSphereComp->GetComponentLocation();
-        Snapshot.Rotation = SimSphereComp->GetComponentQuat();
-        Snapshot.Direction = SimSphereComp->GetPhysicsLinearVelocity();
-        Snapshot.Spin = SimSphereComp->GetPhysicsAngularVelocityInRadians();
-        Snapshot.Speed = Snapshot.Direction.Size();
+    if (!World)
+    {
+        return 0;
+    }
 
-        OutSnapshots.Add(Snapshot);
+    TArray<ABallSimulatorActor*> LaunchActors;
+    TArray<FBallParallelLaunch> Launches;
+    for (ABallSimulatorActor* Actor : Actors)
+    {
+        if (!Actor || !Actor->BallSimulatorComp || Actor->SetPieceStepInterval <= 0.f)
+        {
+            continue;
+        }
+
+        const int32 TotalStepCount = FMath::Clamp(FMath::FloorToInt(Actor->SetPieceSimulationTime / Actor->SetPieceStepInterval), 1, UBallSimulatorComponent::MaxAllowedSimulationStep);
+
+        FBallParallelLaunch& Launch = Launches.AddDefaulted_GetRef();
+        Launch.Simulator = Actor->BallSimulatorComp;
+        Launch.Launch = Actor->SetPieceLaunch;
+        Launch.Settings = FBallSimSettings(Actor->BallMass, Actor->SetPieceRadius, TotalStepCount, Actor->SetPieceStepInterval);
+        LaunchActors.Add(Actor);
+    }
 
-        if (Snapshot.Speed < 10.f && Snapshot.Spin.Size() < 1.f)
-            break;
+    if (Launches.Num() == 0)
+    {
+        return 0;
+    }
 
-        TimeElapsed += StepInterval;
-    }  */  
+    // 진행률은 완료된 액터 수 기준
+    FScopedSlowTask SlowTask((float)Launches.Num(), FText::Format(NSLOCTEXT("BallSimulator", "RegenerateSetPieces", "Simulating {0} set pieces..."), Launches.Num()));
+    SlowTask.MakeDialog(true);
+
+    return UBallSimulatorComponent::SimulateLaunchesParallel(World, Launches,
+        [&LaunchActors, &Launches, &SlowTask](int32 LaunchIndex)
+        {
+            ABallSimulatorActor* Actor = LaunchActors[LaunchIndex];
+            Actor->Modify();
+            Actor->SplineComp->Modify();
+            Actor->SimulatedRadius = Launches[LaunchIndex].Settings.Radius;
+            Actor->BallSimulatorComp->ConvertSnapshotsToBezierSpline(Actor->BallSimulatorComp->K2_GetSnapshots(), Actor->SplineComp);
+
+            SlowTask.EnterProgressFrame(1.f);
+        },
+        [&SlowTask]()
+        {
+            return SlowTask.ShouldCancel();
+        });
 }
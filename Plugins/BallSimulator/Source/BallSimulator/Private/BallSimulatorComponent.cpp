@@ -2,12 +2,42 @@
 // Author: taru00@gmail.com | https://x.com/3devnote
 
 #include "BallSimulatorComponent.h"
-#include "PhysicalMaterials/PhysicalMaterial.h"
+#include "BallPhysicsProfile.h"
+#include "BallTrajectoryRecorder.h"
+#include "BallPredictionScene.h"
+#include "BallTrajectoryValidator.h"
+#include "BallMultiSimulation.h"
+#include "BallSimulationScheduler.h"
+#include "BallDistanceField.h"
+#include "BallCollisionCorridor.h"
+#include "BallTrajectory.h"
+#include "BallTrajectoryLibrary.h"
 #include "CollisionShape.h"
+#include "Algo/BinarySearch.h"
+#include "Async/ParallelFor.h"
+#include "Containers/Queue.h"
+#include "HAL/Event.h"
+#include <atomic>
 
 DECLARE_LOG_CATEGORY_EXTERN(LogBallSimulatorComponent, Log, All);
 DEFINE_LOG_CATEGORY(LogBallSimulatorComponent);
 
+namespace BallSimulatorComponent
+{
+	static TSharedPtr<const FBallDistanceField, ESPMode::ThreadSafe> GetDistanceField(const UWorld* World)
+	{
+		const UBallDistanceFieldSubsystem* Subsystem = World ? World->GetSubsystem<UBallDistanceFieldSubsystem>() : nullptr;
+		return Subsystem ? Subsystem->GetDistanceField() : nullptr;
+	}
+
+	// 거리장이 있을 때만 필요 (거리장 없이는 Sweep 을 생략하지 않음)
+	static TSharedPtr<const TArray<FBallMovableProxy>, ESPMode::ThreadSafe> GetMovableProxies(const UWorld* World)
+	{
+		UBallDistanceFieldSubsystem* Subsystem = World ? World->GetSubsystem<UBallDistanceFieldSubsystem>() : nullptr;
+		return Subsystem && Subsystem->GetDistanceField().IsValid() ? Subsystem->GetMovableProxies() : nullptr;
+	}
+}
+
 // Sets default values for this component's properties
 UBallSimulatorComponent::UBallSimulatorComponent()
 {	
@@ -25,6 +55,126 @@ void UBallSimulatorComponent::TickComponent(float DeltaTime, ELevelTick TickType
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 }
 
+// 한번의 시뮬레이션에 필요한 입력과 출력, 비동기 경로에서는 워커 스레드로 그대로 넘어감
+struct FBallSimulationJob
+{
+	TWeakObjectPtr<UWorld> World;
+	FBallSimContext Context;
+	FBallSimState State;
+	EBallSimFeature Features = EBallSimFeature::All;
+	FBallObstacleSet Obstacles;
+	FBallLogLaunch Launch;
+
+	// 비동기 진행 중 다시 굽더라도 시뮬레이션이 끝날 때까지 유지
+	TSharedPtr<const FBallDistanceField, ESPMode::ThreadSafe> DistanceField;
+	TSharedPtr<const TArray<FBallMovableProxy>, ESPMode::ThreadSafe> MovableProxies;
+
+	// bUseCorridor 이면 월드 Sweep 대신 통로 후보 충돌체에만 Sweep
+	FBallCollisionCorridor Corridor;
+	bool bUseCorridor = false;
+	int32 SimulationSteps = 0;
+
+	// 작업이 만난 물리 재질별 충돌면 응답
+	FBallSurfaceCache SurfaceCache;
+
+	TArray<FBallSimSnapshot> Snapshots;
+	TArray<FBallSimBounce> Hits;
+	TArray<FBallSimBounce> Bounces;
+	TArray<FBallRotationKey> RotationKeys;
+	TArray<FBallSimCheckpoint> Checkpoints;
+	TArray<FBallSimEvent> Events;
+	FBallSimEventQuery EventQuery;
+
+	// 체크포인트에서 이어서 진행 (출력 버퍼는 체크포인트 시점 길이로 잘려 있어야 함)
+	bool bResume = false;
+
+	// 출력 버퍼 연결과 시작 상태 기록, 스케줄러 경로는 이후 스텝을 조각으로 나누어 진행
+	void Begin()
+	{
+		Context.Obstacles = &Obstacles;
+		Context.DistanceField = DistanceField.Get();
+		Context.MovableProxies = MovableProxies.Get();
+		Context.SurfaceCache = &SurfaceCache;
+		Context.Snapshots = &Snapshots;
+		Context.Hits = &Hits;
+		Context.Bounces = &Bounces;
+		Context.RotationKeys = &RotationKeys;
+		Context.Checkpoints = &Checkpoints;
+		Context.Events = &Events;
+		Context.EventQuery = &EventQuery;
+
+		if (bUseCorridor)
+		{
+			Corridor.Reset(SimulationSteps * Context.Constants.StepInterval);
+			Context.Corridor = &Corridor;
+		}
+
+		Snapshots.Reserve(FMath::Max(SimulationSteps, 1));
+		if (!bResume)
+		{
+			FBallSimKernel::RecordInitialSnapshot(Context, State);
+			FBallSimKernel::RecordCheckpoint(Context, State);
+		}
+	}
+
+	void Run()
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FBallSimulationJob::Run);
+
+		Begin();
+		FBallSimKernel::Get(Features).Run(Context, State, SimulationSteps - 1);
+	}
+
+	// 취소 확인 사이에 진행하는 스텝 수
+	static constexpr int32 CancelCheckSteps = 64;
+
+	// Run 과 같은 궤적, 조각마다 bCancelled 확인, 끝까지 진행하면 true
+	// 조각 끝마다 회전을 반영하므로 Rotation 은 Run 과 반올림 오차만큼 다를 수 있음
+	bool RunCancellable(const std::atomic<bool>& bCancelled)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FBallSimulationJob::RunCancellable);
+
+		Begin();
+		const FBallSimKernel& Kernel = FBallSimKernel::Get(Features);
+		const int32 LastStep = SimulationSteps - 1;
+		while (State.StepIndex < LastStep && State.HandoffReason == EBallHandoffReason::None)
+		{
+			if (bCancelled.load(std::memory_order_relaxed))
+			{
+				return false;
+			}
+			Kernel.Run(Context, State, FMath::Min(State.StepIndex + CancelCheckSteps, LastStep));
+		}
+		return true;
+	}
+};
+
+namespace BallSimulatorComponent
+{
+	// 작업의 출력 버퍼를 옮겨서 불변 궤적 생성, 이후 Job 의 출력 버퍼는 비어 있음
+	static TSharedRef<FBallTrajectory, ESPMode::ThreadSafe> MakeTrajectory(FBallSimulationJob& Job)
+	{
+		const float StepInterval = Job.Context.Constants.StepInterval;
+
+		TSharedRef<FBallTrajectory, ESPMode::ThreadSafe> Trajectory = MakeShared<FBallTrajectory, ESPMode::ThreadSafe>();
+		Trajectory->Snapshots = MoveTemp(Job.Snapshots);
+		Trajectory->Hits = MoveTemp(Job.Hits);
+		Trajectory->Bounces = MoveTemp(Job.Bounces);
+		Trajectory->RotationKeys = MoveTemp(Job.RotationKeys);
+		Trajectory->Events = MoveTemp(Job.Events);
+		Trajectory->StepInterval = StepInterval;
+		Trajectory->Origin = Job.Context.Origin;
+		Trajectory->WorldTime = Job.Context.WorldTime;
+		Trajectory->HandoffReason = Job.State.HandoffReason;
+
+		// Handoff / 정지 조건이면 마지막 스냅샷 시간
+		Trajectory->EndTime = Job.State.HandoffReason != EBallHandoffReason::None
+			? Job.State.StepIndex * StepInterval
+			: Job.SimulationSteps * StepInterval;
+		return Trajectory;
+	}
+}
+
 void UBallSimulatorComponent::SimulateBallPhysics(
 	const UObject* WorldContextObject,
 	const float BallMass,
@@ -38,7 +188,14 @@ void UBallSimulatorComponent::SimulateBallPhysics(
 	const int32 SimulationSteps,
 	const float StepInterval)
 {	
-	TRACE_CPUPROFILER_EVENT_SCOPE(UBallSimulatorComponent::SimulateBallPhysics);
+	SimulateLaunch(WorldContextObject,
+		FBallLaunchParams(InitialPosition, InitialRotation, InitialDirection, InitialSpeed, InitialSpinAxis, InitialSpinSpeed),
+		FBallSimSettings(BallMass, BallRadius, SimulationSteps, StepInterval));
+}
+
+void UBallSimulatorComponent::SimulateLaunch(const UObject* WorldContextObject, const FBallLaunchParams& Launch, const FBallSimSettings& Settings)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UBallSimulatorComponent::SimulateLaunch);
 
 	UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
 	if(!World)
@@ -46,422 +203,810 @@ void UBallSimulatorComponent::SimulateBallPhysics(
 		return;
 	}
 
-	CachedSnapshots.Reset();
-	CachedBounces.Reset();
-	CachedHits.Reset();
-	BounceCount = 0;	
-
-	//CachedSnapshots.Reserve(SimulationSteps);
-	const float InvMass = (BallMass > KINDA_SMALL_NUMBER) ? (1.0f / BallMass) : 0.01f;
-	FCollisionShape CollisionShape = FCollisionShape::MakeSphere(BallRadius);	
-	FVector pos = InitialPosition;
-	FVector linearVelocity = InitialDirection * InitialSpeed;
-	float speed = linearVelocity.Size();
-	FVector direction = linearVelocity.GetSafeNormal();
-	FVector spinAxis = InitialSpinAxis.GetSafeNormal();
-	float spinSpeed = InitialSpinSpeed;
-	float ballArea = PI * BallRadius * BallRadius;
-	FVector angularVelocity = spinAxis * spinSpeed;
-	FQuat Rotation = InitialRotation;
-	float EndTime = 0.0f;
-	SimulationStepInterval = StepInterval;
-	FBallSnapshot snapshot;
-
-	// 구체 관성 텐서 공식 (대각행렬 성분)
-	// I = (2/5) * m * r^2  |  m = 0.5kg (질량)  |  r = 0.11m (반지름)
-	// I = 2/5 * 0.5 * 0.11^2 = 0.00242 kg·m²
-	float BaseInertia = 0.4f * BallMass * BallRadius * BallRadius;
-	ScaledInertia = FVector(BaseInertia) * InertiaTensorScale;	
-	InvInertiaTensor.X = (ScaledInertia.X > KINDA_SMALL_NUMBER) ? (1.0f / ScaledInertia.X) : 0.0f;
-	InvInertiaTensor.Y = (ScaledInertia.Y > KINDA_SMALL_NUMBER) ? (1.0f / ScaledInertia.Y) : 0.0f;
-	InvInertiaTensor.Z = (ScaledInertia.Z > KINDA_SMALL_NUMBER) ? (1.0f / ScaledInertia.Z) : 0.0f;
-
-	// Initial Snapshot
-	snapshot.Time = 0.0f;
-	snapshot.Position = pos;
-	snapshot.Direction = direction;
-	//snapshot.SpinQuat = FQuat::Identity;
-	snapshot.Rotation = InitialRotation;
-	snapshot.Speed = speed;
-	snapshot.SpinSpeed = spinSpeed;
-	CachedSnapshots.Add(snapshot);	
-	
-	//SpinFrictionScale = FMath::Clamp(1.0f - SpinFriction, 0.0f, 1.0f);
+	// 진행 중인 비동기 요청 결과는 버림
+	++SimulationSerial;
+	bSimulationPending = false;
 
-	for (int32 i = 1; i < SimulationSteps; ++i)
-	{		
-		// 위치, 속도 업데이트, 중력, 마찰력, 충돌 처리 (재귀)
-		int hitCount = HandleCollision(World, InvMass, CollisionShape, pos, linearVelocity, angularVelocity, StepInterval, 0);		
-		if(hitCount > 0) 
-		{
-			// 충돌 SubStep 처리 후 남은 현재 Step의 최종 바운스만 기록
-			BounceCount++;
-			const FBallBounce& BallBounce = CachedHits.Last();
-			CachedBounces.Add(BallBounce);
-			
-			snapshot.BounceIndex = CachedHits.Num() - 1;			
-
-			if(BallBounce.bIsSliding)
-			{
-				// TBD - 시뮬레이션 정지, 물리 상태로 전환 
-				//SimulationEndTime = i * StepInterval;
-				//break;
-				UE_LOG(LogBallSimulatorComponent, Verbose, TEXT("Rolling contact detected!!"));
-			}
-		}
+	UBallPredictionScene* PredictionScene = GetPredictionScene(World);
 
-		// 새로운 속도 및 방향, 스냅샷 저장용
-		direction = linearVelocity.GetSafeNormal();
-		speed = linearVelocity.Size();
-
-		// 바운스로 인해 축이 변경될 수 있음, 스냅샷 저장용
-		spinAxis = angularVelocity.GetSafeNormal();
-		spinSpeed = angularVelocity.Size();
-
-		// 마그누스로 인한 횡력 적용 , 회전 속도가 충분히 클 때만 적용
-		if (spinSpeed > MinSpinForMagnus)
-		{			
-			FVector magnusForce = FVector::CrossProduct(-direction * speed, angularVelocity) * SpinMagnusFactor;
-			linearVelocity += magnusForce * StepInterval;
-			
-			// 회전 속도의 감쇠: 시간 간격에 따라 회전 속도 감소
-			//spinSpeed *= FMath::Pow(SpinFrictionScale, StepInterval);
-		}
-		
-		// Damping 만으로 단순화 가능
-		//if (speed > SMALL_NUMBER)              
-		//{
-		//  // 너무 느릴 땐 항력 생략,
-		//	FVector drag = -0.5f * Rho * CD * ballArea * speed * linearVelocity; // F_D
-		//	FVector accel = drag * InvMass;										 // a = F/m
-		//	linearVelocity += accel * StepInterval;                              
-		//}
-	
-		// Δt 동안 회전 (AngularVelocity 로 Rotation 업데이트)		
-		//FQuat DeltaRotation = FQuat(spinAxis, spinSpeed * StepInterval);
-		//Rotation = DeltaRotation * Rotation;
-		ApplySpinToRotation(angularVelocity, Rotation);
-
-		// AngularDamping 과 SpinToRotateMultiply 는 HandleCollision 에서 적용
-		// 회전 누적
-		
-		// 스냅샷 저장			
-		snapshot.Time = i * StepInterval;
-		snapshot.Position = pos;
-		snapshot.Direction = direction;
-		snapshot.Rotation = Rotation;		
-		snapshot.Speed = speed;
-		snapshot.SpinAxis = spinAxis;
-		snapshot.SpinSpeed = spinSpeed;
-		snapshot.hitCount = hitCount;
-		CachedSnapshots.Add(snapshot);
-		
-#if 0 
-		// TBD - 시뮬레이션 정지, 물리 상태로 전환
-		if (MaxAllowedBounce > 0 && BounceCount >= MaxAllowedBounce)
-		{
-			SimulationEndTime = i * StepInterval;
-			break;
-		}
-		if (snapshot.Speed < MinSpeed)
+	FBallSimulationJob Job;
+	PrepareSimulation(World, PredictionScene ? PredictionScene->GetPredictionWorld() : World, Launch, Settings, Job);
+
+	ExecuteSimulation(PredictionScene, Job);
+	FinishSimulation(Job);
+}
+
+int32 UBallSimulatorComponent::ResimulateFromTime(const UObject* WorldContextObject, const float ChangeTime)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UBallSimulatorComponent::ResimulateFromTime);
+
+	UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	if (!World || Checkpoints.Num() == 0 || SimulationStepInterval <= 0.f)
+	{
+		return INDEX_NONE;
+	}
+
+	// ChangeTime 이전의 마지막 체크포인트 (0 번은 항상 시작 상태)
+	int32 CheckpointIndex = Checkpoints.Num() - 1;
+	while (CheckpointIndex > 0 && Checkpoints[CheckpointIndex].State.StepIndex * SimulationStepInterval > ChangeTime)
+	{
+		--CheckpointIndex;
+	}
+	const FBallSimCheckpoint Checkpoint = Checkpoints[CheckpointIndex];
+
+	++SimulationSerial;
+	bSimulationPending = false;
+
+	UBallPredictionScene* PredictionScene = GetPredictionScene(World);
+
+	FBallSimulationJob Job;
+	PrepareSimulation(World, PredictionScene ? PredictionScene->GetPredictionWorld() : World,
+		FBallLaunchParams(
+			FVector(LastLaunch.Position[0], LastLaunch.Position[1], LastLaunch.Position[2]),
+			FQuat(LastLaunch.Rotation[0], LastLaunch.Rotation[1], LastLaunch.Rotation[2], LastLaunch.Rotation[3]),
+			FVector(LastLaunch.Direction[0], LastLaunch.Direction[1], LastLaunch.Direction[2]),
+			LastLaunch.Speed,
+			FVector(LastLaunch.SpinAxis[0], LastLaunch.SpinAxis[1], LastLaunch.SpinAxis[2]),
+			LastLaunch.SpinSpeed),
+		FBallSimSettings(LastLaunch.Mass, LastLaunch.Radius, LastLaunch.SimulationSteps, LastLaunch.StepInterval),
+		Job);
+
+	// 앞부분과 같은 조건으로 이어지도록 최초 시뮬레이션의 월드 시간과 원점 사용 (체크포인트와 이전 결과는 원점 기준)
+	Job.Context.WorldTime = SimulationWorldTime;
+	Job.Context.Origin = SimulationOrigin;
+
+	// 체크포인트 이후 결과를 잘라내고 그 뒤에 새 결과를 이어 붙임
+	Job.bResume = true;
+	Job.State = Checkpoint.State;
+	// 이전 궤적은 다른 소비자가 보관하고 있을 수 있으므로 체크포인트까지 복사
+	const FBallTrajectory& Previous = GetTrajectoryOrEmpty();
+	Job.Snapshots.Append(Previous.Snapshots.GetData(), FMath::Min(Checkpoint.NumSnapshots, Previous.Snapshots.Num()));
+	Job.Hits.Append(Previous.Hits.GetData(), FMath::Min(Checkpoint.NumHits, Previous.Hits.Num()));
+	Job.Bounces.Append(Previous.Bounces.GetData(), FMath::Min(Checkpoint.NumBounces, Previous.Bounces.Num()));
+	Job.RotationKeys.Append(Previous.RotationKeys.GetData(), FMath::Min(Checkpoint.NumRotationKeys, Previous.RotationKeys.Num()));
+	Job.Events.Append(Previous.Events.GetData(), FMath::Min(Checkpoint.NumEvents, Previous.Events.Num()));
+	Job.Checkpoints = MoveTemp(Checkpoints);
+	Job.Checkpoints.SetNum(CheckpointIndex + 1);
+
+	UE_LOG(LogBallSimulatorComponent, Verbose, TEXT("Resimulating from step %d of %d"), Checkpoint.State.StepIndex, LastLaunch.SimulationSteps);
+
+	ExecuteSimulation(PredictionScene, Job);
+	FinishSimulation(Job);
+
+	return Checkpoint.State.StepIndex;
+}
+
+int32 UBallSimulatorComponent::ResimulateInBounds(const UObject* WorldContextObject, const FBox& ChangedBounds)
+{
+	const FBallTrajectory& Data = GetTrajectoryOrEmpty();
+
+	if (Data.Snapshots.Num() < 2 || !ChangedBounds.IsValid)
+	{
+		return INDEX_NONE;
+	}
+
+	// 공 반지름만큼 확장한 영역을 처음 지나는 스텝부터 영향을 받음
+	const FBox InflatedBounds = ChangedBounds.ExpandBy(LastLaunch.Radius);
+	for (int32 i = 1; i < Data.Snapshots.Num(); ++i)
+	{
+		const FVector Start = Data.GetPosition(i - 1);
+		const FVector End = Data.GetPosition(i);
+		if (FMath::LineBoxIntersection(InflatedBounds, Start, End, End - Start))
 		{
-			SimulationEndTime = i * StepInterval;
-			break;
+			return ResimulateFromTime(WorldContextObject, (i - 1) * SimulationStepInterval);
 		}
-#endif
 	}
-	
-	// 시뮬레이션 종료 시간 저장
-	SimulationEndTime = SimulationSteps * StepInterval;
+
+	// 궤적이 변경 영역을 지나지 않으면 재시뮬레이션 불필요
+	return INDEX_NONE;
 }
 
-void UBallSimulatorComponent::ApplySpinToRotation(const FVector& InSpin, FQuat& OutRotation) const
+bool UBallSimulatorComponent::MakeClaimedTrajectory(FBallClaimedTrajectory& OutClaim) const
 {
-	// RPM(회전수)을 라디안 단위로 변환
-	const float RPM2QUATERNION = 0.104816f;
-	FVector spin = InSpin * RPM2QUATERNION;
-
-	FQuat deltaQuat;
-	deltaQuat.W = 0.5f * (-spin.X * OutRotation.X - spin.Y * OutRotation.Y - spin.Z * OutRotation.Z);
-	deltaQuat.X = 0.5f * (spin.X * OutRotation.W + spin.Y * OutRotation.Z - spin.Z * OutRotation.Y);
-	deltaQuat.Y = 0.5f * (spin.Y * OutRotation.W + spin.Z * OutRotation.X - spin.X * OutRotation.Z);
-	deltaQuat.Z = 0.5f * (spin.Z * OutRotation.W + spin.X * OutRotation.Y - spin.Y * OutRotation.X);
+	if (Checkpoints.Num() == 0)
+	{
+		return false;
+	}
 
-	OutRotation += deltaQuat;
-	OutRotation.Normalize();
+	FBallTrajectoryValidator::MakeClaim(Checkpoints, SimulationOrigin, GetBounces(), FinalState, SimulationWorldTime, SimulationStepInterval, OutClaim);
+	return true;
 }
 
-int UBallSimulatorComponent::HandleCollision(
-	UWorld* World,
-	const float InvMass,
-	const FCollisionShape& CollisionShape,
-	FVector& pos,
-	FVector& linearVelocity,
-	FVector& angularVelocity,
-	const float DeltaTime,
-	int32 Depth)
+FBallValidationResult UBallSimulatorComponent::ValidateClaimedTrajectory(
+	const UObject* WorldContextObject,
+	const float BallMass,
+	const float BallRadius,
+	const FVector& InitialPosition,
+	const FVector& InitialDirection,
+	const float InitialSpeed,
+	const FVector& InitialSpinAxis,
+	const float InitialSpinSpeed,
+	const float StepInterval,
+	const FBallClaimedTrajectory& Claim)
 {
-	TRACE_CPUPROFILER_EVENT_SCOPE(UBallSimulatorComponent::HandleCollision);
+	TRACE_CPUPROFILER_EVENT_SCOPE(UBallSimulatorComponent::ValidateClaimedTrajectory);
 
-	// SubStep 정지 조건
-	if (Depth > 10 || DeltaTime <= KINDA_SMALL_NUMBER)
+	UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	if (!World || Claim.Checkpoints.Num() == 0)
 	{
-		return Depth;
+		FBallValidationResult Result;
+		Result.Failure = EBallValidationFailure::Malformed;
+		Result.DivergenceTime = 0.f;
+		return Result;
 	}
 
-	// 다음 속도 및 위치 계산 (오일러 적분)
-	// 속도 변화 업데이트 (중력가속도 적용)
-	linearVelocity += GravityVector * DeltaTime;
-
-	// 선형 감쇠 적용 (선형 감쇠는 Chaos에서 damping factor로 처리)	
-	linearVelocity *= FMath::Clamp(1.0f - LinearDamping * DeltaTime, 0.0f, 1.0f);
-	angularVelocity *= FMath::Clamp(1.0f - AngularDamping * DeltaTime, 0.0f, 1.0f);
+	// 시뮬레이션과 같은 상수, 기능 조합, 장애물로 구성 (Sweep 은 읽기 전용이므로 구간별 워커에서 게임 월드에 동시 수행)
+	FBallSimulationJob Job;
+	PrepareSimulation(World, World,
+		FBallLaunchParams(InitialPosition, FQuat::Identity, InitialDirection, InitialSpeed, InitialSpinAxis, InitialSpinSpeed),
+		FBallSimSettings(BallMass, BallRadius, FMath::Clamp(Claim.Checkpoints.Last().StepIndex, 0, ValidationSettings.MaxTotalSteps) + 1, StepInterval),
+		Job);
+	// Begin 과 같은 입력 연결, 출력 버퍼는 구간별로 Validate 가 만듦
+	Job.Context.Obstacles = &Job.Obstacles;
+	Job.Context.DistanceField = Job.DistanceField.Get();
+	Job.Context.MovableProxies = Job.MovableProxies.Get();
+	Job.Context.SurfaceCache = &Job.SurfaceCache;
+	if (Job.bUseCorridor)
+	{
+		Job.Corridor.Reset(Job.SimulationSteps * StepInterval);
+		Job.Context.Corridor = &Job.Corridor;
+	}
 
-	// 충돌이 없을 경우 사용될 nextPos 후보
-	FVector nextPos = pos + linearVelocity * DeltaTime;
+	return FBallTrajectoryValidator::Validate(Job.Context, Job.Features, Job.State, Claim, ValidationSettings);
+}
 
-	FHitResult hit;
-	bool bHit = World->SweepSingleByChannel(
-		hit,
-		pos,
-		nextPos,
-		FQuat::Identity,               // 회전 불필요
-		ECC_WorldStatic,
-		CollisionShape,
-		FCollisionQueryParams(FName(TEXT("BallSimSweep")), true)
-	);
+UBallPredictionScene* UBallSimulatorComponent::GetPredictionScene(UWorld* World) const
+{
+	UBallPredictionScene* PredictionScene = bUsePredictionScene && World ? World->GetSubsystem<UBallPredictionScene>() : nullptr;
+	return PredictionScene && PredictionScene->IsReady() ? PredictionScene : nullptr;
+}
 
-	if (bHit && hit.bBlockingHit)
+void UBallSimulatorComponent::ExecuteSimulation(UBallPredictionScene* PredictionScene, FBallSimulationJob& Job)
+{
+	if (PredictionScene)
+	{
+		// 예측 월드는 워커 스레드만 접근하므로 작업을 넘기고 완료까지 대기 (동기 API 이므로 게임 스레드를 막음)
+		PredictionScene->EnqueueTask([&Job](UWorld*) { Job.Run(); }, nullptr);
+		PredictionScene->Flush();
+	}
+	else
 	{
-		FBallBounce HitCache;
-		HitCache.Direction = linearVelocity.GetSafeNormal();
-		HitCache.Speed = linearVelocity.Size();
-		HitCache.Spin = angularVelocity.Size();
-		HitCache.AngularVelocity = angularVelocity;
-		HitCache.StartPos = pos; // hit.TraceStart;
-		HitCache.ImpactPoint = hit.ImpactPoint;
-		HitCache.ImpactNormal = hit.ImpactNormal;
-		HitCache.Hit = hit;
+		Job.Run();
+	}
+}
 
-		const float hitTimeRatio = hit.Time;
+void UBallSimulatorComponent::SimulateLaunches(
+	const UObject* WorldContextObject,
+	const TArray<FBallLaunchParams>& Launches,
+	const FBallSimSettings& Settings,
+	TArray<FBallTrajectoryHandle>& OutTrajectories)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UBallSimulatorComponent::SimulateLaunches);
 
-		// 침투 방지 또는 해결을 위한 소량의 여유 마진
-		const float SmallMargin = KINDA_SMALL_NUMBER;
-		const float timeToBeforeHit = DeltaTime * hitTimeRatio - SmallMargin;
+	OutTrajectories.Reset(Launches.Num());
 
-		// 남은 시간으로 재귀 호출
-		const float remainingTime = DeltaTime - timeToBeforeHit;
+	UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	if (!World || Launches.Num() == 0)
+	{
+		return;
+	}
 
-		// 히트 노멀 방향으로의 속도 비율 (음수이면 충돌면 쪽으로 이동 중)
-		const float LVdotN = (linearVelocity.GetSafeNormal() | hit.ImpactNormal);	
+	UBallPredictionScene* PredictionScene = GetPredictionScene(World);
+	UWorld* QueryWorld = PredictionScene ? PredictionScene->GetPredictionWorld() : World;
 
-		bool bIsSliding = false;			
-		const bool bMultiHit = (World->GetTimeSeconds() - PreviousHitTime <= UE_KINDA_SMALL_NUMBER && timeToBeforeHit <= UE_KINDA_SMALL_NUMBER);
+	// 튜닝 상수, 장애물 구성은 게임 스레드에서 발사마다 한번, 컴포넌트 상태 (마지막 결과, 진행 중인 요청) 는 건드리지 않음
+	TArray<FBallSimulationJob> Jobs;
+	Jobs.SetNum(Launches.Num());
+	for (int32 Index = 0; Index < Launches.Num(); ++Index)
+	{
+		PrepareSimulation(World, QueryWorld, Launches[Index], Settings, Jobs[Index]);
+	}
 
-		// if velocity still into wall (after HandleBlockingHit() had a chance to adjust), slide along wall
-		// 짧은 시간에 (주로 SubStep 에서) 연속적으로 hit가 발생  && 이전 충돌과 거의 동일한 노멀 방향
-		const float DotTolerance = 0.01f;
-		bIsSliding = (bMultiHit && FVector::Coincident(PreviousHitNormal, hit.ImpactNormal)) ||
-			(FMath::Abs(LVdotN) <= DotTolerance);
-			
-		PreviousHitTime = World->GetTimeSeconds();
-		PreviousHitNormal = hit.ImpactNormal;			
+	// 예측 씬 작업 전환과 대기는 발사마다가 아니라 한번만 (결과를 바로 반환하므로 게임 스레드를 막음)
+	// 예측 월드는 워커 스레드에서만 접근하므로 작업 안에서는 발사를 차례로 진행
+	if (PredictionScene)
+	{
+		PredictionScene->EnqueueTask([&Jobs](UWorld*)
+		{
+			for (FBallSimulationJob& Job : Jobs)
+			{
+				Job.Run();
+			}
+		}, nullptr);
+		PredictionScene->Flush();
+	}
+	else
+	{
+		ParallelFor(Jobs.Num(), [&Jobs](int32 Index)
+		{
+			Jobs[Index].Run();
+		});
+	}
 
-		/* 출동 직전 지점 까지 위치 업데이트
-		pos---------*----------------nextPos
-					↑
-					hit.Location(≈ Lerp(pos, nextPos, hit.Time - SmallMargin))
-		*/
-		pos = pos + linearVelocity * timeToBeforeHit;
+	for (FBallSimulationJob& Job : Jobs)
+	{
+		OutTrajectories.Emplace(BallSimulatorComponent::MakeTrajectory(Job));
+	}
+}
 
-		// 약간 더 이동 (충돌면에 살짝 박히는 현상 방지)
-		//pos += HitCache.BouncedDirection * HitCache.BouncedSpeed * KINDA_SMALL_NUMBER;
+int32 UBallSimulatorComponent::SimulateLaunchesParallel(
+	UWorld* World,
+	TArrayView<const FBallParallelLaunch> Launches,
+	TFunctionRef<void(int32 LaunchIndex)> OnLaunchComplete,
+	TFunctionRef<bool()> ShouldCancel)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UBallSimulatorComponent::SimulateLaunchesParallel);
 
-		//pos = hit.Normal * hit.PenetrationDepth + PullBackDistance;
+	if (!World || Launches.Num() == 0)
+	{
+		return 0;
+	}
 
-		float Friction = DefaultFriction;
-		float Restitution = DefaultRestitution;
+	// 예측 씬이 있으면 워커 스레드에서 예측 월드에, 없으면 게임 스레드에서 World 에 Sweep
+	// 게임 월드는 콜백 (OnLaunchComplete, ShouldCancel) 과 다른 스레드에서 계속 바뀔 수 있으므로 워커 스레드에서 직접 Sweep 하지 않음
+	UBallPredictionScene* PredictionScene = World->GetSubsystem<UBallPredictionScene>();
+	if (PredictionScene && !PredictionScene->IsReady())
+	{
+		PredictionScene = nullptr;
+	}
+	UWorld* QueryWorld = PredictionScene ? PredictionScene->GetPredictionWorld() : World;
 
-		// 충돌한 물리 재질에서 속성 가져오기
-		if (hit.PhysMaterial.IsValid())
+	// 준비는 게임 스레드에서 (컴포넌트 튜닝, 장애물, 프로파일 읽기)
+	TArray<FBallSimulationJob> Jobs;
+	Jobs.SetNum(Launches.Num());
+	for (int32 Index = 0; Index < Launches.Num(); ++Index)
+	{
+		UBallSimulatorComponent* Simulator = Launches[Index].Simulator;
+		if (Simulator)
 		{
-			UPhysicalMaterial* PhysMat = hit.PhysMaterial.Get();
-
-			// 커스텀 탄성/마찰 계수 가져오기 (기본 엔진 값 or 사용자 정의)
-			// 예: PhysicalMaterial 에서 SurfaceType으로 분기하거나
-			// 사용자 정의 UPhysicalMaterial 서브클래스에서 속성 직접 사용 가능
-			// 기본 엔진 속성 (Material Editor에서 설정 가능)
-			Friction = PhysMat->Friction;
-			Restitution = PhysMat->Restitution;
+			// 진행 중인 비동기 요청 결과는 버림
+			++Simulator->SimulationSerial;
+			Simulator->bSimulationPending = false;
+			Simulator->PrepareSimulation(World, QueryWorld, Launches[Index].Launch, Launches[Index].Settings, Jobs[Index]);
 		}
+	}
 
-		// 마찰로 인한 감쇠. 마찰이 크면 접선 속도는 작아진다.
-		float frictionScale = FMath::Clamp(1.0f - Friction, 0.f, 1.0f);
+	std::atomic<bool> bCancelled{ false };
+	int32 NumCompleted = 0;
+	auto ApplyCompletedJob = [&](int32 Index)
+	{
+		Launches[Index].Simulator->FinishSimulation(Jobs[Index]);
+		++NumCompleted;
+		OnLaunchComplete(Index);
+	};
 
-		// https://research.ncl.ac.uk/game/mastersdegree/gametechnologies/previousinformation/physics6collisionresponse/2017%20Tutorial%206%20-%20Collision%20Response.pdf
-		// 충돌 임펄스 계산 (질량, 관성 텐서 반영)
-		// J = −((1+e)vRel) ​​/ (m⁻¹​+n⋅((I⁻¹(r×n))×r)(1+e))		
-		// 1) 접촉점 P 에서 구 질량중심 C 로 가는 벡터 (접촉점 - 구 중심) r = P - C
-		const FVector hitPointToCenter = hit.ImpactPoint - pos;
+	if (PredictionScene)
+	{
+		// 예측 월드는 워커 스레드에서만 접근하므로 한 작업 안에서 발사를 차례로 진행하고 발사가 끝날 때마다 깨움
+		TQueue<int32, EQueueMode::Spsc> CompletedJobs;
+		std::atomic<bool> bFinished{ false };
+		FEvent* WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
 
-		// 구의 접촉점 Tangential 속도 (스핀에 따른 속도 변화 적용)
-		const FVector ContactAngularVelocity = FVector::CrossProduct(angularVelocity, hitPointToCenter);
-		// 접촉점의 상대 속도 = 구의 선형 속도 + (구의 각속도 × (접촉점 - 구의 중심))		
-		const FVector ContactVelocity = linearVelocity + ContactAngularVelocity;
+		PredictionScene->EnqueueTask([&Jobs, &Launches, &bCancelled, &CompletedJobs, &bFinished, WakeEvent](UWorld*)
+		{
+			for (int32 Index = 0; Index < Jobs.Num() && !bCancelled.load(std::memory_order_relaxed); ++Index)
+			{
+				if (Launches[Index].Simulator && Jobs[Index].RunCancellable(bCancelled))
+				{
+					CompletedJobs.Enqueue(Index);
+					WakeEvent->Trigger();
+				}
+			}
 
-		// 접촉점의 상대 속도 ContactVelocity를 히트 노멀 방향 으로 프로젝션해서 얻은 NormalVelocity(vRel) 값
-		const float vRel = FVector::DotProduct(ContactVelocity, hit.Normal);
-		HitCache.vRel = vRel;
+			// 이 뒤로는 게임 스레드 스택의 변수에 접근하지 않음
+			WakeEvent->Trigger();
+			bFinished.store(true, std::memory_order_release);
+		}, nullptr);
 
-		// 접촉점이 서로 멀어지는 중이면 충돌 처리 불필요			
-		if (vRel > 0.f)
+		// 게임 스레드는 끝난 발사 반영과 취소 확인만, 발사가 끝나면 바로 깨고 그 사이에는 취소 확인 간격만큼 대기
+		constexpr uint32 CancelCheckIntervalMs = 10;
+		for (;;)
 		{
-			pos = nextPos;
-			return Depth;
+			const bool bWorkerFinished = bFinished.load(std::memory_order_acquire);
+
+			int32 Index;
+			while (CompletedJobs.Dequeue(Index))
+			{
+				ApplyCompletedJob(Index);
+			}
+
+			if (bWorkerFinished)
+			{
+				break;
+			}
+
+			if (!bCancelled.load(std::memory_order_relaxed) && ShouldCancel())
+			{
+				bCancelled.store(true, std::memory_order_relaxed);
+			}
+			WakeEvent->Wait(CancelCheckIntervalMs);
 		}
 
-		// 2) r × n , r:hitPointToCenter , n:hit.ImpactNormal
-		const FVector rCrossN = FVector::CrossProduct(hitPointToCenter, hit.ImpactNormal);
+		FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	}
+	else
+	{
+		// 게임 월드 Sweep 은 게임 스레드에서만, 취소는 발사 사이에서 확인
+		for (int32 Index = 0; Index < Jobs.Num(); ++Index)
+		{
+			if (ShouldCancel())
+			{
+				bCancelled.store(true, std::memory_order_relaxed);
+				break;
+			}
+
+			if (Launches[Index].Simulator && Jobs[Index].RunCancellable(bCancelled))
+			{
+				ApplyCompletedJob(Index);
+			}
+		}
+	}
+
+	UE_LOG(LogBallSimulatorComponent, Log, TEXT("Parallel simulation finished %d of %d launches%s"),
+		NumCompleted, Launches.Num(), bCancelled.load() ? TEXT(" (cancelled)") : TEXT(""));
+	return NumCompleted;
+}
+
+void UBallSimulatorComponent::SimulateBallPhysicsAsync(
+	const UObject* WorldContextObject,
+	const float BallMass,
+	const float BallRadius,
+	const FVector& InitialPosition,
+	const FQuat& InitialRotation,
+	const FVector& InitialDirection,
+	const float InitialSpeed,
+	const FVector& InitialSpinAxis,
+	const float InitialSpinSpeed,
+	const int32 SimulationSteps,
+	const float StepInterval)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UBallSimulatorComponent::SimulateBallPhysicsAsync);
+
+	UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	if (!World)
+	{
+		return;
+	}
+
+	UBallPredictionScene* PredictionScene = GetPredictionScene(World);
+	if (!PredictionScene)
+	{
+		SimulateBallPhysics(WorldContextObject, BallMass, BallRadius, InitialPosition, InitialRotation, InitialDirection,
+			InitialSpeed, InitialSpinAxis, InitialSpinSpeed, SimulationSteps, StepInterval);
+		OnSimulationComplete.Broadcast();
+		return;
+	}
+
+	TSharedRef<FBallSimulationJob> Job = MakeShared<FBallSimulationJob>();
+	PrepareSimulation(World, PredictionScene->GetPredictionWorld(),
+		FBallLaunchParams(InitialPosition, InitialRotation, InitialDirection, InitialSpeed, InitialSpinAxis, InitialSpinSpeed),
+		FBallSimSettings(BallMass, BallRadius, SimulationSteps, StepInterval),
+		*Job);
 
-		// 3) I⁻¹ * (r × n)
-		const FVector inertiaTerm = InvInertiaTensor * rCrossN;
+	const int32 Serial = ++SimulationSerial;
+	bSimulationPending = true;
 
-		// 4) (I⁻¹ * (r × n)) × r
-		const FVector crossTerm = FVector::CrossProduct(inertiaTerm, hitPointToCenter);
+	TWeakObjectPtr<UBallSimulatorComponent> WeakThis(this);
+	PredictionScene->EnqueueTask(
+		[Job](UWorld*) { Job->Run(); },
+		[WeakThis, Job, Serial]()
+		{
+			UBallSimulatorComponent* This = WeakThis.Get();
+			if (!This || This->SimulationSerial != Serial)
+			{
+				return;
+			}
 
-		// 5) 최종 분모 denom = m⁻¹+ [(I⁻¹ * (r × n)) × r]⋅n
-		const float denom = InvMass + FVector::DotProduct(crossTerm, hit.ImpactNormal);
+			This->bSimulationPending = false;
+			This->FinishSimulation(*Job);
+			This->OnSimulationComplete.Broadcast();
+		});
+}
 
-		// 6) Restitution : 0 = 완전 비탄성, 1 = 완전 탄성.
-		float impulseMagnitude = -(1.0f + Restitution) * vRel / denom;
+int32 UBallSimulatorComponent::SimulateBallPhysicsScheduled(
+	const UObject* WorldContextObject,
+	const float BallMass,
+	const float BallRadius,
+	const FVector& InitialPosition,
+	const FQuat& InitialRotation,
+	const FVector& InitialDirection,
+	const float InitialSpeed,
+	const FVector& InitialSpinAxis,
+	const float InitialSpinSpeed,
+	const int32 SimulationSteps,
+	const float StepInterval,
+	const int32 Priority,
+	const float MaxLatency)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UBallSimulatorComponent::SimulateBallPhysicsScheduled);
 
-		// (선택) 충격 임펄스 클램핑으로 과도한 임펄스 방지
-		impulseMagnitude = FMath::Clamp(impulseMagnitude, 0.f, MaxAllowedImpulse);
+	UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	UBallSimulationScheduler* Scheduler = World ? World->GetSubsystem<UBallSimulationScheduler>() : nullptr;
+	if (!Scheduler)
+	{
+		return INDEX_NONE;
+	}
 
-		// 임펄스 크기 impulseMagnitude (또는 법선 방향 상대 속도 vRel)가 충분히 크면 Bounce, 아니면 Sliding
-		if (impulseMagnitude <= BounceThreshold)
+	// 스케줄러는 게임 스레드에서 진행하므로 예측 씬 대신 게임 월드에서 Sweep
+	TSharedRef<FBallSimulationJob> Job = MakeShared<FBallSimulationJob>();
+	PrepareSimulation(World, World,
+		FBallLaunchParams(InitialPosition, InitialRotation, InitialDirection, InitialSpeed, InitialSpinAxis, InitialSpinSpeed),
+		FBallSimSettings(BallMass, BallRadius, SimulationSteps, StepInterval),
+		*Job);
+	Job->Begin();
+
+	const int32 Serial = ++SimulationSerial;
+	bSimulationPending = true;
+
+	FBallSimSchedulerRequest Request;
+	Request.Context = Job->Context;
+	Request.State = Job->State;
+	Request.Features = Job->Features;
+	Request.LastStep = SimulationSteps - 1;
+	Request.Priority = Priority;
+	Request.Deadline = MaxLatency > 0.f ? World->GetTimeSeconds() + MaxLatency : 0.0;
+	Request.CoalesceKey = FObjectKey(this);
+
+	TWeakObjectPtr<UBallSimulatorComponent> WeakThis(this);
+	Request.OnComplete = [WeakThis, Job, Serial](const FBallSimSchedulerRequest& Completed, EBallSimRequestStatus Status)
+	{
+		UBallSimulatorComponent* This = WeakThis.Get();
+		if (!This || This->SimulationSerial != Serial)
 		{
-			bIsSliding = true;
-			UE_LOG(LogBallSimulatorComponent, Verbose, TEXT("Sliding detected! impulseMagnitude:%f"), impulseMagnitude);
+			return;
 		}
 
-		// 7) 임펄스 벡터 (법선 방향으로 impulseMagnitude 곱)
-		const FVector normalImpulse = impulseMagnitude * hit.ImpactNormal;
-		HitCache.NormalImpulse = normalImpulse;
+		This->bSimulationPending = false;
+		if (Status != EBallSimRequestStatus::Completed)
+		{
+			return;
+		}
 
-		// 8) 선형 속도 업데이트  v = v + impulse * InvMass
-		HitCache.LinearImpulse = normalImpulse * InvMass;
-		linearVelocity += HitCache.LinearImpulse;
+		Job->State = Completed.State;
+		This->FinishSimulation(*Job);
+		This->OnSimulationComplete.Broadcast();
+	};
 
-		// CoulombFriction 쿠롱 마찰 임펄스 계산 (접선 방향 임펄스)
-		FVector angularDelta = FVector::ZeroVector;
-		float angularDeltaSize = 0.f;
-		const FVector tangentVelocity = ContactVelocity - vRel * hit.ImpactNormal;
-		float tangentSpeed = tangentVelocity.Size();
-		if (tangentSpeed > KINDA_SMALL_NUMBER)
-		{
-			FVector tangentDirection = tangentVelocity.GetSafeNormal();
+	return Scheduler->Submit(MoveTemp(Request));
+}
 
-			// 마찰 임펄스 최대값 (μ * 정반사 임펄스)
-			const float maxFrictionImpulse = impulseMagnitude * Friction;
+void UBallSimulatorComponent::PrepareSimulation(
+	UWorld* World,
+	UWorld* QueryWorld,
+	const FBallLaunchParams& Launch,
+	const FBallSimSettings& Settings,
+	FBallSimulationJob& OutJob)
+{
+	const float BallMass = Settings.Mass;
+	const float BallRadius = Settings.Radius;
+	const int32 SimulationSteps = Settings.SimulationSteps;
+	const float StepInterval = Settings.StepInterval;
+
+	// 튜닝 상수와 기능 조합은 시뮬레이션 시작 시 한번만 결정
+	FBallSimContext& Context = OutJob.Context;
+	EBallSimFeature Features = EBallSimFeature::All;
+	if (PhysicsProfile)
+	{
+		Context.Constants = PhysicsProfile->MakeConstants(StepInterval, BallMass, BallRadius);
+		Features = PhysicsProfile->GetFeatures();
+	}
+	else
+	{
+		// 컴포넌트 튜닝에는 공기역학 테이블이 없음
+		Context.Constants = MakeSimConstants(BallMass, BallRadius, StepInterval);
+		Features &= ~EBallSimFeature::Aerodynamics;
+	}
 
-			// 접선 임펄스 분모 (denom 재사용 가능)
-			float tangentImpulse = -FVector::DotProduct(ContactVelocity, tangentDirection) / denom;
+	if (bHandoffToPhysics)
+	{
+		Context.Constants.bStopOnRollingContact = true;
+		Context.Constants.MinSpeed = MinSpeed;
+		Context.Constants.MaxAllowedBounce = MaxAllowedBounce;
+	}
 
-			// 클램핑 - 최대 접선 임펄스값 이내로 
-			tangentImpulse = FMath::Clamp(tangentImpulse, -maxFrictionImpulse, maxFrictionImpulse);
-			
-			const FVector frictionImpulse = tangentImpulse * tangentDirection;
-			
-			//const FVector frictionImpulse = -tangentDirection * FMath::Clamp(tangentSpeed, 0.f, maxFrictionImpulse);
+	// 키네마틱 장애물 시간 윈도우 Broad-phase 구성
+	OutJob.Obstacles.Build(KinematicObstacles, BallRadius, ObstacleTimeWindow, SimulationSteps * StepInterval);
+	if (OutJob.Obstacles.IsEmpty())
+	{
+		Features &= ~EBallSimFeature::Obstacles;
+	}
 
-			HitCache.FrictionDelta = frictionImpulse * InvMass;
-			HitCache.FrictionImpulse = frictionImpulse;
+	OutJob.World = World;
+	OutJob.Features = Features;
+	OutJob.DistanceField = BallSimulatorComponent::GetDistanceField(World);
+	OutJob.MovableProxies = BallSimulatorComponent::GetMovableProxies(World);
+	OutJob.EventQuery = EventQuery;
+	OutJob.bUseCorridor = bUseCollisionCorridor;
+	OutJob.SimulationSteps = SimulationSteps;
+
+	Context.World = QueryWorld;
+	Context.CollisionShape = FCollisionShape::MakeSphere(BallRadius);
+	Context.QueryParams.bReturnPhysicalMaterial = EnumHasAnyFlags(Features, EBallSimFeature::PhysMaterial);
+	Context.WorldTime = World->GetTimeSeconds();
+	Context.Origin = Launch.Position;
+	Context.CheckpointInterval = FMath::Max(CheckpointInterval, 0);
+	Context.RotationKeyInterval = FMath::Max(RotationKeyInterval, 1);
+
+	// 발사 위치가 원점이므로 상태는 원점에서 시작
+	FBallSimState& State = OutJob.State;
+	State.Position = FVector3f::ZeroVector;
+	State.Rotation = FQuat4f(Launch.Rotation);
+	State.LinearVelocity = FVector3f(Launch.Direction * Launch.Speed);
+	State.AngularVelocity = FVector3f(Launch.SpinAxis.GetSafeNormal() * Launch.SpinSpeed);
+	State.PreviousHitTime = PreviousHitTime;
+	State.PreviousHitNormal = FVector3f(PreviousHitNormal);
+
+	FBallLogLaunch& LogLaunch = OutJob.Launch;
+	LogLaunch.Position[0] = Launch.Position.X;
+	LogLaunch.Position[1] = Launch.Position.Y;
+	LogLaunch.Position[2] = Launch.Position.Z;
+	LogLaunch.Rotation[0] = Launch.Rotation.X;
+	LogLaunch.Rotation[1] = Launch.Rotation.Y;
+	LogLaunch.Rotation[2] = Launch.Rotation.Z;
+	LogLaunch.Rotation[3] = Launch.Rotation.W;
+	LogLaunch.Direction[0] = Launch.Direction.X;
+	LogLaunch.Direction[1] = Launch.Direction.Y;
+	LogLaunch.Direction[2] = Launch.Direction.Z;
+	LogLaunch.Speed = Launch.Speed;
+	LogLaunch.SpinAxis[0] = Launch.SpinAxis.X;
+	LogLaunch.SpinAxis[1] = Launch.SpinAxis.Y;
+	LogLaunch.SpinAxis[2] = Launch.SpinAxis.Z;
+	LogLaunch.SpinSpeed = Launch.SpinSpeed;
+	LogLaunch.Mass = BallMass;
+	LogLaunch.Radius = BallRadius;
+	LogLaunch.SimulationSteps = SimulationSteps;
+	LogLaunch.StepInterval = StepInterval;
+}
 
-			// 선형 속도 업데이트 (마찰 임펄스 적용)
-			linearVelocity += frictionImpulse * InvMass;
+void UBallSimulatorComponent::FinishSimulation(FBallSimulationJob& Job)
+{
+	const FBallSimConstants& Constants = Job.Context.Constants;
+
+	DecimatedTimes.Reset();
+	DecimatedPositions.Reset();
+	TrajectorySampler.Reset();
+	ObstacleSet = MoveTemp(Job.Obstacles);
+	Checkpoints = MoveTemp(Job.Checkpoints);
+	CorridorRegatherCount = Job.Corridor.GetNumRegathers();
+	LastLaunch = Job.Launch;
+	SimulationWorldTime = Job.Context.WorldTime;
+	SimulationOrigin = Job.Context.Origin;
+
+	SimulationStepInterval = Constants.StepInterval;
+	InvInertiaTensor = FVector(Constants.InvInertiaTensor);
+
+	// 구체 관성 텐서 (표시용 내부 변수, 커널은 FBallSimConstants 사용)
+	float BaseInertia = 0.4f * Job.Launch.Mass * Job.Launch.Radius * Job.Launch.Radius;
+	ScaledInertia = FVector(BaseInertia) * InertiaTensorScale;
+
+	FinalState = Job.State;
+	HandoffReason = Job.State.HandoffReason;
+	BounceCount = Job.State.BounceCount;
+	PreviousHitTime = Job.State.PreviousHitTime;
+	PreviousHitNormal = FVector(Job.State.PreviousHitNormal);
+
+	// 결과는 새 불변 객체로 교체, 이전 결과를 보관 중인 소비자에는 영향 없음
+	Trajectory = BallSimulatorComponent::MakeTrajectory(Job);
+
+	// 시뮬레이션 종료 시간 저장 (Handoff 시 마지막 스냅샷 시간)
+	SimulationEndTime = Trajectory->EndTime;
+
+	// 경기 기록 중이면 발사 조건, 튜닝, 결과를 궤적 기록 파일에 추가
+	UWorld* World = Job.World.Get();
+	UBallTrajectoryRecorder* Recorder = World ? World->GetSubsystem<UBallTrajectoryRecorder>() : nullptr;
+	if (Recorder && Recorder->IsRecording())
+	{
+		Recorder->RecordShot(Job.Launch, Constants, Job.Features, SimulationOrigin, GetSnapshots(), GetBounces());
+	}
+}
 
-			// 마찰로 인한 각속도 변화량 Δω = I⁻¹ * (r × J)			
-			const FVector angularFrictionImpulse = FVector::CrossProduct(hitPointToCenter, frictionImpulse);
-			angularDelta = InvInertiaTensor * angularFrictionImpulse;
-			angularDeltaSize = angularDelta.Size();
-		}
+void UBallSimulatorComponent::SimulateBallPhysicsBatch(
+	const UObject* WorldContextObject,
+	const UBallPhysicsProfile* Profile,
+	const FVector& Origin,
+	TArrayView<FBallSimState> InOutStates,
+	const int32 SimulationSteps,
+	const float StepInterval,
+	TArray<TArray<FBallSimSnapshot>>* OutSnapshots)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UBallSimulatorComponent::SimulateBallPhysicsBatch);
 
-		// 각속도 업데이트 (시간 간격에 따라 회전 속도 감소) - 시뮬레이션 루프에서 처리함
-		// angularVelocity *= FMath::Pow(SpinFrictionScale, timeToHit);
-
-		HitCache.NextPos = hit.Location + linearVelocity * remainingTime;
-		HitCache.TimeToBeforeHit = timeToBeforeHit;
-		HitCache.RemainingTime = remainingTime;
-		HitCache.SnapshotIndex = CachedSnapshots.Num();
-		HitCache.BouncedDirection = linearVelocity.GetSafeNormal();
-		HitCache.BouncedSpeed = linearVelocity.Size();
-		HitCache.BouncedSpin = angularVelocity.Size();
-		HitCache.BouncedAngularVelocity = angularVelocity;
-		HitCache.PenetrationDepth = hit.PenetrationDepth;		
-		HitCache.bIsSliding = bIsSliding;
-		HitCache.AngularDelta = angularDelta;
-		HitCache.AngularDeltaSize = angularDeltaSize;
-		CachedHits.Add(HitCache);
-
-		//const float PenetrationVelocityDamping = 0.5f;    // 감속 계수		
-		const float PenetrationDepthThreshold = 0.1f;     // 끼인 것으로 판단할 최소 깊이
-
-		// trace started in penetration, i.e. with an initial blocking overlap.
-		const bool bIsStuck = hit.bStartPenetrating || hit.PenetrationDepth > PenetrationDepthThreshold;
-		HitCache.bWasStuck = bIsStuck;
-
-		if (bIsStuck)
-		{
-			// TBD - 재현 방법 및 동작 여부 확인 필요
-			HitCache.bWasStuck = bIsStuck;
+	UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	if (!World || !Profile)
+	{
+		return;
+	}
 
-			// 침투 깊이만큼 푸시백
-			const FVector PenetrationDirection = hit.Normal.IsNearlyZero() ? FVector::UpVector : hit.Normal;
-			const float PushBack = hit.PenetrationDepth + SmallMargin;
-			pos += PenetrationDirection * PushBack;
+	// 배치 경로는 컴포넌트에 종속되지 않으므로 장애물 검사 없음
+	const EBallSimFeature Features = Profile->GetFeatures() & ~EBallSimFeature::Obstacles;
+	const FBallSimKernel& Kernel = FBallSimKernel::Get(Features);
 
-			UE_LOG(LogBallSimulatorComponent, Verbose, TEXT("Penetration resolved: depth = %.3f, push = %s"), hit.PenetrationDepth, *PenetrationDirection.ToString());
+	FBallSimContext Context;
+	Context.World = World;
+	Context.Constants = Profile->MakeConstants(StepInterval);
+	Context.CollisionShape = FCollisionShape::MakeSphere(Context.Constants.Radius);
+	Context.QueryParams.bReturnPhysicalMaterial = EnumHasAnyFlags(Features, EBallSimFeature::PhysMaterial);
+	Context.WorldTime = World->GetTimeSeconds();
+	Context.Origin = Origin;
 
-			return Depth + 1;
-		}
+	const TSharedPtr<const FBallDistanceField, ESPMode::ThreadSafe> DistanceField = BallSimulatorComponent::GetDistanceField(World);
+	const TSharedPtr<const TArray<FBallMovableProxy>, ESPMode::ThreadSafe> MovableProxies = BallSimulatorComponent::GetMovableProxies(World);
+	Context.DistanceField = DistanceField.Get();
+	Context.MovableProxies = MovableProxies.Get();
 
-		if (bIsSliding)
-		{		
-			UE_LOG(LogBallSimulatorComponent, Verbose, TEXT("Sliding detected : MultiHit = %s, LVdotN = %.4f, PreviousHitNormal , PreviousHitTime = %.4f"),
-				(bMultiHit ? TEXT("True") : TEXT("False")), LVdotN, PreviousHitTime);
-			
-			// 슬라이딩 상태에서의 위치 업데이트
-			//FVector ProjectedNormal = hit.ImpactNormal * -LVdotN;
-			//float dot = FVector::DotProduct(linearVelocity, ProjectedNormal);
-			//FVector projectedVelocity = linearVelocity - dot * ProjectedNormal;
-			//pos = pos + projectedVelocity * remainingTime;
-			
-			// TBD - 프레임 레이트에 독립적인 Rolling Friction 적용 확인 필요
-			// 슬라이딩 중에도 Step당 1회는 충돌 처리 통한 임펄스 및 마찰 임펄스, 이동 속도, 각속도 업데이트 필요
-			// 잔여 시간 동안 이동 (슬라이딩 상태에서의 위치 업데이트)
-			pos = pos + linearVelocity * remainingTime;
-
-			// 슬라이딩 상태인 경우 바운스로 인한 각속도 감쇠 (BouncedSpinMultiplier) 적용 안함			
-			angularVelocity += angularDelta * SpinToRotateMultiply;
-
-			// 접촉 상태로 굴러가는 중이므로 SubStep 충돌 검사는 생략
-			// 이번 Step 에서의 첫번째 접촉으로 인한 임펄스는 반영, 추가적인 SubStep 충돌처리는 무시			
-			return Depth + 1;	// 슬라이드 판정 시점 현재의 SubStep을 Hit Count에 반영
-		}
-		else
-		{			
-			angularVelocity *= BouncedSpinMultiplier; // 바운스로 인한 각속도 추가 감쇠
-			angularVelocity += angularDelta * SpinToRotateMultiply;
+	// 모든 상태가 차례로 진행하므로 재질별 응답은 배치 전체에서 한번만 계산
+	FBallSurfaceCache SurfaceCache;
+	Context.SurfaceCache = &SurfaceCache;
+
+	if (OutSnapshots)
+	{
+		OutSnapshots->SetNum(InOutStates.Num());
+	}
+
+	for (int32 Index = 0; Index < InOutStates.Num(); ++Index)
+	{
+		FBallSimState& State = InOutStates[Index];
+		if (OutSnapshots)
+		{
+			TArray<FBallSimSnapshot>& Snapshots = (*OutSnapshots)[Index];
+			Snapshots.Reset(SimulationSteps);
+			Context.Snapshots = &Snapshots;
+			FBallSimKernel::RecordInitialSnapshot(Context, State);
 		}
 
-		return HandleCollision(World, InvMass, CollisionShape, pos, linearVelocity, angularVelocity, remainingTime, Depth + 1);
+		Kernel.Run(Context, State, State.StepIndex + SimulationSteps - 1);
 	}
-	else
+}
+
+int32 UBallSimulatorComponent::SimulateMultiBallPhysics(
+	const UObject* WorldContextObject,
+	const UBallPhysicsProfile* Profile,
+	const FVector& Origin,
+	TArrayView<FBallSimState> InOutStates,
+	const int32 SimulationSteps,
+	const float StepInterval,
+	TArray<TArray<FBallSimSnapshot>>* OutSnapshots)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UBallSimulatorComponent::SimulateMultiBallPhysics);
+
+	UWorld* World = WorldContextObject ? WorldContextObject->GetWorld() : nullptr;
+	if (!World || !Profile || InOutStates.Num() == 0)
+	{
+		return 0;
+	}
+
+	// 배치 경로와 같이 컴포넌트에 종속되지 않으므로 장애물 검사 없음
+	const EBallSimFeature Features = Profile->GetFeatures() & ~EBallSimFeature::Obstacles;
+
+	FBallSimContext Context;
+	Context.World = World;
+	Context.Constants = Profile->MakeConstants(StepInterval);
+	Context.CollisionShape = FCollisionShape::MakeSphere(Context.Constants.Radius);
+	Context.QueryParams.bReturnPhysicalMaterial = EnumHasAnyFlags(Features, EBallSimFeature::PhysMaterial);
+	Context.WorldTime = World->GetTimeSeconds();
+	Context.Origin = Origin;
+
+	const TSharedPtr<const FBallDistanceField, ESPMode::ThreadSafe> DistanceField = BallSimulatorComponent::GetDistanceField(World);
+	const TSharedPtr<const TArray<FBallMovableProxy>, ESPMode::ThreadSafe> MovableProxies = BallSimulatorComponent::GetMovableProxies(World);
+	Context.DistanceField = DistanceField.Get();
+	Context.MovableProxies = MovableProxies.Get();
+
+	FBallMultiSimulation Simulation;
+	Simulation.Initialize(Context, Features, InOutStates, OutSnapshots != nullptr);
+	Simulation.Run(InOutStates[0].StepIndex + SimulationSteps - 1);
+
+	for (int32 Index = 0; Index < InOutStates.Num(); ++Index)
+	{
+		InOutStates[Index] = Simulation.GetStates()[Index];
+	}
+	if (OutSnapshots)
+	{
+		*OutSnapshots = MoveTemp(Simulation.GetSnapshots());
+	}
+	return Simulation.GetNumBallContacts();
+}
+
+bool UBallSimulatorComponent::GetHandoffState(
+	float& OutTime,
+	FVector& OutPosition,
+	FQuat& OutRotation,
+	FVector& OutLinearVelocity,
+	FVector& OutAngularVelocity) const
+{
+	// 이벤트 정지 조건으로 끝난 경우는 강체 물리로 넘기지 않음
+	if (HandoffReason == EBallHandoffReason::None || HandoffReason == EBallHandoffReason::StopEvent)
 	{
-		pos = nextPos;
-		return Depth;
+		return false;
 	}
+
+	OutTime = FinalState.StepIndex * SimulationStepInterval;
+	OutPosition = SimulationOrigin + FVector(FinalState.Position);
+	OutRotation = FQuat(FinalState.Rotation);
+	OutLinearVelocity = FVector(FinalState.LinearVelocity);
+	OutAngularVelocity = FVector(FinalState.AngularVelocity);
+	return true;
+}
+
+bool UBallSimulatorComponent::FindFirstEvent(EBallSimEventType Type, int32 TriggerIndex, FBallSimEvent& OutEvent) const
+{
+	return UBallTrajectoryLibrary::FindFirstTrajectoryEvent(FBallTrajectoryHandle(Trajectory), Type, TriggerIndex, OutEvent);
+}
+
+FBallSimConstants UBallSimulatorComponent::MakeSimConstants(const float BallMass, const float BallRadius, const float StepInterval) const
+{
+	FBallSimConstants Constants;
+	Constants.Gravity = FVector3f(GravityVector);
+	Constants.StepInterval = StepInterval;
+	Constants.LinearDamping = LinearDamping;
+	Constants.AngularDamping = AngularDamping;
+	Constants.MinSpinForMagnus = MinSpinForMagnus;
+	Constants.SpinMagnusFactor = SpinMagnusFactor;
+	Constants.BouncedSpinMultiplier = BouncedSpinMultiplier;
+	Constants.SpinToRotateMultiply = SpinToRotateMultiply;
+	Constants.DefaultRestitution = DefaultRestitution;
+	Constants.DefaultFriction = DefaultFriction;
+	Constants.MaxAllowedImpulse = MaxAllowedImpulse;
+	Constants.BounceThreshold = BounceThreshold;
+	Constants.ContactSkin = ContactSkin;
+	Constants.ContactSolverIterations = ContactSolverIterations;
+	Constants.SetMassProperties(BallMass, BallRadius, InertiaTensorScale);
+	Constants.UpdateStepScales();
+	return Constants;
+}
+
+void UBallSimulatorComponent::ApplySpinToRotation(const FVector& InAngularDelta, FQuat& OutRotation) const
+{
+	FQuat4f Rotation(OutRotation);
+	FBallSimKernel::ApplySpinToRotation(FVector3f(InAngularDelta), 1.f, Rotation);
+	OutRotation = FQuat(Rotation);
+}
+
+FQuat UBallSimulatorComponent::GetBallRotationAtTime(float playbackTime) const
+{
+	return FBallSimKernel::ReconstructRotation(GetSnapshots(), GetRotationKeys(), SimulationStepInterval, playbackTime);
+}
+
+int UBallSimulatorComponent::HandleCollision(
+	UWorld* World,
+	const float InvMass,
+	const FCollisionShape& CollisionShape,
+	FVector& pos,
+	FVector& linearVelocity,
+	FVector& angularVelocity,
+	const float DeltaTime,
+	int32 Depth)
+{
+	// 단일 충돌 처리용 래퍼, 실제 처리는 범용 커널에서 수행
+	FBallSimContext Context;
+	Context.World = World;
+	Context.CollisionShape = CollisionShape;
+	Context.Constants = MakeSimConstants(1.f, CollisionShape.GetSphereRadius(), SimulationStepInterval);
+	Context.Constants.InvMass = InvMass;
+	Context.Constants.InvInertiaTensor = FVector3f(InvInertiaTensor);
+	Context.QueryParams.bReturnPhysicalMaterial = true;
+	Context.WorldTime = World->GetTimeSeconds();
+	Context.Obstacles = &ObstacleSet;
+	// 현재 위치를 원점으로 진행
+	Context.Origin = pos;
+	// 단일 충돌 결과는 궤적에 추가하지 않음 (궤적은 불변)
+	TArray<FBallSimBounce> Hits;
+	Context.Hits = &Hits;
+
+	FBallSimState State;
+	State.LinearVelocity = FVector3f(linearVelocity);
+	State.AngularVelocity = FVector3f(angularVelocity);
+	State.StepIndex = GetSnapshots().Num();
+	State.PreviousHitTime = PreviousHitTime;
+	State.PreviousHitNormal = FVector3f(PreviousHitNormal);
+
+	const int32 HitCount = FBallSimKernel::Get(EBallSimFeature::All & ~EBallSimFeature::Aerodynamics).HandleCollision(Context, State, DeltaTime, Depth);
+
+	pos = Context.ToWorld(State.Position);
+	linearVelocity = FVector(State.LinearVelocity);
+	angularVelocity = FVector(State.AngularVelocity);
+	PreviousHitTime = State.PreviousHitTime;
+	PreviousHitNormal = FVector(State.PreviousHitNormal);
+	return HitCount;
 }
 
 #if 0 
@@ -830,22 +1375,87 @@ void UBallSimulatorComponent::ConvertSnapshotsToBezierSpline(
 	SplineComponent->UpdateSpline();
 }
 
+void UBallSimulatorComponent::BuildDecimatedTrajectory(int32 DecimationStep)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UBallSimulatorComponent::BuildDecimatedTrajectory);
+
+	const FBallTrajectory& Data = GetTrajectoryOrEmpty();
+	const TArray<FBallSimSnapshot>& Snapshots = Data.Snapshots;
+
+	DecimatedTimes.Reset();
+	DecimatedPositions.Reset();
+
+	const int32 NumSnapshots = Snapshots.Num();
+	if (NumSnapshots == 0)
+	{
+		return;
+	}
+
+	DecimationStep = FMath::Max(DecimationStep, 1);
+	DecimatedTimes.Reserve(NumSnapshots / DecimationStep + GetBounces().Num() + 2);
+	DecimatedPositions.Reserve(NumSnapshots / DecimationStep + GetBounces().Num() + 2);
+
+	for (int32 i = 0; i < NumSnapshots; ++i)
+	{
+		// 충돌 스텝은 꺾이는 지점이므로 항상 유지
+		if (i % DecimationStep == 0 || i == NumSnapshots - 1 || Snapshots[i].hitCount > 0)
+		{
+			DecimatedTimes.Add(i * SimulationStepInterval);
+			DecimatedPositions.Add(Data.GetPosition(i));
+		}
+	}
+}
+
+FVector UBallSimulatorComponent::GetDecimatedPositionAtTime(float playbackTime) const
+{
+	const TArray<FBallSimSnapshot>& Snapshots = GetSnapshots();
+
+	if (DecimatedTimes.Num() == 0)
+	{
+		if (Snapshots.Num() == 0 || SimulationStepInterval <= 0.f)
+		{
+			return FVector::ZeroVector;
+		}
+
+		const float StepTime = FMath::Clamp(playbackTime / SimulationStepInterval, 0.f, (float)(Snapshots.Num() - 1));
+		const int32 IndexA = FMath::FloorToInt(StepTime);
+		const int32 IndexB = FMath::Min(IndexA + 1, Snapshots.Num() - 1);
+		return GetSimulationOrigin() + FVector(FMath::Lerp(Snapshots[IndexA].Position, Snapshots[IndexB].Position, StepTime - IndexA));
+	}
+
+	const int32 IndexB = Algo::UpperBound(DecimatedTimes, playbackTime);
+	if (IndexB == 0)
+	{
+		return DecimatedPositions[0];
+	}
+	if (IndexB >= DecimatedTimes.Num())
+	{
+		return DecimatedPositions.Last();
+	}
+
+	const int32 IndexA = IndexB - 1;
+	const float Alpha = (playbackTime - DecimatedTimes[IndexA]) / (DecimatedTimes[IndexB] - DecimatedTimes[IndexA]);
+	return FMath::Lerp(DecimatedPositions[IndexA], DecimatedPositions[IndexB], Alpha);
+}
+
 float UBallSimulatorComponent::GetBallSpeedAtTime(float playbackTime) const
 {
-	if (CachedSnapshots.Num() < 2 || SimulationStepInterval <= 0.f)
+	const TArray<FBallSimSnapshot>& Snapshots = GetSnapshots();
+
+	if (Snapshots.Num() < 2 || SimulationStepInterval <= 0.f)
 	{
 		return 0.f;
 	}
 
-	float TotalDuration = (CachedSnapshots.Num() - 1) * SimulationStepInterval;
+	float TotalDuration = (Snapshots.Num() - 1) * SimulationStepInterval;
 	float ClampedTime = FMath::Clamp(playbackTime, 0.f, TotalDuration);
 
-	int32 IndexA = FMath::Clamp(FMath::FloorToInt(ClampedTime / SimulationStepInterval), 0, CachedSnapshots.Num() - 2);
+	int32 IndexA = FMath::Clamp(FMath::FloorToInt(ClampedTime / SimulationStepInterval), 0, Snapshots.Num() - 2);
 	int32 IndexB = IndexA + 1;
 	float LocalAlpha = (ClampedTime - IndexA * SimulationStepInterval) / SimulationStepInterval;
 
-	float SpeedA = CachedSnapshots[IndexA].Speed;
-	float SpeedB = CachedSnapshots[IndexB].Speed;
+	float SpeedA = Snapshots[IndexA].Speed;
+	float SpeedB = Snapshots[IndexB].Speed;
 
 	return FMath::Lerp(SpeedA, SpeedB, LocalAlpha);
 }
@@ -854,43 +1464,97 @@ void UBallSimulatorComponent::GetBallVelocityAtTime(float playbackTime,
 	FVector& LinearVelocity,
 	FVector& AngularVelocity) const
 {
-	if (CachedSnapshots.Num() < 2 || SimulationStepInterval <= 0.f)
+	const TArray<FBallSimSnapshot>& Snapshots = GetSnapshots();
+
+	if (Snapshots.Num() < 2 || SimulationStepInterval <= 0.f)
 	{
 		LinearVelocity = FVector::ZeroVector;
 		AngularVelocity = FVector::ZeroVector;
 		return;
 	}
 
-	float TotalDuration = (CachedSnapshots.Num() - 1) * SimulationStepInterval;
+	float TotalDuration = (Snapshots.Num() - 1) * SimulationStepInterval;
 	float ClampedTime = FMath::Clamp(playbackTime, 0.f, TotalDuration);
 
-	int32 IndexA = FMath::Clamp(FMath::FloorToInt(ClampedTime / SimulationStepInterval), 0, CachedSnapshots.Num() - 2);
+	int32 IndexA = FMath::Clamp(FMath::FloorToInt(ClampedTime / SimulationStepInterval), 0, Snapshots.Num() - 2);
 	int32 IndexB = IndexA + 1;
 	float LocalAlpha = (ClampedTime - IndexA * SimulationStepInterval) / SimulationStepInterval;
 
 	// 방향 보간
-	FVector DirA = CachedSnapshots[IndexA].Direction;
-	FVector DirB = CachedSnapshots[IndexB].Direction;
-	FVector InterpDir = FMath::Lerp(DirA, DirB, LocalAlpha).GetSafeNormal();
+	FVector3f DirA = Snapshots[IndexA].Direction;
+	FVector3f DirB = Snapshots[IndexB].Direction;
+	FVector3f InterpDir = FMath::Lerp(DirA, DirB, LocalAlpha).GetSafeNormal();
 
 	// 속도(스칼라) 보간
-	float SpeedA = CachedSnapshots[IndexA].Speed;
-	float SpeedB = CachedSnapshots[IndexB].Speed;
+	float SpeedA = Snapshots[IndexA].Speed;
+	float SpeedB = Snapshots[IndexB].Speed;
 	float InterpSpeed = FMath::Lerp(SpeedA, SpeedB, LocalAlpha);
 
 	// 실제 velocity = 방향 * 속도
-	LinearVelocity = InterpDir * InterpSpeed;
+	LinearVelocity = FVector(InterpDir * InterpSpeed);
 	
 	// TBD - 충돌 후 회전 변화가 큰 경우를 고려해야 함
-	const FVector SpinAxisA = CachedSnapshots[IndexA].SpinAxis;
-	const float SpinSpeedA = CachedSnapshots[IndexA].SpinSpeed;
-	const FVector AngularVelocityA = SpinAxisA * SpinSpeedA;
-	const FVector SpinAxisB = CachedSnapshots[IndexB].SpinAxis;
-	const float SpinSpeedB = CachedSnapshots[IndexB].SpinSpeed;
-	const FVector AngularVelocityB = SpinAxisB * SpinSpeedB;
+	const FVector3f SpinAxisA = Snapshots[IndexA].SpinAxis;
+	const float SpinSpeedA = Snapshots[IndexA].SpinSpeed;
+	const FVector3f AngularVelocityA = SpinAxisA * SpinSpeedA;
+	const FVector3f SpinAxisB = Snapshots[IndexB].SpinAxis;
+	const float SpinSpeedB = Snapshots[IndexB].SpinSpeed;
+	const FVector3f AngularVelocityB = SpinAxisB * SpinSpeedB;
 
 	// 스핀 보간
-	AngularVelocity = FMath::Lerp(AngularVelocityA, AngularVelocityB, LocalAlpha);
+	AngularVelocity = FVector(FMath::Lerp(AngularVelocityA, AngularVelocityB, LocalAlpha));
+}
+
+void UBallSimulatorComponent::SampleTrajectory(
+	const FBallSampleTimes& Times,
+	TArrayView<FVector> OutPositions,
+	TArrayView<FVector> OutLinearVelocities,
+	TArrayView<FVector> OutAngularVelocities,
+	TArrayView<FQuat> OutRotations) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UBallSimulatorComponent::SampleTrajectory);
+
+	if (!TrajectorySampler.IsBuiltFor(GetSnapshots().Num(), SimulationStepInterval))
+	{
+		TrajectorySampler.Build(GetSnapshots(), GetSimulationOrigin(), SimulationStepInterval);
+	}
+
+	TrajectorySampler.Sample(Times, OutPositions, OutLinearVelocities, OutAngularVelocities);
+	if (OutRotations.Num() > 0)
+	{
+		TrajectorySampler.SampleRotations(Times, GetSnapshots(), GetRotationKeys(), OutRotations);
+	}
+}
+
+void UBallSimulatorComponent::SampleTrajectoryAtTimes(
+	const TArray<float>& Times,
+	bool bWithRotations,
+	TArray<FVector>& OutPositions,
+	TArray<FVector>& OutLinearVelocities,
+	TArray<FQuat>& OutRotations) const
+{
+	OutPositions.SetNumUninitialized(Times.Num());
+	OutLinearVelocities.SetNumUninitialized(Times.Num());
+	OutRotations.SetNumUninitialized(bWithRotations ? Times.Num() : 0);
+
+	SampleTrajectory(FBallSampleTimes(Times), OutPositions, OutLinearVelocities, TArrayView<FVector>(), OutRotations);
+}
+
+void UBallSimulatorComponent::SampleTrajectoryUniform(
+	float StartTime,
+	float DeltaTime,
+	int32 Count,
+	bool bWithRotations,
+	TArray<FVector>& OutPositions,
+	TArray<FVector>& OutLinearVelocities,
+	TArray<FQuat>& OutRotations) const
+{
+	const FBallSampleTimes Times(StartTime, DeltaTime, Count);
+	OutPositions.SetNumUninitialized(Times.Count);
+	OutLinearVelocities.SetNumUninitialized(Times.Count);
+	OutRotations.SetNumUninitialized(bWithRotations ? Times.Count : 0);
+
+	SampleTrajectory(Times, OutPositions, OutLinearVelocities, TArrayView<FVector>(), OutRotations);
 }
 
 bool UBallSimulatorComponent::GetBallPositionAndRotationAtSplineTime(
@@ -902,7 +1566,7 @@ bool UBallSimulatorComponent::GetBallPositionAndRotationAtSplineTime(
 	OutPosition = FVector::ZeroVector;
 	OutRotation = FQuat::Identity;
 
-	if (!SplineComponent || CachedSnapshots.Num() < 2 || SimulationStepInterval <= 0.f)
+	if (!SplineComponent || GetSnapshots().Num() < 2 || SimulationStepInterval <= 0.f)
 	{
 		return false;
 	}
@@ -916,15 +1580,8 @@ bool UBallSimulatorComponent::GetBallPositionAndRotationAtSplineTime(
 	float DistanceOnSpline = SplineLength * Alpha;
 	OutPosition = SplineComponent->GetLocationAtDistanceAlongSpline(DistanceOnSpline, ESplineCoordinateSpace::World);
 
-	// 회전 보간 계산: Snapshot 기반
-	int32 IndexA = FMath::Clamp(FMath::FloorToInt(ClampedTime / SimulationStepInterval), 0, CachedSnapshots.Num() - 2);
-	int32 IndexB = IndexA + 1;
-	float LocalAlpha = (ClampedTime - IndexA * SimulationStepInterval) / SimulationStepInterval;
-
-	const FQuat& RotA = CachedSnapshots[IndexA].Rotation;
-	const FQuat& RotB = CachedSnapshots[IndexB].Rotation;
-
-	OutRotation = FQuat::Slerp(RotA, RotB, LocalAlpha).GetNormalized();
+	// 회전 계산: 키프레임과 각속도로 복원
+	OutRotation = GetBallRotationAtTime(ClampedTime);
 
 	return true;
 }
@@ -935,16 +1592,18 @@ void UBallSimulatorComponent::GetBallPositionAndRotationAtTime(
 	FRotator& OutRotation,
 	int32& OutIndexA, int32& OutIndexB) const
 {
-	if (CachedSnapshots.Num() < 2 || SimulationStepInterval <= 0.f)
+	const TArray<FBallSimSnapshot>& Snapshots = GetSnapshots();
+
+	if (Snapshots.Num() < 2 || SimulationStepInterval <= 0.f)
 	{
 		OutPosition = FVector::ZeroVector;
 		OutRotation = FRotator::ZeroRotator;
 		return;
 	}
 
-	float TotalDuration = (CachedSnapshots.Num() - 1) * SimulationStepInterval;
+	float TotalDuration = (Snapshots.Num() - 1) * SimulationStepInterval;
 	float ClampedTime = FMath::Clamp(playbackTime, 0.f, TotalDuration);
-	int32 IndexA = FMath::Clamp(FMath::FloorToInt(ClampedTime / SimulationStepInterval), 0, CachedSnapshots.Num() - 2);
+	int32 IndexA = FMath::Clamp(FMath::FloorToInt(ClampedTime / SimulationStepInterval), 0, Snapshots.Num() - 2);
 	int32 IndexB = IndexA + 1;
 	float LocalAlpha = (ClampedTime - IndexA * SimulationStepInterval) / SimulationStepInterval;
 
@@ -952,12 +1611,10 @@ void UBallSimulatorComponent::GetBallPositionAndRotationAtTime(
 	OutIndexB = IndexB;
 
 	// 위치 보간
-	FVector PosA = CachedSnapshots[IndexA].Position;
-	FVector PosB = CachedSnapshots[IndexB].Position;
-	OutPosition = FMath::Lerp(PosA, PosB, LocalAlpha);
-
-	// 회전 보간 (Quaternion 사용)
-	const FQuat& RotA = CachedSnapshots[IndexA].Rotation;
-	const FQuat& RotB = CachedSnapshots[IndexB].Rotation;
-	OutRotation = FQuat::Slerp(RotA, RotB, LocalAlpha).Rotator();
+	const FVector3f& PosA = Snapshots[IndexA].Position;
+	const FVector3f& PosB = Snapshots[IndexB].Position;
+	OutPosition = GetSimulationOrigin() + FVector(FMath::Lerp(PosA, PosB, LocalAlpha));
+
+	// 회전은 키프레임과 각속도로 복원
+	OutRotation = GetBallRotationAtTime(ClampedTime).Rotator();
 }
\ No newline at end of file
@@ -0,0 +1,63 @@
+﻿// © 2025 UnrealStudy. All rights reserved.
+// Author: taru00@gmail.com | https://x.com/3devnote
+
+#include "BallTrajectoryLibrary.h"
+
+bool UBallTrajectoryLibrary::GetTrajectorySnapshot(const FBallTrajectoryHandle& Trajectory, int32 Index, FBallSnapshot& OutSnapshot)
+{
+	const FBallTrajectory& Data = Trajectory.Get();
+	if (!Data.Snapshots.IsValidIndex(Index))
+	{
+		return false;
+	}
+
+	OutSnapshot = Data.Snapshots[Index].ToSnapshot(Data.Origin);
+	return true;
+}
+
+FVector UBallTrajectoryLibrary::GetTrajectoryFinalPosition(const FBallTrajectoryHandle& Trajectory)
+{
+	const FBallTrajectory& Data = Trajectory.Get();
+	return Data.Snapshots.Num() > 0 ? Data.GetPosition(Data.Snapshots.Num() - 1) : FVector::ZeroVector;
+}
+
+FVector UBallTrajectoryLibrary::GetTrajectoryPositionAtTime(const FBallTrajectoryHandle& Trajectory, float Time)
+{
+	const FBallTrajectory& Data = Trajectory.Get();
+	const TArray<FBallSimSnapshot>& Snapshots = Data.Snapshots;
+	if (Snapshots.Num() == 0)
+	{
+		return FVector::ZeroVector;
+	}
+	if (Snapshots.Num() == 1 || Data.StepInterval <= 0.f)
+	{
+		return Data.GetPosition(0);
+	}
+
+	// 스텝 간격이 고정이므로 탐색 없이 구간 계산
+	const float StepTime = FMath::Clamp(Time / Data.StepInterval, 0.f, (float)(Snapshots.Num() - 1));
+	const int32 Index = FMath::Min(FMath::FloorToInt(StepTime), Snapshots.Num() - 2);
+	return Data.Origin + FVector(FMath::Lerp(Snapshots[Index].Position, Snapshots[Index + 1].Position, StepTime - Index));
+}
+
+TArray<FBallSnapshot> UBallTrajectoryLibrary::CopyTrajectorySnapshots(const FBallTrajectoryHandle& Trajectory)
+{
+	const FBallTrajectory& Data = Trajectory.Get();
+	return FBallSimSnapshot::ToSnapshots(Data.Snapshots, Data.Origin);
+}
+
+bool UBallTrajectoryLibrary::FindFirstTrajectoryEvent(const FBallTrajectoryHandle& Trajectory, EBallSimEventType Type, int32 TriggerIndex, FBallSimEvent& OutEvent)
+{
+	const FBallSimEvent* Event = Trajectory.Get().Events.FindByPredicate([Type, TriggerIndex](const FBallSimEvent& Candidate)
+	{
+		return Candidate.Type == Type && (TriggerIndex == INDEX_NONE || Candidate.TriggerIndex == TriggerIndex);
+	});
+
+	if (!Event)
+	{
+		return false;
+	}
+
+	OutEvent = *Event;
+	return true;
+}
@@ -0,0 +1,420 @@
+﻿// © 2025 UnrealStudy. All rights reserved.
+// Author: taru00@gmail.com | https://x.com/3devnote
+
+#include "BallTrajectoryLog.h"
+#include "HAL/PlatformFileManager.h"
+#include "HAL/RunnableThread.h"
+#include "HAL/Event.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/Paths.h"
+
+DECLARE_LOG_CATEGORY_EXTERN(LogBallTrajectoryLog, Log, All);
+DEFINE_LOG_CATEGORY(LogBallTrajectoryLog);
+
+namespace BallTrajectoryLog
+{
+	template<typename T, typename VectorType>
+	static void Store(T* Dest, const VectorType& Vector)
+	{
+		Dest[0] = (T)Vector.X;
+		Dest[1] = (T)Vector.Y;
+		Dest[2] = (T)Vector.Z;
+	}
+
+	template<typename QuatType>
+	static void StoreQuat(float* Dest, const QuatType& Quat)
+	{
+		Dest[0] = (float)Quat.X;
+		Dest[1] = (float)Quat.Y;
+		Dest[2] = (float)Quat.Z;
+		Dest[3] = (float)Quat.W;
+	}
+
+	static FVector LoadVector(const double* Src)
+	{
+		return FVector(Src[0], Src[1], Src[2]);
+	}
+
+	static FQuat LoadQuat(const float* Src)
+	{
+		return FQuat(Src[0], Src[1], Src[2], Src[3]);
+	}
+
+	static void MakeTuning(const FBallSimConstants& Constants, EBallSimFeature Features, FBallLogTuning& Out)
+	{
+		Store(Out.Gravity, Constants.Gravity);
+		Out.LinearDamping = Constants.LinearDamping;
+		Out.AngularDamping = Constants.AngularDamping;
+		Out.MinSpinForMagnus = Constants.MinSpinForMagnus;
+		Out.SpinMagnusFactor = Constants.SpinMagnusFactor;
+		Out.BouncedSpinMultiplier = Constants.BouncedSpinMultiplier;
+		Out.SpinToRotateMultiply = Constants.SpinToRotateMultiply;
+		Out.DefaultRestitution = Constants.DefaultRestitution;
+		Out.DefaultFriction = Constants.DefaultFriction;
+		Out.MaxAllowedImpulse = Constants.MaxAllowedImpulse;
+		Out.BounceThreshold = Constants.BounceThreshold;
+		Out.Features = (uint32)Features;
+	}
+
+	static void MakeSnapshot(const FBallSimSnapshot& Snapshot, const FVector& Origin, const FQuat4f& Rotation, FBallLogSnapshot& Out)
+	{
+		Store(Out.Position, Snapshot.GetWorldPosition(Origin));
+		StoreQuat(Out.Rotation, Rotation);
+		Store(Out.Direction, Snapshot.Direction);
+		Store(Out.SpinAxis, Snapshot.SpinAxis);
+		Out.Time = Snapshot.Time;
+		Out.Speed = Snapshot.Speed;
+		Out.SpinSpeed = Snapshot.SpinSpeed;
+		Out.hitCount = Snapshot.hitCount;
+		Out.BounceIndex = Snapshot.BounceIndex;
+		Out.Reserved = 0;
+	}
+
+	static void MakeBounce(const FBallSimBounce& Bounce, const FVector& Origin, FBallLogBounce& Out)
+	{
+		Store(Out.ImpactPoint, Bounce.GetWorldImpactPoint(Origin));
+		Out.SnapshotIndex = Bounce.SnapshotIndex;
+		Out.Speed = Bounce.Speed;
+		Out.Spin = Bounce.Spin;
+		Out.BouncedSpeed = Bounce.BouncedSpeed;
+		Out.BouncedSpin = Bounce.BouncedSpin;
+		Out.vRel = Bounce.vRel;
+		Out.PenetrationDepth = Bounce.PenetrationDepth;
+		Out.TimeToBeforeHit = Bounce.TimeToBeforeHit;
+		Out.Flags = (Bounce.bWasStuck ? 1u : 0u) | (Bounce.bIsSliding ? 2u : 0u) | ((uint32)Bounce.SurfaceType.GetValue() << 8);
+		Store(Out.ImpactNormal, Bounce.ImpactNormal);
+		Store(Out.Direction, Bounce.Direction);
+		Store(Out.BouncedDirection, Bounce.BouncedDirection);
+		Store(Out.AngularVelocity, Bounce.AngularVelocity);
+		Store(Out.BouncedAngularVelocity, Bounce.BouncedAngularVelocity);
+		Store(Out.NormalImpulse, Bounce.NormalImpulse);
+		Store(Out.FrictionImpulse, Bounce.FrictionImpulse);
+	}
+}
+
+FBallTrajectoryLogWriter::FBallTrajectoryLogWriter()
+	: bStopRequested(false)
+{
+}
+
+FBallTrajectoryLogWriter::~FBallTrajectoryLogWriter()
+{
+	Close();
+}
+
+bool FBallTrajectoryLogWriter::Open(const FString& InFilePath)
+{
+	Close();
+
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	PlatformFile.CreateDirectoryTree(*FPaths::GetPath(InFilePath));
+
+	FileHandle.Reset(PlatformFile.OpenWrite(*InFilePath));
+	if (!FileHandle)
+	{
+		UE_LOG(LogBallTrajectoryLog, Warning, TEXT("Failed to open trajectory log : %s"), *InFilePath);
+		return false;
+	}
+
+	FilePath = InFilePath;
+	ChunkOffsets.Reset();
+	NextShotIndex = 0;
+
+	FBallLogFileHeader Header;
+	Header.SnapshotSize = sizeof(FBallLogSnapshot);
+	Header.BounceSize = sizeof(FBallLogBounce);
+	FileHandle->Write(reinterpret_cast<const uint8*>(&Header), sizeof(Header));
+
+	bStopRequested = false;
+	WakeEvent = FPlatformProcess::GetSynchEventFromPool(false);
+	Thread = FRunnableThread::Create(this, TEXT("BallTrajectoryLogWriter"), 0, TPri_BelowNormal);
+	return Thread != nullptr;
+}
+
+void FBallTrajectoryLogWriter::Close()
+{
+	if (!Thread)
+	{
+		return;
+	}
+
+	Stop();
+	Thread->WaitForCompletion();
+	delete Thread;
+	Thread = nullptr;
+
+	FPlatformProcess::ReturnSynchEventToPool(WakeEvent);
+	WakeEvent = nullptr;
+
+	// 종료 직전에 들어온 청크까지 기록 후 인덱스 작성
+	WritePendingChunks();
+
+	FBallLogIndexHeader IndexHeader;
+	IndexHeader.NumShots = ChunkOffsets.Num();
+
+	FBallLogFooter Footer;
+	Footer.IndexOffset = FileHandle->Tell();
+
+	FileHandle->Write(reinterpret_cast<const uint8*>(&IndexHeader), sizeof(IndexHeader));
+	FileHandle->Write(reinterpret_cast<const uint8*>(ChunkOffsets.GetData()), ChunkOffsets.Num() * sizeof(uint64));
+	FileHandle->Write(reinterpret_cast<const uint8*>(&Footer), sizeof(Footer));
+	FileHandle->Flush();
+	FileHandle.Reset();
+
+	UE_LOG(LogBallTrajectoryLog, Log, TEXT("Trajectory log closed : %s (%d shots)"), *FilePath, ChunkOffsets.Num());
+}
+
+int32 FBallTrajectoryLogWriter::AppendShot(
+	double MatchTime,
+	const FBallLogLaunch& Launch,
+	const FBallSimConstants& Constants,
+	EBallSimFeature Features,
+	const FVector& Origin,
+	TArrayView<const FBallSimSnapshot> Snapshots,
+	TArrayView<const FBallSimBounce> Bounces)
+{
+	if (!IsOpen())
+	{
+		return INDEX_NONE;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(FBallTrajectoryLogWriter::AppendShot);
+
+	const uint64 ChunkSize = sizeof(FBallLogShotHeader) + Snapshots.Num() * sizeof(FBallLogSnapshot) + Bounces.Num() * sizeof(FBallLogBounce);
+
+	// 호출 스레드에서 POD 청크로 변환만 하고 파일 기록은 백그라운드 스레드에서 처리
+	TArray<uint8> Chunk;
+	Chunk.SetNumUninitialized(ChunkSize);
+
+	FBallLogShotHeader* Header = reinterpret_cast<FBallLogShotHeader*>(Chunk.GetData());
+	Header->Magic = BallTrajectoryLog::ShotMagic;
+	Header->ShotIndex = NextShotIndex;
+	Header->NumSnapshots = Snapshots.Num();
+	Header->NumBounces = Bounces.Num();
+	Header->ChunkSize = ChunkSize;
+	Header->MatchTime = MatchTime;
+	Header->Launch = Launch;
+	BallTrajectoryLog::MakeTuning(Constants, Features, Header->Tuning);
+
+	// 스냅샷에는 회전이 없으므로 발사 회전부터 각속도로 적분해서 기록 (재생 시 복원과 같은 방식)
+	FQuat4f Rotation(BallTrajectoryLog::LoadQuat(Launch.Rotation));
+	FBallLogSnapshot* SnapshotData = reinterpret_cast<FBallLogSnapshot*>(Header + 1);
+	for (int32 i = 0; i < Snapshots.Num(); ++i)
+	{
+		if (i > 0)
+		{
+			FBallSimKernel::ApplySpinToRotation(Snapshots[i].SpinAxis * Snapshots[i].SpinSpeed, Launch.StepInterval, Rotation);
+		}
+		BallTrajectoryLog::MakeSnapshot(Snapshots[i], Origin, Rotation, SnapshotData[i]);
+	}
+
+	FBallLogBounce* BounceData = reinterpret_cast<FBallLogBounce*>(SnapshotData + Snapshots.Num());
+	for (int32 i = 0; i < Bounces.Num(); ++i)
+	{
+		BallTrajectoryLog::MakeBounce(Bounces[i], Origin, BounceData[i]);
+	}
+
+	PendingChunks.Enqueue(MoveTemp(Chunk));
+	WakeEvent->Trigger();
+
+	return NextShotIndex++;
+}
+
+uint32 FBallTrajectoryLogWriter::Run()
+{
+	while (!bStopRequested)
+	{
+		WakeEvent->Wait(100);
+		WritePendingChunks();
+	}
+	return 0;
+}
+
+void FBallTrajectoryLogWriter::Stop()
+{
+	bStopRequested = true;
+	if (WakeEvent)
+	{
+		WakeEvent->Trigger();
+	}
+}
+
+void FBallTrajectoryLogWriter::WritePendingChunks()
+{
+	TArray<uint8> Chunk;
+	while (PendingChunks.Dequeue(Chunk))
+	{
+		ChunkOffsets.Add(FileHandle->Tell());
+		FileHandle->Write(Chunk.GetData(), Chunk.Num());
+	}
+}
+
+FBallTrajectoryLogReader::FBallTrajectoryLogReader() = default;
+
+FBallTrajectoryLogReader::~FBallTrajectoryLogReader()
+{
+	Close();
+}
+
+bool FBallTrajectoryLogReader::Open(const FString& InFilePath)
+{
+	Close();
+
+	MappedHandle.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*InFilePath));
+	if (!MappedHandle || MappedHandle->GetFileSize() < (int64)sizeof(FBallLogFileHeader))
+	{
+		UE_LOG(LogBallTrajectoryLog, Warning, TEXT("Failed to map trajectory log : %s"), *InFilePath);
+		Close();
+		return false;
+	}
+
+	MappedRegion.Reset(MappedHandle->MapRegion(0, MappedHandle->GetFileSize()));
+	if (!MappedRegion)
+	{
+		Close();
+		return false;
+	}
+
+	Data = MappedRegion->GetMappedPtr();
+	DataSize = MappedRegion->GetMappedSize();
+
+	const FBallLogFileHeader* Header = reinterpret_cast<const FBallLogFileHeader*>(Data);
+	if (Header->Magic != BallTrajectoryLog::FileMagic || Header->Version != BallTrajectoryLog::Version
+		|| Header->SnapshotSize != sizeof(FBallLogSnapshot) || Header->BounceSize != sizeof(FBallLogBounce))
+	{
+		UE_LOG(LogBallTrajectoryLog, Warning, TEXT("Unsupported trajectory log format : %s"), *InFilePath);
+		Close();
+		return false;
+	}
+
+	if (!ReadIndexFromFooter())
+	{
+		UE_LOG(LogBallTrajectoryLog, Log, TEXT("Trajectory log has no index, rebuilding by scan : %s"), *InFilePath);
+		RebuildIndexByScan();
+	}
+	return true;
+}
+
+void FBallTrajectoryLogReader::Close()
+{
+	ChunkOffsets.Reset();
+	Data = nullptr;
+	DataSize = 0;
+	MappedRegion.Reset();
+	MappedHandle.Reset();
+}
+
+bool FBallTrajectoryLogReader::ReadIndexFromFooter()
+{
+	if (DataSize < (int64)(sizeof(FBallLogFileHeader) + sizeof(FBallLogFooter)))
+	{
+		return false;
+	}
+
+	const FBallLogFooter* Footer = reinterpret_cast<const FBallLogFooter*>(Data + DataSize - sizeof(FBallLogFooter));
+	if (Footer->Magic != BallTrajectoryLog::FooterMagic || Footer->IndexOffset < sizeof(FBallLogFileHeader)
+		|| Footer->IndexOffset > (uint64)DataSize - sizeof(FBallLogIndexHeader))
+	{
+		return false;
+	}
+
+	const FBallLogIndexHeader* IndexHeader = reinterpret_cast<const FBallLogIndexHeader*>(Data + Footer->IndexOffset);
+	const uint64 IndexEnd = Footer->IndexOffset + sizeof(FBallLogIndexHeader) + IndexHeader->NumShots * sizeof(uint64);
+	if (IndexHeader->Magic != BallTrajectoryLog::IndexMagic || IndexEnd > (uint64)DataSize)
+	{
+		return false;
+	}
+
+	// 인덱스 항목 하나라도 잘못되면 인덱스 전체를 버리고 스캔으로 다시 구성
+	const uint64* Offsets = reinterpret_cast<const uint64*>(IndexHeader + 1);
+	for (uint32 i = 0; i < IndexHeader->NumShots; ++i)
+	{
+		if (!IsValidChunk(Offsets[i]))
+		{
+			return false;
+		}
+	}
+
+	ChunkOffsets.Append(Offsets, IndexHeader->NumShots);
+	return true;
+}
+
+void FBallTrajectoryLogReader::RebuildIndexByScan()
+{
+	// 잘못된 청크 (기록 중 종료된 마지막 청크 등) 에서 멈춤, 검사한 ChunkSize 는 0 이 아니므로 항상 진행
+	uint64 Offset = sizeof(FBallLogFileHeader);
+	while (IsValidChunk(Offset))
+	{
+		ChunkOffsets.Add(Offset);
+		Offset += reinterpret_cast<const FBallLogShotHeader*>(Data + Offset)->ChunkSize;
+	}
+}
+
+bool FBallTrajectoryLogReader::IsValidChunk(uint64 Offset) const
+{
+	const uint64 Size = (uint64)DataSize;
+	if (Offset < sizeof(FBallLogFileHeader) || Offset > Size || Size - Offset < sizeof(FBallLogShotHeader))
+	{
+		return false;
+	}
+
+	const FBallLogShotHeader* Shot = reinterpret_cast<const FBallLogShotHeader*>(Data + Offset);
+	const uint64 ExpectedSize = sizeof(FBallLogShotHeader) + (uint64)Shot->NumSnapshots * sizeof(FBallLogSnapshot) + (uint64)Shot->NumBounces * sizeof(FBallLogBounce);
+	return Shot->Magic == BallTrajectoryLog::ShotMagic
+		&& Shot->ChunkSize == ExpectedSize
+		&& Shot->ChunkSize <= Size - Offset
+		&& Shot->NumSnapshots <= (uint32)MAX_int32 && Shot->NumBounces <= (uint32)MAX_int32;
+}
+
+const FBallLogShotHeader* FBallTrajectoryLogReader::GetShot(int32 ShotIndex) const
+{
+	if (!ChunkOffsets.IsValidIndex(ShotIndex))
+	{
+		return nullptr;
+	}
+	return reinterpret_cast<const FBallLogShotHeader*>(Data + ChunkOffsets[ShotIndex]);
+}
+
+TArrayView<const FBallLogSnapshot> FBallTrajectoryLogReader::GetSnapshots(int32 ShotIndex) const
+{
+	const FBallLogShotHeader* Shot = GetShot(ShotIndex);
+	if (!Shot)
+	{
+		return TArrayView<const FBallLogSnapshot>();
+	}
+	return TArrayView<const FBallLogSnapshot>(reinterpret_cast<const FBallLogSnapshot*>(Shot + 1), Shot->NumSnapshots);
+}
+
+TArrayView<const FBallLogBounce> FBallTrajectoryLogReader::GetBounces(int32 ShotIndex) const
+{
+	const FBallLogShotHeader* Shot = GetShot(ShotIndex);
+	if (!Shot)
+	{
+		return TArrayView<const FBallLogBounce>();
+	}
+	const FBallLogSnapshot* Snapshots = reinterpret_cast<const FBallLogSnapshot*>(Shot + 1);
+	return TArrayView<const FBallLogBounce>(reinterpret_cast<const FBallLogBounce*>(Snapshots + Shot->NumSnapshots), Shot->NumBounces);
+}
+
+bool FBallTrajectoryLogReader::SampleShot(int32 ShotIndex, float Time, FVector& OutPosition, FQuat& OutRotation) const
+{
+	const FBallLogShotHeader* Shot = GetShot(ShotIndex);
+	if (!Shot || Shot->NumSnapshots < 2 || Shot->Launch.StepInterval <= 0.f)
+	{
+		return false;
+	}
+
+	// 고정 스텝이므로 시간 → 인덱스는 나눗셈 한번
+	const TArrayView<const FBallLogSnapshot> Snapshots = GetSnapshots(ShotIndex);
+	const float StepInterval = Shot->Launch.StepInterval;
+	const float TotalDuration = (Snapshots.Num() - 1) * StepInterval;
+	const float ClampedTime = FMath::Clamp(Time, 0.f, TotalDuration);
+	const int32 IndexA = FMath::Clamp(FMath::FloorToInt(ClampedTime / StepInterval), 0, Snapshots.Num() - 2);
+	const float Alpha = (ClampedTime - IndexA * StepInterval) / StepInterval;
+
+	const FBallLogSnapshot& A = Snapshots[IndexA];
+	const FBallLogSnapshot& B = Snapshots[IndexA + 1];
+	OutPosition = FMath::Lerp(BallTrajectoryLog::LoadVector(A.Position), BallTrajectoryLog::LoadVector(B.Position), Alpha);
+	OutRotation = FQuat::Slerp(BallTrajectoryLog::LoadQuat(A.Rotation), BallTrajectoryLog::LoadQuat(B.Rotation), Alpha).GetNormalized();
+	return true;
+}
@@ -0,0 +1,56 @@
+﻿// © 2025 UnrealStudy. All rights reserved.
+// Author: taru00@gmail.com | https://x.com/3devnote
+
+#include "BallTrajectoryRecorder.h"
+#include "Engine/World.h"
+#include "Misc/Paths.h"
+
+void UBallTrajectoryRecorder::Deinitialize()
+{
+	StopRecording();
+	Super::Deinitialize();
+}
+
+FString UBallTrajectoryRecorder::GetRecordingDirectory()
+{
+	return FPaths::ProjectSavedDir() / TEXT("BallTrajectories");
+}
+
+bool UBallTrajectoryRecorder::StartRecording(const FString& FileName)
+{
+	StopRecording();
+
+	Writer = MakeUnique<FBallTrajectoryLogWriter>();
+	if (!Writer->Open(GetRecordingDirectory() / FileName))
+	{
+		Writer.Reset();
+		return false;
+	}
+	return true;
+}
+
+void UBallTrajectoryRecorder::StopRecording()
+{
+	if (Writer)
+	{
+		Writer->Close();
+		Writer.Reset();
+	}
+}
+
+int32 UBallTrajectoryRecorder::RecordShot(
+	const FBallLogLaunch& Launch,
+	const FBallSimConstants& Constants,
+	EBallSimFeature Features,
+	const FVector& Origin,
+	TArrayView<const FBallSimSnapshot> Snapshots,
+	TArrayView<const FBallSimBounce> Bounces)
+{
+	if (!IsRecording())
+	{
+		return INDEX_NONE;
+	}
+
+	const UWorld* World = GetWorld();
+	return Writer->AppendShot(World ? World->GetTimeSeconds() : 0.0, Launch, Constants, Features, Origin, Snapshots, Bounces);
+}
@@ -0,0 +1,240 @@
+﻿// © 2025 UnrealStudy. All rights reserved.
+// Author: taru00@gmail.com | https://x.com/3devnote
+
+#include "BallTrajectorySampler.h"
+#include "BallSimKernel.h"
+
+bool FBallSampleTimes::IsSorted() const
+{
+	if (Times.Num() == 0)
+	{
+		return DeltaTime >= 0.f;
+	}
+
+	for (int32 Index = 1; Index < Times.Num(); ++Index)
+	{
+		if (Times[Index] < Times[Index - 1])
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void FBallTrajectorySampler::Reset()
+{
+	StepInterval = 0.f;
+	InvStepInterval = 0.f;
+	for (TArray<float>* Channel : { &PositionX, &PositionY, &PositionZ, &DirectionX, &DirectionY, &DirectionZ, &Speed, &AngularX, &AngularY, &AngularZ })
+	{
+		Channel->Reset();
+	}
+}
+
+void FBallTrajectorySampler::Build(TArrayView<const FBallSimSnapshot> Snapshots, const FVector& InOrigin, float InStepInterval)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FBallTrajectorySampler::Build);
+
+	Reset();
+	if (Snapshots.Num() < 2 || InStepInterval <= 0.f)
+	{
+		return;
+	}
+
+	StepInterval = InStepInterval;
+	InvStepInterval = 1.f / InStepInterval;
+	Origin = InOrigin;
+
+	const int32 Num = Snapshots.Num();
+	for (TArray<float>* Channel : { &PositionX, &PositionY, &PositionZ, &DirectionX, &DirectionY, &DirectionZ, &Speed, &AngularX, &AngularY, &AngularZ })
+	{
+		Channel->SetNumUninitialized(Num);
+	}
+
+	for (int32 Index = 0; Index < Num; ++Index)
+	{
+		const FBallSimSnapshot& Snapshot = Snapshots[Index];
+		const FVector3f& Position = Snapshot.Position;
+		const FVector3f AngularVelocity = Snapshot.SpinAxis * Snapshot.SpinSpeed;
+		PositionX[Index] = Position.X;
+		PositionY[Index] = Position.Y;
+		PositionZ[Index] = Position.Z;
+		DirectionX[Index] = Snapshot.Direction.X;
+		DirectionY[Index] = Snapshot.Direction.Y;
+		DirectionZ[Index] = Snapshot.Direction.Z;
+		Speed[Index] = Snapshot.Speed;
+		AngularX[Index] = AngularVelocity.X;
+		AngularY[Index] = AngularVelocity.Y;
+		AngularZ[Index] = AngularVelocity.Z;
+	}
+}
+
+void FBallTrajectorySampler::Locate(const FBallSampleTimes& Times, int32 Start, int32 Num, int32* OutIndices, float* OutAlphas) const
+{
+	const float LastStep = (float)(Speed.Num() - 1);
+	const int32 LastSegment = Speed.Num() - 2;
+
+	for (int32 i = 0; i < Num; ++i)
+	{
+		const float StepTime = FMath::Clamp(Times.Get(Start + i) * InvStepInterval, 0.f, LastStep);
+		const int32 Index = FMath::Min((int32)StepTime, LastSegment);
+		OutIndices[i] = Index;
+		OutAlphas[i] = StepTime - Index;
+	}
+}
+
+void FBallTrajectorySampler::Sample(
+	const FBallSampleTimes& Times,
+	TArrayView<FVector> OutPositions,
+	TArrayView<FVector> OutLinearVelocities,
+	TArrayView<FVector> OutAngularVelocities) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FBallTrajectorySampler::Sample);
+
+	const bool bPositions = OutPositions.Num() > 0;
+	const bool bLinearVelocities = OutLinearVelocities.Num() > 0;
+	const bool bAngularVelocities = OutAngularVelocities.Num() > 0;
+	check(!bPositions || OutPositions.Num() >= Times.Count);
+	check(!bLinearVelocities || OutLinearVelocities.Num() >= Times.Count);
+	check(!bAngularVelocities || OutAngularVelocities.Num() >= Times.Count);
+
+	if (Speed.Num() < 2)
+	{
+		for (TArrayView<FVector>* Out : { &OutPositions, &OutLinearVelocities, &OutAngularVelocities })
+		{
+			for (int32 i = 0; i < Out->Num() && i < Times.Count; ++i)
+			{
+				(*Out)[i] = FVector::ZeroVector;
+			}
+		}
+		return;
+	}
+
+	int32 Indices[ChunkSize];
+	float Alphas[ChunkSize];
+
+	// 채널마다 분기 없는 보간 루프를 따로 돌려서 컴파일러가 벡터화할 수 있도록 함
+	for (int32 Start = 0; Start < Times.Count; Start += ChunkSize)
+	{
+		const int32 Num = FMath::Min(ChunkSize, Times.Count - Start);
+		Locate(Times, Start, Num, Indices, Alphas);
+
+		if (bPositions)
+		{
+			FVector* Out = OutPositions.GetData() + Start;
+			for (int32 i = 0; i < Num; ++i)
+			{
+				const int32 A = Indices[i];
+				const float Alpha = Alphas[i];
+				Out[i] = Origin + FVector(
+					FMath::Lerp(PositionX[A], PositionX[A + 1], Alpha),
+					FMath::Lerp(PositionY[A], PositionY[A + 1], Alpha),
+					FMath::Lerp(PositionZ[A], PositionZ[A + 1], Alpha));
+			}
+		}
+
+		if (bLinearVelocities)
+		{
+			// 방향은 보간 후 정규화, 속력은 따로 보간 (GetBallVelocityAtTime 과 같음)
+			FVector* Out = OutLinearVelocities.GetData() + Start;
+			for (int32 i = 0; i < Num; ++i)
+			{
+				const int32 A = Indices[i];
+				const float Alpha = Alphas[i];
+				const float X = FMath::Lerp(DirectionX[A], DirectionX[A + 1], Alpha);
+				const float Y = FMath::Lerp(DirectionY[A], DirectionY[A + 1], Alpha);
+				const float Z = FMath::Lerp(DirectionZ[A], DirectionZ[A + 1], Alpha);
+				const float SizeSquared = X * X + Y * Y + Z * Z;
+				const float Scale = SizeSquared > UE_SMALL_NUMBER ? FMath::Lerp(Speed[A], Speed[A + 1], Alpha) * FMath::InvSqrt(SizeSquared) : 0.f;
+				Out[i] = FVector(X * Scale, Y * Scale, Z * Scale);
+			}
+		}
+
+		if (bAngularVelocities)
+		{
+			FVector* Out = OutAngularVelocities.GetData() + Start;
+			for (int32 i = 0; i < Num; ++i)
+			{
+				const int32 A = Indices[i];
+				const float Alpha = Alphas[i];
+				Out[i] = FVector(
+					FMath::Lerp(AngularX[A], AngularX[A + 1], Alpha),
+					FMath::Lerp(AngularY[A], AngularY[A + 1], Alpha),
+					FMath::Lerp(AngularZ[A], AngularZ[A + 1], Alpha));
+			}
+		}
+	}
+}
+
+void FBallTrajectorySampler::SampleRotations(
+	const FBallSampleTimes& Times,
+	TArrayView<const FBallSimSnapshot> Snapshots,
+	TArrayView<const FBallRotationKey> RotationKeys,
+	TArrayView<FQuat> OutRotations) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FBallTrajectorySampler::SampleRotations);
+
+	check(OutRotations.Num() >= Times.Count);
+
+	if (Speed.Num() < 2 || Snapshots.Num() != Speed.Num() || RotationKeys.Num() == 0)
+	{
+		for (int32 i = 0; i < Times.Count; ++i)
+		{
+			OutRotations[i] = FQuat::Identity;
+		}
+		return;
+	}
+
+	// 정렬되지 않은 시간은 샘플마다 가장 가까운 키프레임부터 복원
+	if (!Times.IsSorted())
+	{
+		for (int32 i = 0; i < Times.Count; ++i)
+		{
+			OutRotations[i] = FBallSimKernel::ReconstructRotation(Snapshots, RotationKeys, StepInterval, Times.Get(i));
+		}
+		return;
+	}
+
+	int32 Indices[ChunkSize];
+	float Alphas[ChunkSize];
+
+	// 현재 적분 위치, 다음 샘플이 키프레임을 지나면 키프레임에서 다시 시작
+	FQuat4f Rotation = FQuat4f(RotationKeys[0].Rotation);
+	int32 RotationStep = RotationKeys[0].StepIndex;
+	int32 NextKey = 1;
+
+	for (int32 Start = 0; Start < Times.Count; Start += ChunkSize)
+	{
+		const int32 Num = FMath::Min(ChunkSize, Times.Count - Start);
+		Locate(Times, Start, Num, Indices, Alphas);
+
+		for (int32 i = 0; i < Num; ++i)
+		{
+			const int32 StepBefore = Indices[i];
+			while (NextKey < RotationKeys.Num() && RotationKeys[NextKey].StepIndex <= StepBefore)
+			{
+				++NextKey;
+			}
+			if (RotationKeys[NextKey - 1].StepIndex > RotationStep)
+			{
+				Rotation = FQuat4f(RotationKeys[NextKey - 1].Rotation);
+				RotationStep = RotationKeys[NextKey - 1].StepIndex;
+			}
+
+			for (; RotationStep < StepBefore; ++RotationStep)
+			{
+				const FBallSimSnapshot& Next = Snapshots[RotationStep + 1];
+				FBallSimKernel::ApplySpinToRotation(Next.SpinAxis * Next.SpinSpeed, StepInterval, Rotation);
+			}
+
+			// 스텝 내부 구간은 다음 스텝의 각속도로 부분 적분
+			FQuat4f SampleRotation = Rotation;
+			if (Alphas[i] > 0.f)
+			{
+				const FBallSimSnapshot& Next = Snapshots[StepBefore + 1];
+				FBallSimKernel::ApplySpinToRotation(Next.SpinAxis * Next.SpinSpeed, Alphas[i] * StepInterval, SampleRotation);
+			}
+			OutRotations[Start + i] = FQuat(SampleRotation);
+		}
+	}
+}
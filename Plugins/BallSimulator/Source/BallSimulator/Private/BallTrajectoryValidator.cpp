@@ -0,0 +1,254 @@
+﻿// © 2025 UnrealStudy. All rights reserved.
+// Author: taru00@gmail.com | https://x.com/3devnote
+
+#include "BallTrajectoryValidator.h"
+#include "BallCollisionCorridor.h"
+#include "Async/ParallelFor.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/IsSorted.h"
+#include <atomic>
+
+DECLARE_LOG_CATEGORY_EXTERN(LogBallTrajectoryValidator, Log, All);
+DEFINE_LOG_CATEGORY(LogBallTrajectoryValidator);
+
+namespace BallTrajectoryValidator
+{
+	static bool IsWithinTolerance(const FVector& Position, const FVector& LinearVelocity, const FVector& AngularVelocity,
+		const FBallTrajectoryCheckpoint& Claimed, const FBallValidationSettings& Settings)
+	{
+		return FVector::DistSquared(Position, Claimed.Position) <= FMath::Square(Settings.PositionTolerance)
+			&& FVector::DistSquared(LinearVelocity, Claimed.LinearVelocity) <= FMath::Square(Settings.VelocityTolerance)
+			&& FVector::DistSquared(AngularVelocity, Claimed.AngularVelocity) <= FMath::Square(Settings.AngularVelocityTolerance);
+	}
+
+	static bool IsWellFormed(const FBallSimContext& Context, const FBallClaimedTrajectory& Claim, const FBallValidationSettings& Settings)
+	{
+		const TArray<FBallTrajectoryCheckpoint>& Checkpoints = Claim.Checkpoints;
+		if (Checkpoints.Num() < 2 || Checkpoints[0].StepIndex != 0
+			|| !FMath::IsNearlyEqual(Claim.StepInterval, Context.Constants.StepInterval))
+		{
+			return false;
+		}
+
+		for (int32 i = 1; i < Checkpoints.Num(); ++i)
+		{
+			const int32 SegmentSteps = Checkpoints[i].StepIndex - Checkpoints[i - 1].StepIndex;
+			if (SegmentSteps <= 0 || SegmentSteps > Settings.MaxSegmentSteps)
+			{
+				return false;
+			}
+		}
+
+		const int32 LastStep = Checkpoints.Last().StepIndex;
+		if (LastStep > Settings.MaxTotalSteps)
+		{
+			return false;
+		}
+
+		// 바운스는 마지막 체크포인트 이전이어야 검증 가능
+		const TArray<FBallClaimedBounce>& Bounces = Claim.Bounces;
+		return Algo::IsSortedBy(Bounces, &FBallClaimedBounce::StepIndex)
+			&& (Bounces.Num() == 0 || (Bounces[0].StepIndex > 0 && Bounces.Last().StepIndex <= LastStep));
+	}
+}
+
+FBallTrajectoryCheckpoint FBallTrajectoryValidator::MakeCheckpoint(const FBallSimState& State, const FVector& Origin, float WorldTime)
+{
+	FBallTrajectoryCheckpoint Checkpoint;
+	Checkpoint.StepIndex = State.StepIndex;
+	Checkpoint.Position = Origin + FVector(State.Position);
+	Checkpoint.LinearVelocity = FVector(State.LinearVelocity);
+	Checkpoint.AngularVelocity = FVector(State.AngularVelocity);
+	Checkpoint.BounceCount = State.BounceCount;
+	// 커널의 연속 충돌 판정과 같은 조건
+	Checkpoint.bHasPreviousHit = WorldTime - State.PreviousHitTime <= UE_KINDA_SMALL_NUMBER;
+	Checkpoint.PreviousHitNormal = FVector(State.PreviousHitNormal);
+	return Checkpoint;
+}
+
+FBallSimState FBallTrajectoryValidator::MakeState(const FBallTrajectoryCheckpoint& Checkpoint, const FVector& Origin, float WorldTime)
+{
+	FBallSimState State;
+	State.StepIndex = Checkpoint.StepIndex;
+	State.Position = FVector3f(Checkpoint.Position - Origin);
+	State.LinearVelocity = FVector3f(Checkpoint.LinearVelocity);
+	State.AngularVelocity = FVector3f(Checkpoint.AngularVelocity);
+	State.BounceCount = Checkpoint.BounceCount;
+	State.PreviousHitTime = Checkpoint.bHasPreviousHit ? WorldTime : WorldTime - 1.f;
+	State.PreviousHitNormal = FVector3f(Checkpoint.PreviousHitNormal);
+	return State;
+}
+
+void FBallTrajectoryValidator::MakeClaim(
+	TArrayView<const FBallSimCheckpoint> Checkpoints,
+	const FVector& Origin,
+	TArrayView<const FBallSimBounce> Bounces,
+	const FBallSimState& FinalState,
+	float WorldTime,
+	float StepInterval,
+	FBallClaimedTrajectory& OutClaim)
+{
+	OutClaim.StepInterval = StepInterval;
+
+	OutClaim.Checkpoints.Reset(Checkpoints.Num() + 1);
+	for (const FBallSimCheckpoint& Checkpoint : Checkpoints)
+	{
+		OutClaim.Checkpoints.Add(MakeCheckpoint(Checkpoint.State, Origin, WorldTime));
+	}
+
+	// 체크포인트 간격으로 끝나지 않은 궤적은 최종 상태를 마지막 체크포인트로 추가
+	if (OutClaim.Checkpoints.Num() == 0 || OutClaim.Checkpoints.Last().StepIndex < FinalState.StepIndex)
+	{
+		OutClaim.Checkpoints.Add(MakeCheckpoint(FinalState, Origin, WorldTime));
+	}
+
+	OutClaim.Bounces.Reset(Bounces.Num());
+	for (const FBallSimBounce& Bounce : Bounces)
+	{
+		FBallClaimedBounce& Claimed = OutClaim.Bounces.AddDefaulted_GetRef();
+		Claimed.StepIndex = Bounce.SnapshotIndex;
+		Claimed.ImpactPoint = Bounce.GetWorldImpactPoint(Origin);
+	}
+}
+
+FBallValidationResult FBallTrajectoryValidator::Validate(
+	const FBallSimContext& Context,
+	EBallSimFeature Features,
+	const FBallSimState& LaunchState,
+	const FBallClaimedTrajectory& Claim,
+	const FBallValidationSettings& Settings)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FBallTrajectoryValidator::Validate);
+	SCOPE_CYCLE_COUNTER(STAT_BallTrajectoryValidation);
+
+	using namespace BallTrajectoryValidator;
+
+	FBallValidationResult Result;
+	if (!Context.World || !IsWellFormed(Context, Claim, Settings))
+	{
+		Result.Failure = EBallValidationFailure::Malformed;
+		Result.DivergenceTime = 0.f;
+		return Result;
+	}
+
+	const TArray<FBallTrajectoryCheckpoint>& Checkpoints = Claim.Checkpoints;
+	if (!IsWithinTolerance(Context.ToWorld(LaunchState.Position), FVector(LaunchState.LinearVelocity), FVector(LaunchState.AngularVelocity), Checkpoints[0], Settings))
+	{
+		Result.Failure = EBallValidationFailure::LaunchMismatch;
+		Result.FailedSegment = 0;
+		Result.DivergenceTime = 0.f;
+		return Result;
+	}
+
+	const FBallSimKernel& Kernel = FBallSimKernel::Get(Features);
+	const float StepInterval = Context.Constants.StepInterval;
+	const int32 NumSegments = Checkpoints.Num() - 1;
+
+	// 실패한 구간 중 가장 앞의 인덱스, 이보다 뒤의 구간은 결과에 영향이 없으므로 진행을 멈춤
+	std::atomic<int32> FirstFailedSegment{ MAX_int32 };
+	TArray<FBallValidationResult> SegmentResults;
+	SegmentResults.SetNum(NumSegments);
+
+	ParallelFor(NumSegments, [&](int32 Segment)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FBallTrajectoryValidator::ValidateSegment);
+
+		if (Segment > FirstFailedSegment.load(std::memory_order_relaxed))
+		{
+			return;
+		}
+
+		const FBallTrajectoryCheckpoint& From = Checkpoints[Segment];
+		const FBallTrajectoryCheckpoint& To = Checkpoints[Segment + 1];
+
+		// 구간 출력은 바운스만 필요
+		TArray<FBallSimBounce> Hits;
+		TArray<FBallSimBounce> Bounces;
+		FBallSimContext SegmentContext = Context;
+		SegmentContext.Snapshots = nullptr;
+		SegmentContext.RotationKeys = nullptr;
+		SegmentContext.Checkpoints = nullptr;
+		SegmentContext.Hits = &Hits;
+		SegmentContext.Bounces = &Bounces;
+
+		FBallCollisionCorridor SegmentCorridor;
+		if (Context.Corridor)
+		{
+			SegmentCorridor.Reset(To.StepIndex * StepInterval);
+			SegmentContext.Corridor = &SegmentCorridor;
+		}
+
+		FBallSurfaceCache SegmentSurfaceCache;
+		if (Context.SurfaceCache)
+		{
+			SegmentContext.SurfaceCache = &SegmentSurfaceCache;
+		}
+
+		FBallSimState State = MakeState(From, Context.Origin, Context.WorldTime);
+		while (State.StepIndex < To.StepIndex && State.HandoffReason == EBallHandoffReason::None)
+		{
+			Kernel.Step(SegmentContext, State);
+
+			if (Segment > FirstFailedSegment.load(std::memory_order_relaxed))
+			{
+				return;
+			}
+		}
+
+		// 구간 (From, To] 에 속하는 클라이언트 바운스
+		const int32 ClaimedBegin = Algo::UpperBoundBy(Claim.Bounces, From.StepIndex, &FBallClaimedBounce::StepIndex);
+		const int32 ClaimedEnd = Algo::UpperBoundBy(Claim.Bounces, To.StepIndex, &FBallClaimedBounce::StepIndex);
+		const int32 NumClaimed = ClaimedEnd - ClaimedBegin;
+
+		FBallValidationResult& SegmentResult = SegmentResults[Segment];
+		for (int32 i = 0; i < FMath::Max(NumClaimed, Bounces.Num()); ++i)
+		{
+			const FBallClaimedBounce* Claimed = i < NumClaimed ? &Claim.Bounces[ClaimedBegin + i] : nullptr;
+			const FBallSimBounce* Simulated = i < Bounces.Num() ? &Bounces[i] : nullptr;
+			if (Claimed && Simulated
+				&& Claimed->StepIndex == Simulated->SnapshotIndex
+				&& FVector::DistSquared(Claimed->ImpactPoint, Simulated->GetWorldImpactPoint(Context.Origin)) <= FMath::Square(Settings.BouncePositionTolerance))
+			{
+				continue;
+			}
+
+			const int32 DivergenceStep = FMath::Min(
+				Claimed ? Claimed->StepIndex : MAX_int32,
+				Simulated ? Simulated->SnapshotIndex : MAX_int32);
+			SegmentResult.Failure = EBallValidationFailure::BounceMismatch;
+			SegmentResult.DivergenceTime = (DivergenceStep - 1) * StepInterval;
+			break;
+		}
+
+		if (SegmentResult.Failure == EBallValidationFailure::None
+			&& (State.StepIndex != To.StepIndex
+				|| State.BounceCount != To.BounceCount
+				|| !IsWithinTolerance(Context.ToWorld(State.Position), FVector(State.LinearVelocity), FVector(State.AngularVelocity), To, Settings)))
+		{
+			SegmentResult.Failure = EBallValidationFailure::StateMismatch;
+			SegmentResult.DivergenceTime = From.StepIndex * StepInterval;
+		}
+
+		if (SegmentResult.Failure != EBallValidationFailure::None)
+		{
+			SegmentResult.FailedSegment = Segment;
+
+			int32 Current = FirstFailedSegment.load(std::memory_order_relaxed);
+			while (Segment < Current && !FirstFailedSegment.compare_exchange_weak(Current, Segment, std::memory_order_relaxed))
+			{
+			}
+		}
+	});
+
+	const int32 FailedSegment = FirstFailedSegment.load(std::memory_order_relaxed);
+	if (FailedSegment == MAX_int32)
+	{
+		Result.bAccepted = true;
+		return Result;
+	}
+
+	Result = SegmentResults[FailedSegment];
+	UE_LOG(LogBallTrajectoryValidator, Verbose, TEXT("Trajectory rejected : segment %d/%d, failure %d, divergence %.3fs"),
+		FailedSegment, NumSegments, (int32)Result.Failure, Result.DivergenceTime);
+	return Result;
+}
@@ -0,0 +1,45 @@
+﻿// © 2025 UnrealStudy. All rights reserved.
+// Author: taru00@gmail.com | https://x.com/3devnote
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UPrimitiveComponent;
+struct FBallSimContext;
+struct FBallSimState;
+struct FHitResult;
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Corridor Gathers"), STAT_BallCorridorGathers, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Corridor Regathers"), STAT_BallCorridorRegathers, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Corridor Candidates"), STAT_BallCorridorCandidates, STATGROUP_Game);
+
+// 예상 비행 경로 (통로) 주변의 정적 충돌체를 미리 모아서 Sweep 을 후보 충돌체에만 수행
+// 발사 상태에서 중력 + 초기 속도 탄도에 감쇠, 항력, 스핀 횡력 상한만큼 부풀린 박스 구간들로 한번 Overlap 해서 후보를 모으고
+// 공이 통로를 벗어나면 (예상하지 못한 바운스 등) 그 상태에서 다시 모음
+class BALLSIMULATOR_API FBallCollisionCorridor
+{
+public:
+    // EndTime 은 시뮬레이션 종료 시간 (시작 기준), 첫 Sweep 에서 모음
+    void Reset(float InEndTime);
+
+    // 통로 밖으로 나가면 다시 모은 후 후보 충돌체에 Sweep, 가장 먼저 닿는 충돌 반환
+    bool Sweep(const FBallSimContext& Context, const FBallSimState& State, const FVector& Start, const FVector& End, FHitResult& OutHit);
+
+    // 첫 수집을 제외한 재수집 횟수
+    int32 GetNumRegathers() const { return FMath::Max(NumGathers - 1, 0); }
+    int32 GetNumCandidates() const { return Candidates.Num(); }
+
+private:
+    void Gather(const FBallSimContext& Context, float Time, const FVector& Position, const FVector& Velocity, const FVector& AngularVelocity);
+    // Position 이 Inset 만큼 줄인 구간 박스 중 하나 안에 있음
+    bool Contains(const FVector& Position, float Inset) const;
+    // 모은 뒤 제거되거나 등록 해제된 후보가 있음
+    bool HasStaleCandidates() const;
+
+    TArray<FBox, TInlineAllocator<16>> Segments;
+    // 워커 스레드에서 Sweep 하는 동안 게임 스레드가 충돌체를 제거할 수 있으므로 약한 참조로 보관
+    TArray<TWeakObjectPtr<UPrimitiveComponent>> Candidates;
+    float EndTime = 0.f;
+    int32 NumGathers = 0;
+};
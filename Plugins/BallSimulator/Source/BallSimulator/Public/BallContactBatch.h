@@ -0,0 +1,121 @@
+﻿// © 2025 UnrealStudy. All rights reserved.
+// Author: taru00@gmail.com | https://x.com/3devnote
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Ball Batched Contacts"), STAT_BallBatchedContacts, STATGROUP_Game);
+
+// 접촉 한 개의 응답 입력 (공 A 기준), 상대는 정적 충돌면, 이동 장애물 또는 같은 종류의 다른 공
+struct FBallContactInput
+{
+    // 공 중심에서 접촉점으로 가는 벡터 r = P - C
+    FVector3f Arm = FVector3f::ZeroVector;
+
+    // 접근 속도 (vRel) 판정 법선
+    FVector3f Normal = FVector3f::UpVector;
+
+    // 임펄스, 마찰 방향 법선 (Sweep 의 ImpactNormal, 공끼리는 Normal 과 같음)
+    FVector3f ImpactNormal = FVector3f::UpVector;
+
+    FVector3f LinearVelocity = FVector3f::ZeroVector;
+    FVector3f AngularVelocity = FVector3f::ZeroVector;
+
+    // 상대 쪽 접촉점 속도 (이동 장애물 표면 속도, 상대 공의 접촉점 속도)
+    FVector3f SurfaceVelocity = FVector3f::ZeroVector;
+
+    float InvMass = 1.f;
+    FVector3f InvInertia = FVector3f::OneVector;
+
+    // 상대 쪽 질량, 관성 (정적 충돌면과 장애물은 0), 상대 공의 팔은 -Arm 이어야 함
+    float OtherInvMass = 0.f;
+    FVector3f OtherInvInertia = FVector3f::ZeroVector;
+
+    float Restitution = 0.7f;
+    float Friction = 0.1f;
+
+    // ImpulseClamp 기능이 없으면 UE_BIG_NUMBER
+    float MaxImpulse = UE_BIG_NUMBER;
+};
+
+struct FBallContactResult
+{
+    // 0 보다 크면 멀어지는 중 (임펄스는 계산되지만 적용하지 않아야 함)
+    float vRel = 0.f;
+
+    // 법선 임펄스 크기, 0 ~ MaxImpulse
+    float NormalImpulse = 0.f;
+
+    // 쿠롱 마찰 임펄스 (접선 방향), 접선 속도가 없으면 0
+    FVector3f FrictionImpulse = FVector3f::ZeroVector;
+
+    // 마찰에 의한 각속도 변화 Δω = I⁻¹ (r × J), 상대 공도 같은 값 (반대 팔, 반대 임펄스)
+    FVector3f AngularDelta = FVector3f::ZeroVector;
+};
+
+// 접촉 응답 (반발 임펄스, 쿠롱 마찰, 마찰에 의한 각속도 변화) 을 LaneWidth 개씩 채널별 float 배열 (SoA) 블록으로 모아서 계산
+// 블록마다 분기 없는 레인 루프 하나로 처리해서 컴파일러가 SIMD (SSE 4 레인, AVX 8 레인) 로 벡터화
+// 단일 접촉 (HandleCollision) 은 같은 레인 수식을 한 레인으로 계산
+class BALLSIMULATOR_API FBallContactBatch
+{
+public:
+    static constexpr int32 LaneWidth = 8;
+
+    void Reset();
+
+    // 접촉 인덱스 반환
+    int32 Add(const FBallContactInput& Contact);
+
+    int32 Num() const { return NumContacts; }
+
+    // 추가한 모든 접촉의 응답 계산
+    void Resolve();
+
+    FBallContactResult GetResult(int32 Index) const;
+
+    // 접촉 한 개, 블록 없이 한 레인으로 계산
+    static FBallContactResult ResolveSingle(const FBallContactInput& Contact);
+
+private:
+    enum EChannel : int32
+    {
+        ArmX, ArmY, ArmZ,
+        NormalX, NormalY, NormalZ,
+        ImpactNormalX, ImpactNormalY, ImpactNormalZ,
+        LinearX, LinearY, LinearZ,
+        AngularX, AngularY, AngularZ,
+        SurfaceX, SurfaceY, SurfaceZ,
+        InvMass,
+        InvInertiaX, InvInertiaY, InvInertiaZ,
+        OtherInvMass,
+        OtherInvInertiaX, OtherInvInertiaY, OtherInvInertiaZ,
+        Restitution,
+        Friction,
+        MaxImpulse,
+
+        // 출력
+        OutRelativeVelocity,
+        OutNormalImpulse,
+        OutFrictionX, OutFrictionY, OutFrictionZ,
+        OutAngularDeltaX, OutAngularDeltaY, OutAngularDeltaZ,
+
+        NumChannels
+    };
+
+    static constexpr int32 BlockSize = NumChannels * LaneWidth;
+
+    // Block[Channel * Stride + Lane]
+    static void WriteLane(float* Block, int32 Stride, int32 Lane, const FBallContactInput& Contact);
+    static FBallContactResult ReadLane(const float* Block, int32 Stride, int32 Lane);
+
+    // 레인 하나의 응답 수식
+    static void ResolveLane(float* RESTRICT const* Channel, int32 Lane);
+
+    // 블록의 LaneWidth 개 레인 모두 계산 (빈 레인은 기본 입력으로 채워져 있어야 함)
+    static void ResolveBlock(float* Block);
+
+    // [Block][Channel][Lane]
+    TArray<float> Blocks;
+    int32 NumContacts = 0;
+};
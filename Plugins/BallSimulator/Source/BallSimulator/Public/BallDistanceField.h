@@ -0,0 +1,109 @@
+﻿// © 2025 UnrealStudy. All rights reserved.
+// Author: taru00@gmail.com | https://x.com/3devnote
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "BallDistanceField.generated.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Ball Sweeps"), STAT_BallSweeps, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Ball Sweeps Skipped"), STAT_BallSweepsSkipped, STATGROUP_Game);
+
+// 거리장에 없는 움직이는 블로킹 충돌체의 경계 구 (게임 스레드에서 수집한 시점의 위치)
+// 여유 거리 안의 이동이라도 이 구와 닿을 수 있으면 Sweep 을 생략하지 않음
+struct FBallMovableProxy
+{
+    FVector Center = FVector::ZeroVector;
+    float Radius = 0.f;
+
+    // 무시 목록 (FCollisionQueryParams::GetIgnoredActors) 과 비교
+    uint32 ActorId = 0;
+};
+
+// 정적 충돌체까지 거리의 하한을 가지는 희소 거리장
+// 8x8x8 셀 브릭 단위로 저장, 충돌체에서 먼 브릭은 값 하나만, 가까운 브릭만 셀별 8 비트 양자화 값을 가짐
+// 모든 값은 내림 (보수적) 이므로 여유 거리 안의 이동은 Sweep 없이 충돌이 없음이 보장됨
+class BALLSIMULATOR_API FBallDistanceField
+{
+public:
+    // 구간 안의 셀 중심마다 구 Overlap 이진 탐색으로 굽기 (정적 모빌리티, ECC_WorldStatic 블로킹 충돌체만)
+    // 브릭, 셀 단위로 병렬 처리, 레벨 로드 시 한 번 수행하는 용도
+    void Bake(UWorld* World, const FBox& Bounds, float InCellSize, float MaxDistance);
+
+    bool IsEmpty() const { return BrickClearance.Num() == 0; }
+    int32 GetNumBricks() const { return BrickClearance.Num(); }
+    int32 GetNumDetailBricks() const { return Detail.Num() / CellsPerBrick; }
+    SIZE_T GetAllocatedSize() const { return BrickClearance.GetAllocatedSize() + BrickDetail.GetAllocatedSize() + Detail.GetAllocatedSize(); }
+
+    // Position 에서 정적 충돌체 표면까지 거리의 하한 (cm), 구운 영역 밖이면 0
+    FORCEINLINE float GetClearance(const FVector& Position) const
+    {
+        const FVector Local = (Position - Origin) * InvCellSize;
+        const int32 X = FMath::FloorToInt(Local.X);
+        const int32 Y = FMath::FloorToInt(Local.Y);
+        const int32 Z = FMath::FloorToInt(Local.Z);
+        if ((uint32)X >= (uint32)NumCells.X || (uint32)Y >= (uint32)NumCells.Y || (uint32)Z >= (uint32)NumCells.Z)
+        {
+            return 0.f;
+        }
+
+        const int32 Brick = ((Z >> BrickShift) * NumBricks.Y + (Y >> BrickShift)) * NumBricks.X + (X >> BrickShift);
+        const int32 DetailIndex = BrickDetail[Brick];
+        if (DetailIndex == INDEX_NONE)
+        {
+            return BrickClearance[Brick];
+        }
+
+        const int32 Cell = (((Z & BrickMask) << BrickShift) + (Y & BrickMask)) << BrickShift | (X & BrickMask);
+        return Detail[DetailIndex * CellsPerBrick + Cell] * QuantizationStep;
+    }
+
+private:
+    static constexpr int32 BrickShift = 3;
+    static constexpr int32 BrickCells = 1 << BrickShift;
+    static constexpr int32 BrickMask = BrickCells - 1;
+    static constexpr int32 CellsPerBrick = BrickCells * BrickCells * BrickCells;
+
+    FVector Origin = FVector::ZeroVector;
+    float CellSize = 0.f;
+    float InvCellSize = 0.f;
+    float QuantizationStep = 0.f;
+    FIntVector NumCells = FIntVector::ZeroValue;
+    FIntVector NumBricks = FIntVector::ZeroValue;
+
+    // 브릭마다 균일 여유 거리, BrickDetail 이 INDEX_NONE 이 아니면 Detail 의 브릭 번호
+    TArray<float> BrickClearance;
+    TArray<int32> BrickDetail;
+    TArray<uint8> Detail;
+};
+
+// 게임 월드의 정적 충돌체로 구운 거리장 보관
+// 시뮬레이션은 이 거리장으로 자유 비행 구간의 Sweep 을 생략 (FBallSimContext::DistanceField)
+// 움직이는 충돌체는 거리장에 포함되지 않으므로 경계 구 목록 (FBallSimContext::MovableProxies) 과 닿지 않을 때만 생략
+UCLASS()
+class BALLSIMULATOR_API UBallDistanceFieldSubsystem : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+
+    // Bounds 가 유효하지 않으면 레벨 경계 사용, 레벨 스트리밍 등으로 정적 충돌체가 바뀌면 다시 호출
+    UFUNCTION(BlueprintCallable, Category = "Ballistic Physics Simulator")
+    void BakeDistanceField(FBox Bounds);
+
+    // BallSim.DistanceField.Enable 이 0 이거나 굽지 않았으면 nullptr
+    // 진행 중인 비동기 시뮬레이션이 다시 굽는 동안에도 이전 거리장을 유지할 수 있도록 공유 포인터로 반환
+    TSharedPtr<const FBallDistanceField, ESPMode::ThreadSafe> GetDistanceField() const;
+
+    // 움직이는 블로킹 (ECC_WorldStatic 채널) 충돌체의 경계 구, 프레임마다 처음 요청할 때 한번 수집 (게임 스레드)
+    TSharedPtr<const TArray<FBallMovableProxy>, ESPMode::ThreadSafe> GetMovableProxies();
+
+private:
+    TSharedPtr<const FBallDistanceField, ESPMode::ThreadSafe> DistanceField;
+
+    TSharedPtr<const TArray<FBallMovableProxy>, ESPMode::ThreadSafe> MovableProxies;
+    uint64 MovableProxiesFrame = MAX_uint64;
+};
@@ -0,0 +1,128 @@
+﻿// © 2025 UnrealStudy. All rights reserved.
+// Author: taru00@gmail.com | https://x.com/3devnote
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/HitResult.h"
+#include "BallKinematicObstacle.generated.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Obstacle Candidates"), STAT_BallObstacleCandidates, STATGROUP_Game);
+
+UENUM(BlueprintType)
+enum class EBallObstacleShape : uint8
+{
+    Sphere,
+    Capsule,
+};
+
+// 장애물 예측 궤적의 키 (시뮬레이션 시작 시점 기준 시간)
+USTRUCT(BlueprintType)
+struct FBallObstaclePoseKey
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float Time = 0.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FVector Position = FVector::ZeroVector;
+};
+
+// 수비벽, 골키퍼, 선수 등 예측된 이동 궤적을 가지는 키네마틱 장애물
+// 월드 Sweep 에는 포함되지 않으며 시뮬레이션 시간 기준으로 해석적 충돌 검사를 수행함
+USTRUCT(BlueprintType)
+struct BALLSIMULATOR_API FBallKinematicObstacle
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    EBallObstacleShape Shape = EBallObstacleShape::Capsule;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float Radius = 30.f;
+
+    // 캡슐 반높이 (UCapsuleComponent 와 동일하게 반구 포함)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float HalfHeight = 90.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FVector Axis = FVector::UpVector;
+
+    // PoseKeys 가 비어 있으면 Position + Velocity * t 로 등속 이동
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FVector Position = FVector::ZeroVector;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FVector Velocity = FVector::ZeroVector;
+
+    // 시간 순으로 정렬된 위치 키 (키 사이는 선형 보간, 범위 밖은 정지)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TArray<FBallObstaclePoseKey> PoseKeys;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float Restitution = 0.3f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float Friction = 0.5f;
+
+    FVector GetPositionAtTime(float Time) const;
+
+    // 캡슐 중심축 선분의 반길이 (구체는 0)
+    float GetSegmentHalfLength() const
+    {
+        return Shape == EBallObstacleShape::Capsule ? FMath::Max(HalfHeight - Radius, 0.f) : 0.f;
+    }
+};
+
+// 시간 윈도우 단위 Broad-phase 를 가지는 키네마틱 장애물 집합
+// 윈도우별로 장애물의 이동 범위 AABB 를 미리 계산해서 장애물이 가장 넓게 퍼진 축 기준으로 정렬해 두고,
+// SubStep 에서는 이진 탐색으로 그 축 구간이 겹치는 AABB 만 검사한다. (장애물 수가 늘어도 검사 수는 거의 일정)
+class BALLSIMULATOR_API FBallObstacleSet
+{
+public:
+    void Build(TArrayView<const FBallKinematicObstacle> InObstacles, float InBallRadius, float InWindowDuration, float InEndTime);
+    void Reset();
+
+    bool IsEmpty() const { return Obstacles.Num() == 0; }
+    int32 Num() const { return Obstacles.Num(); }
+
+    const FBallKinematicObstacle& GetObstacle(int32 Index) const { return Obstacles[Index]; }
+
+    // [StartTime, StartTime + DeltaTime] 동안 Start → End 로 이동하는 공에 대해 가장 먼저 접촉하는 장애물 검사
+    // OutSurfaceVelocity 는 접촉 시점의 장애물 속도 (상대 속도 계산용)
+    bool Sweep(
+        const FVector& Start,
+        const FVector& End,
+        float StartTime,
+        float DeltaTime,
+        FHitResult& OutHit,
+        int32& OutObstacleIndex,
+        FVector& OutSurfaceVelocity) const;
+
+    // 선분 AB 를 축으로 하고 반지름 R 인 캡슐에 대해 S + s * D (s ∈ [0,1]) 의 최초 접촉 비율, 없으면 -1
+    static float IntersectSegmentCapsule(const FVector& S, const FVector& D, const FVector& A, const FVector& B, float R);
+
+private:
+    struct FTimeWindow
+    {
+        // Candidates[i] 의 이 윈도우 내 이동 범위 (공 반지름 포함), SortKeys (Bounds.Min[SortAxis]) 오름차순
+        TArray<int32> Candidates;
+        TArray<FBox> Bounds;
+        TArray<float> SortKeys;
+        int32 SortAxis = 0;
+
+        // SortAxis 방향 Bounds 최대 폭, 탐색 시작 위치를 이만큼 앞당김
+        float MaxExtent = 0.f;
+
+        // SortAxis 구간이 Query 와 겹칠 수 있는 후보 범위 [OutFirst, OutLast)
+        void GetCandidateRange(const FBox& Query, int32& OutFirst, int32& OutLast) const;
+    };
+
+    int32 GetWindowIndex(float Time) const;
+
+    TArray<FBallKinematicObstacle> Obstacles;
+    TArray<FTimeWindow> Windows;
+    float WindowDuration = 0.25f;
+    float BallRadius = 0.f;
+};
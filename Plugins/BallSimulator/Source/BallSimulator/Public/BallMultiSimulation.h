@@ -0,0 +1,113 @@
+﻿// © 2025 UnrealStudy. All rights reserved.
+// Author: taru00@gmail.com | https://x.com/3devnote
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BallSimKernel.h"
+#include "BallContactBatch.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Ball Pair Candidates"), STAT_BallPairCandidates, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Ball Pair Contacts"), STAT_BallPairContacts, STATGROUP_Game);
+
+// 공 중심 위치에 대한 균일 격자 공간 해시
+// 셀 크기 이내로 가까운 모든 공 쌍은 이웃 27 개 셀 안에서 찾을 수 있으며, 스텝마다 셀이 바뀐 공만 옮김 (증분 재구성)
+class BALLSIMULATOR_API FBallSpatialHash
+{
+public:
+    // 셀 크기를 바꾸고 모든 공을 제거 (다음 Update 에서 다시 삽입)
+    void Reset(float InCellSize, int32 NumBalls);
+
+    void Update(int32 BallIndex, const FVector3f& Position);
+
+    // A < B 인 후보 쌍 수집, 셀 크기보다 멀리 떨어진 쌍도 포함될 수 있음
+    void GatherPairs(TArray<TPair<int32, int32>>& OutPairs) const;
+
+    float GetCellSize() const { return CellSize; }
+
+private:
+    FIntVector GetCell(const FVector3f& Position) const;
+
+    // 비워진 셀도 메모리를 유지 (경기장 범위 안에서만 늘어남)
+    TMap<FIntVector, TArray<int32>> Cells;
+    TArray<FIntVector> BallCells;
+    TBitArray<> Inserted;
+
+    float CellSize = 0.f;
+    float InvCellSize = 0.f;
+};
+
+// 같은 종류의 공 여러 개를 함께 시뮬레이션하며 공끼리의 충돌을 처리 (훈련, 워밍업 장면)
+// 각 공은 기능 조합별 커널로 한 스텝 진행 (월드 충돌) 한 뒤, 공간 해시 후보 쌍마다 스텝 내 최초 접촉 시점을 구해서
+// 시간 순으로 FBallSimKernel::ResolveBallContact 를 적용한다. 접촉 후 남은 시간은 커널 SubStep 으로 월드 충돌까지 다시 진행.
+class BALLSIMULATOR_API FBallMultiSimulation
+{
+public:
+    // 모든 공은 같은 StepIndex 에서 시작해야 하고 위치는 InContext.Origin 기준
+    // Context 의 출력 버퍼, 이벤트, 표면 캐시, 충돌 통로는 사용하지 않고 bRecordSnapshots 이면 공마다 시작 상태부터 스냅샷 기록
+    void Initialize(const FBallSimContext& InContext, EBallSimFeature InFeatures, TArrayView<const FBallSimState> InStates, bool bRecordSnapshots);
+
+    void Step();
+
+    // 모든 공이 LastStep 에 도달할 때까지 진행 후 회전 반영
+    void Run(int32 LastStep);
+
+    int32 Num() const { return States.Num(); }
+    TArrayView<const FBallSimState> GetStates() const { return States; }
+    TArray<TArray<FBallSimSnapshot>>& GetSnapshots() { return Snapshots; }
+    int32 GetNumBallContacts() const { return NumBallContacts; }
+
+    // 공 수가 이 값 이상이면 공별 커널 스텝 (월드 Sweep, 대부분의 비용) 을 ParallelFor 로 분산
+    int32 ParallelThreshold = 256;
+
+private:
+    void StepBalls();
+    void UpdateBroadphase();
+    void ResolveContacts();
+
+    // [GroupStart, GroupEnd) 접촉은 서로 다른 공끼리여야 함, 응답을 FBallContactBatch 로 한번에 계산
+    void ResolveContactGroup(int32 GroupStart, int32 GroupEnd);
+
+    // 접촉 시점 (스텝 내 비율 ContactTime) 의 위치에서 남은 시간을 커널 HandleCollision 으로 월드 충돌까지 진행
+    void SweepRemainder(int32 BallIndex, const FVector3f& ContactPosition, float ContactTime);
+    void RecordSnapshots();
+
+    // 시작 시 상대 위치 D0, 스텝 동안의 상대 이동 Delta 에서 거리가 ContactDistance 가 되는 최초 비율, 없으면 -1
+    static float GetFirstContactTime(const FVector3f& D0, const FVector3f& Delta, float ContactDistance);
+
+    FBallSimContext Context;
+    EBallSimFeature Features = EBallSimFeature::All;
+    const FBallSimKernel* Kernel = nullptr;
+
+    TArray<FBallSimState> States;
+    TArray<FVector3f> StartPositions;
+    TArray<int32> HitCounts;
+    TArray<TArray<FBallSimSnapshot>> Snapshots;
+    bool bRecordSnapshots = false;
+
+    struct FBallContact
+    {
+        int32 A;
+        int32 B;
+        float Time;
+    };
+
+    FBallSpatialHash SpatialHash;
+    TArray<TPair<int32, int32>> Pairs;
+    TArray<FBallContact> Contacts;
+    int32 NumBallContacts = 0;
+
+    // 묶음 안에서 응답 계산을 기다리는 접촉 (접촉 시점 위치와 법선)
+    struct FPendingContact
+    {
+        int32 A;
+        int32 B;
+        float Time;
+        FVector3f ContactA;
+        FVector3f ContactB;
+        FVector3f Normal;
+    };
+
+    FBallContactBatch ContactBatch;
+    TArray<FPendingContact> PendingContacts;
+};
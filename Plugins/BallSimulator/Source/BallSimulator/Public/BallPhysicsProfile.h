@@ -0,0 +1,194 @@
+﻿// © 2025 UnrealStudy. All rights reserved.
+// Author: taru00@gmail.com | https://x.com/3devnote
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Curves/CurveFloat.h"
+#include "BallSimKernel.h"
+#include "BallPhysicsProfile.generated.h"
+
+UENUM(BlueprintType)
+enum class EBallType : uint8
+{
+    Soccer,
+    Tennis,
+    Baseball,
+    Bowling,
+    Custom,
+};
+
+// 한 스핀비에서 레이놀즈 수에 따른 항력 / 양력 계수
+// 행 사이의 스핀비는 선형 보간해서 FBallAeroTable 격자로 구움
+USTRUCT(BlueprintType)
+struct FBallAeroCurve
+{
+    GENERATED_BODY()
+
+    // ω·r / v
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Aerodynamics", meta = (ClampMin = "0"))
+    float SpinRatio = 0.f;
+
+    // 가로축 : 레이놀즈 수, 세로축 : Cd
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Aerodynamics")
+    FRuntimeFloatCurve DragCoefficient;
+
+    // 가로축 : 레이놀즈 수, 세로축 : Cl (음수이면 역 마그누스)
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Aerodynamics")
+    FRuntimeFloatCurve LiftCoefficient;
+};
+
+// 충돌면 종류별 응답 (잔디, 젖은 잔디, 골대, 골망, 광고판 등), 로드 / 편집 시 FBallSurfaceTable 로 구워짐
+USTRUCT(BlueprintType)
+struct FBallSurfaceTuning
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Surface")
+    TEnumAsByte<EPhysicalSurface> SurfaceType = SurfaceType_Default;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Surface", meta = (ClampMin = "0"))
+    float Restitution = 0.7f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Surface", meta = (ClampMin = "0"))
+    float Friction = 0.1f;
+
+    // 접촉마다 법선 축 회전에서 제거하는 비율
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Surface", meta = (ClampMin = "0", ClampMax = "1"))
+    float SpinFriction = 0.f;
+
+    // 구름 접촉 중 선속도 감속 비율 (1/s)
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Surface", meta = (ClampMin = "0"))
+    float RollingResistance = 0.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Surface", meta = (ClampMin = "0"))
+    float BounceSpinMultiplier = 0.65f;
+};
+
+// 공 종류별 물리 튜닝 및 사용 기능 정의
+// 사용하지 않는 기능은 특수화된 커널에서 컴파일 타임에 제거됨 (예: 볼링공의 마그누스, 평평한 경기장의 물리 재질 조회)
+UCLASS(BlueprintType)
+class BALLSIMULATOR_API UBallPhysicsProfile : public UPrimaryDataAsset
+{
+    GENERATED_BODY()
+
+public:
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ball")
+    EBallType BallType = EBallType::Soccer;
+
+    // 축구공 질량 : 약 0.43 kg
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ball")
+    float Mass = 0.43f;
+
+    // 축구공 반지름 : 약 11 cm
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ball")
+    float Radius = 11.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ball")
+    FVector InertiaTensorScale = FVector(0.5f, 0.5f, 0.5f);
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Features")
+    bool bEnableMagnus = true;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Features")
+    bool bEnableDamping = true;
+
+    // 비활성화 시 Sweep 에서 물리 재질을 반환하지 않고 DefaultFriction, DefaultRestitution 만 사용
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Features")
+    bool bUsePhysicalMaterial = true;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Features")
+    bool bClampImpulse = true;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Features")
+    bool bCollideWithObstacles = true;
+
+    // 활성화 시 선형 감쇠와 SpinMagnusFactor 대신 AeroCurves 의 계수 테이블 사용 (AeroCurves 가 비어 있으면 무시)
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Features")
+    bool bUseAerodynamicTables = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tuning")
+    FVector GravityVector = FVector(0, 0, -980.0f);
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tuning", meta = (EditCondition = "bEnableDamping"))
+    float LinearDamping = 0.05f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tuning", meta = (EditCondition = "bEnableDamping"))
+    float AngularDamping = 0.1f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tuning", meta = (EditCondition = "bEnableMagnus"))
+    float MinSpinForMagnus = 10.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tuning", meta = (EditCondition = "bEnableMagnus"))
+    float SpinMagnusFactor = 0.01f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tuning")
+    float BouncedSpinMultiplier = 0.65f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tuning")
+    float SpinToRotateMultiply = 1.0f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tuning")
+    float DefaultRestitution = 0.7f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tuning")
+    float DefaultFriction = 0.1f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tuning", meta = (EditCondition = "bClampImpulse"))
+    float MaxAllowedImpulse = 1000.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tuning")
+    float BounceThreshold = 10.f;
+
+    // 코너, 골대-바닥 사이에 끼었을 때 이 거리 (cm) 안의 접촉을 모아서 동시에 해결
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tuning", meta = (ClampMin = "0"))
+    float ContactSkin = 0.5f;
+
+    // 접촉 매니폴드 Sequential Impulse 반복 횟수, 0 이면 충돌마다 재귀 SubStep 으로 처리
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Tuning", meta = (ClampMin = "0", ClampMax = "16"))
+    int32 ContactSolverIterations = 4;
+
+    // 충돌면 종류별 응답, 지정하지 않은 종류는 물리 재질의 Friction / Restitution 사용 (bUsePhysicalMaterial 필요)
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Surfaces", meta = (EditCondition = "bUsePhysicalMaterial"))
+    TArray<FBallSurfaceTuning> SurfaceResponses;
+
+    // 공기 밀도 (kg/m³)
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Aerodynamics", meta = (EditCondition = "bUseAerodynamicTables"))
+    float AirDensity = 1.225f;
+
+    // 공기 동점성 계수 (m²/s)
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Aerodynamics", meta = (EditCondition = "bUseAerodynamicTables"))
+    float KinematicViscosity = 1.5e-5f;
+
+    // 스핀비 순서와 무관, 로드 / 편집 시 평탄한 배열로 구워짐
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Aerodynamics", meta = (EditCondition = "bUseAerodynamicTables"))
+    TArray<FBallAeroCurve> AeroCurves;
+
+    // 구운 테이블의 레이놀즈 수 축 샘플 수 (항력 위기 구간 해상도)
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Aerodynamics", meta = (EditCondition = "bUseAerodynamicTables", ClampMin = "2", ClampMax = "1024"))
+    int32 AeroReynoldsSamples = 128;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Aerodynamics", meta = (EditCondition = "bUseAerodynamicTables", ClampMin = "2", ClampMax = "256"))
+    int32 AeroSpinRatioSamples = 16;
+
+    virtual void PostLoad() override;
+#if WITH_EDITOR
+    virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+    // AeroCurves 를 FBallAeroTable 로 구움, 이미 진행 중인 시뮬레이션은 이전 테이블을 계속 사용
+    void BakeAeroTable();
+
+    // SurfaceResponses 를 FBallSurfaceTable 로 구움, 진행 중인 시뮬레이션은 이전 표를 계속 사용
+    void BakeSurfaceTable();
+
+    EBallSimFeature GetFeatures() const;
+
+    // Mass, Radius 는 호출자가 지정 (0 이하이면 프로파일 값 사용)
+    FBallSimConstants MakeConstants(float StepInterval, float InMass = 0.f, float InRadius = 0.f) const;
+
+private:
+    TSharedPtr<const FBallAeroTable, ESPMode::ThreadSafe> AeroTable;
+    TSharedPtr<const FBallSurfaceTable, ESPMode::ThreadSafe> SurfaceTable;
+};
@@ -0,0 +1,72 @@
+﻿// © 2025 UnrealStudy. All rights reserved.
+// Author: taru00@gmail.com | https://x.com/3devnote
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "BallPlaybackLOD.generated.h"
+
+class ABallSimulatorActor;
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Playback Near"), STAT_BallPlaybackNear, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Playback Far"), STAT_BallPlaybackFar, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Playback Hidden"), STAT_BallPlaybackHidden, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Playback Batched Updates"), STAT_BallPlaybackBatchedUpdates, STATGROUP_Game);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Playback Near Screen Size"), STAT_BallPlaybackNearScreenSize, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Playback Far Update Interval"), STAT_BallPlaybackFarUpdateInterval, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Playback Hidden Update Interval"), STAT_BallPlaybackHiddenUpdateInterval, STATGROUP_Game);
+
+// 궤적 재생 상세도
+UENUM(BlueprintType)
+enum class EBallPlaybackLOD : uint8
+{
+    Near,       // 매 프레임 액터 Tick, 스플라인 위치 + 회전 복원
+    Far,        // 화면에 작게 보임, 감소 궤적 위치만 낮은 빈도로 일괄 갱신
+    Hidden,     // 화면 밖, Far 보다 더 낮은 빈도로 위치만 갱신
+};
+
+// 재생 중인 ABallSimulatorActor 의 재생 LOD 를 카메라 기준 화면 크기로 결정하고
+// Far / Hidden 공은 액터 Tick 대신 이 서브시스템이 한 번에 위치를 갱신한다. (리플레이 관중석 시점 등 수백 개 궤적 재생용)
+UCLASS()
+class BALLSIMULATOR_API UBallPlaybackLODSubsystem : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    void Register(ABallSimulatorActor* Actor);
+    void Unregister(ABallSimulatorActor* Actor);
+
+    UFUNCTION(BlueprintPure, Category = "Ballistic Physics Simulator")
+    int32 GetNumPlaying() const { return PlayingActors.Num(); }
+
+    UFUNCTION(BlueprintPure, Category = "Ballistic Physics Simulator")
+    int32 GetNumAtLOD(EBallPlaybackLOD LOD) const { return NumAtLOD[(int32)LOD]; }
+
+    // 감소 궤적 스텝 간격 (BallSim.PlaybackLOD.DecimationStep)
+    static int32 GetDecimationStep();
+
+private:
+    struct FPlaybackView
+    {
+        FVector Location;
+        FVector Forward;
+        float TanHalfFOV;
+    };
+
+    void GatherViews(TArray<FPlaybackView, TInlineAllocator<4>>& OutViews) const;
+    static EBallPlaybackLOD ComputeLOD(const FVector& Location, float Radius, TArrayView<const FPlaybackView> Views, float NearScreenSize);
+
+    UPROPERTY(Transient)
+    TArray<ABallSimulatorActor*> PlayingActors;
+
+    // Tick 중 재생이 끝나서 등록이 해제될 수 있으므로 복사본으로 순회
+    TArray<ABallSimulatorActor*> TickActors;
+    TArray<ABallSimulatorActor*> BatchedUpdates;
+
+    int32 NumAtLOD[3] = {};
+    uint32 FrameCounter = 0;
+};
@@ -0,0 +1,124 @@
+﻿// © 2025 UnrealStudy. All rights reserved.
+// Author: taru00@gmail.com | https://x.com/3devnote
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "HAL/Runnable.h"
+#include "Containers/Queue.h"
+#include "BallPredictionScene.generated.h"
+
+class UPrimitiveComponent;
+class UMeshComponent;
+class FRunnableThread;
+class FEvent;
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Prediction Scene Tasks"), STAT_BallPredictionSceneTasks, STATGROUP_Game);
+
+// 예측 월드 전용 워커 스레드
+// 시뮬레이션 작업 (Scene Query) 을 요청 순서대로 처리하므로 작업끼리는 항상 이 스레드에서 직렬화됨
+// 씬 스텝 (FPhysScene 프레임 진행) 은 게임 스레드에서만 하며, 워커가 쉬고 있을 때만 수행
+class BALLSIMULATOR_API FBallPredictionSceneWorker : public FRunnable
+{
+public:
+    explicit FBallPredictionSceneWorker(UWorld* InWorld);
+    virtual ~FBallPredictionSceneWorker();
+
+    bool Start();
+    void Shutdown();
+
+    void Enqueue(TUniqueFunction<void(UWorld*)> Work, TUniqueFunction<void()> OnComplete);
+    void Flush();
+
+    // 대기 중이거나 실행 중인 작업이 없음 (작업은 게임 스레드에서만 추가하므로 게임 스레드에서 본 값은 다음 Enqueue 전까지 유지됨)
+    bool IsIdle() const { return NumPendingTasks == 0; }
+
+    // FRunnable
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+
+private:
+    struct FTask
+    {
+        TUniqueFunction<void(UWorld*)> Work;
+        TUniqueFunction<void()> OnComplete;
+    };
+
+    void ProcessTasks();
+
+    UWorld* World = nullptr;
+    FRunnableThread* Thread = nullptr;
+    FEvent* WakeEvent = nullptr;
+    TAtomic<bool> bStopRequested;
+    TAtomic<int32> NumPendingTasks;
+
+    TQueue<FTask, EQueueMode::Mpsc> Tasks;
+};
+
+// 예측 전용 물리 씬
+// 게임 월드의 정적 충돌체를 복사한 별도 월드(물리 씬)를 가지고, 전용 워커 스레드에서 시뮬레이션을 처리한다.
+// 씬 스텝은 충돌체 복사 직후 게임 스레드에서 수행 (정적 충돌체뿐이므로 이후 스텝은 필요 없음)
+// 예측 Sweep 은 이 씬에만 수행되므로 게임 월드의 물리 락, Scene Query 예산과 경쟁하지 않음
+UCLASS()
+class BALLSIMULATOR_API UBallPredictionScene : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+    virtual void OnWorldBeginPlay(UWorld& InWorld) override;
+    virtual void Deinitialize() override;
+
+    // 게임 월드의 정적 충돌체를 다시 복사 (레벨 스트리밍 후 등), 진행 중인 작업이 끝날 때까지 대기함
+    UFUNCTION(BlueprintCallable, Category = "Ballistic Physics Simulator")
+    void RefreshStaticCollision();
+
+    // 게임 스레드에서 씬 스텝, 워커가 작업 중이면 예측 월드를 쓰는 중이므로 건너뜀 (대기하지 않음)
+    UFUNCTION(BlueprintCallable, Category = "Ballistic Physics Simulator")
+    void RequestStep(float DeltaTime);
+
+    // 복사하지 못한 Block 충돌체가 있으면 예측 결과가 게임 월드와 달라지므로 준비되지 않은 것으로 취급 (게임 월드 Sweep 으로 대체)
+    UFUNCTION(BlueprintPure, Category = "Ballistic Physics Simulator")
+    bool IsReady() const { return PredictionWorld != nullptr && Worker.IsValid() && NumSkippedComponents == 0; }
+
+    UFUNCTION(BlueprintPure, Category = "Ballistic Physics Simulator")
+    int32 GetNumCopiedComponents() const { return NumCopiedComponents; }
+
+    // 형상을 복사할 수 없어 빠진 Block 충돌체 수 (BSP, 랜드스케이프 등)
+    UFUNCTION(BlueprintPure, Category = "Ballistic Physics Simulator")
+    int32 GetNumSkippedComponents() const { return NumSkippedComponents; }
+
+    UWorld* GetPredictionWorld() const { return PredictionWorld; }
+
+    // 워커 스레드에서 Task 실행 후 게임 스레드에서 OnComplete 호출, 게임 스레드에서만 호출
+    // Task 안에서는 예측 월드에 대한 Scene Query 만 허용 (씬 스텝, 액터/컴포넌트 생성, 게임 월드 접근 금지)
+    void EnqueueTask(TUniqueFunction<void(UWorld*)> Task, TUniqueFunction<void()> OnComplete);
+
+    // 대기 중인 작업이 모두 끝날 때까지 게임 스레드를 막음
+    // 결과를 바로 돌려주는 동기 API 와 충돌체 교체에서만 사용, 프레임마다 쓰는 경로는 EnqueueTask 의 OnComplete 로 결과를 받음
+    void Flush();
+
+private:
+    // 워커와 예측 월드가 살아 있음 (복사 누락 여부와 무관, 내부 작업 전달용)
+    bool IsRunning() const { return PredictionWorld != nullptr && Worker.IsValid(); }
+
+    // 게임 스레드 전용, 워커가 쉬고 있을 때만 호출
+    static void StepScene(UWorld* World, float DeltaTime);
+
+    void CreatePredictionWorld();
+    void DestroyPredictionWorld();
+    void CopyStaticCollision(UWorld* SourceWorld);
+    static bool ShouldCopyComponent(const UPrimitiveComponent* Component);
+    static void CopyMaterials(const UMeshComponent* Source, UMeshComponent* Clone);
+
+    UPROPERTY(Transient)
+    UWorld* PredictionWorld = nullptr;
+
+    UPROPERTY(Transient)
+    AActor* CollisionHolder = nullptr;
+
+    TUniquePtr<FBallPredictionSceneWorker> Worker;
+    int32 NumCopiedComponents = 0;
+    int32 NumSkippedComponents = 0;
+};
@@ -0,0 +1,312 @@
+﻿// © 2025 UnrealStudy. All rights reserved.
+// Author: taru00@gmail.com | https://x.com/3devnote
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CollisionShape.h"
+#include "CollisionQueryParams.h"
+#include "Chaos/ChaosEngineInterface.h"
+#include "BallSimulatorTypes.h"
+#include "BallKinematicObstacle.h"
+
+class UWorld;
+class UPhysicalMaterial;
+class FBallDistanceField;
+struct FBallMovableProxy;
+class FBallCollisionCorridor;
+struct FBallContactInput;
+struct FBallContactResult;
+
+// 시뮬레이션 커널에서 컴파일 타임에 제거되는 기능 플래그
+// 조합별로 템플릿 커널이 인스턴스화 되며, 시뮬레이션 시작 시 한번 선택됨
+enum class EBallSimFeature : uint32
+{
+    None            = 0,
+    Magnus          = 1 << 0,   // 스핀에 의한 횡력
+    Damping         = 1 << 1,   // 선형/회전 감쇠
+    PhysMaterial    = 1 << 2,   // 충돌면 물리 재질의 마찰/탄성 사용
+    ImpulseClamp    = 1 << 3,   // MaxAllowedImpulse 제한
+    Obstacles       = 1 << 4,   // 키네마틱 장애물 충돌 검사
+    Aerodynamics    = 1 << 5,   // 항력 / 양력 계수 테이블 (선형 감쇠와 SpinMagnusFactor 대신 사용)
+
+    All             = (1 << 6) - 1,
+};
+ENUM_CLASS_FLAGS(EBallSimFeature);
+
+// 레이놀즈 수 × 스핀비 균일 격자로 구운 항력 / 양력 계수 (UBallPhysicsProfile 의 커브에서 로드 시 생성)
+// 격자 간격이 균일하므로 조회는 곱셈 두 번과 쌍선형 보간만 필요, 분기 없음
+struct FBallAeroTable
+{
+    float ReynoldsMin = 0.f;
+    float InvReynoldsStep = 0.f;
+    float InvSpinRatioStep = 0.f;
+    int32 NumReynolds = 2;
+    int32 NumSpinRatios = 2;
+
+    // [SpinRatioIndex * NumReynolds + ReynoldsIndex]
+    TArray<float> Drag;
+    TArray<float> Lift;
+
+    FORCEINLINE void Sample(float Reynolds, float SpinRatio, float& OutDrag, float& OutLift) const
+    {
+        const float X = FMath::Clamp((Reynolds - ReynoldsMin) * InvReynoldsStep, 0.f, (float)(NumReynolds - 1));
+        const float Y = FMath::Clamp(SpinRatio * InvSpinRatioStep, 0.f, (float)(NumSpinRatios - 1));
+        const int32 X0 = FMath::Min((int32)X, NumReynolds - 2);
+        const int32 Y0 = FMath::Min((int32)Y, NumSpinRatios - 2);
+        const float FX = X - X0;
+        const float FY = Y - Y0;
+
+        const int32 I00 = Y0 * NumReynolds + X0;
+        const int32 I01 = I00 + NumReynolds;
+        OutDrag = FMath::Lerp(FMath::Lerp(Drag[I00], Drag[I00 + 1], FX), FMath::Lerp(Drag[I01], Drag[I01 + 1], FX), FY);
+        OutLift = FMath::Lerp(FMath::Lerp(Lift[I00], Lift[I00 + 1], FX), FMath::Lerp(Lift[I01], Lift[I01 + 1], FX), FY);
+    }
+};
+
+// 충돌면 종류 하나의 응답 계수
+struct FBallSurfaceResponse
+{
+    float Restitution = 0.7f;
+    float Friction = 0.1f;
+
+    // 접촉마다 법선 축 회전 (팽이 회전) 에서 제거하는 비율 (0 ~ 1)
+    float SpinFriction = 0.f;
+
+    // 슬라이딩 (구름) 접촉 중 선속도 감속 비율 (1/s)
+    float RollingResistance = 0.f;
+
+    // 바운스 시 각속도 배율
+    float BounceSpinMultiplier = 0.65f;
+
+    // 프로파일에 지정되지 않은 종류, 충돌면 물리 재질의 Friction / Restitution 사용
+    bool bUseMaterial = true;
+};
+
+// 충돌면 종류 (EPhysicalSurface) 로 인덱싱되는 응답 표 (UBallPhysicsProfile::SurfaceResponses 에서 로드 시 생성)
+// 충돌마다 물리 재질 속성을 읽고 분기하는 대신 충돌면 ID 로 한번만 조회
+struct FBallSurfaceTable
+{
+    FBallSurfaceResponse Responses[SurfaceType_Max];
+
+    FORCEINLINE const FBallSurfaceResponse& Get(uint8 SurfaceId) const { return Responses[SurfaceId]; }
+};
+
+struct FBallSimConstants;
+
+// 작업 하나가 만난 물리 재질별 충돌면 종류와 응답 (FBallSimContext::SurfaceCache)
+// 처음 만난 재질만 해석해서 속성을 읽고, 이후 충돌은 재질 핸들 비교와 복사만 수행 (작업 하나가 만나는 재질은 몇 개뿐)
+struct BALLSIMULATOR_API FBallSurfaceCache
+{
+    struct FEntry
+    {
+        TWeakObjectPtr<UPhysicalMaterial> Material;
+        FBallSurfaceResponse Response;
+        uint8 SurfaceId = SurfaceType_Default;
+    };
+
+    const FEntry& Resolve(const FBallSimConstants& Constants, const TWeakObjectPtr<UPhysicalMaterial>& Material);
+
+    // 캐시 없이 해석, 표에 없는 종류는 재질의 Friction / Restitution, 재질이 없으면 상수의 기본값
+    static FEntry MakeEntry(const FBallSimConstants& Constants, const TWeakObjectPtr<UPhysicalMaterial>& Material);
+
+    void Reset() { Entries.Reset(); }
+
+private:
+    TArray<FEntry, TInlineAllocator<8>> Entries;
+};
+
+// 시뮬레이션 시작 시 한번 계산되는 튜닝 상수 (스텝마다 UPROPERTY 를 읽지 않도록 복사해서 사용)
+struct FBallSimConstants
+{
+    FVector3f Gravity = FVector3f(0, 0, -980.0f);
+    float StepInterval = 0.033f;
+
+    float LinearDamping = 0.05f;
+    float AngularDamping = 0.1f;
+
+    // StepInterval 기준으로 미리 계산된 감쇠 배율 (SubStep 이 아닌 전체 Step 에서 사용)
+    float LinearDampingStepScale = 1.f;
+    float AngularDampingStepScale = 1.f;
+
+    float MinSpinForMagnus = 10.f;
+    float SpinMagnusFactor = 0.01f;
+
+    // Aerodynamics 기능용, 프로파일이 소유한 테이블을 공유 (시뮬레이션 중 다시 구워져도 유지)
+    TSharedPtr<const FBallAeroTable, ESPMode::ThreadSafe> AeroTable;
+
+    // 속도 (cm/s) 에 곱하면 레이놀즈 수
+    float ReynoldsPerSpeed = 0.f;
+
+    // 0.5 * ρ * A / m (1/cm), 계수 × 속도² 에 곱하면 가속도
+    float AeroForceScale = 0.f;
+
+    // 충돌면 종류별 응답, 프로파일이 소유한 표를 공유 (nullptr 이면 물리 재질 또는 Default 값 사용)
+    TSharedPtr<const FBallSurfaceTable, ESPMode::ThreadSafe> SurfaceTable;
+
+    float BouncedSpinMultiplier = 0.65f;
+    float SpinToRotateMultiply = 1.0f;
+    float DefaultRestitution = 0.7f;
+    float DefaultFriction = 0.1f;
+    float MaxAllowedImpulse = 1000.f;
+    float BounceThreshold = 10.f;
+
+    // 같은 스텝의 연속 충돌 또는 침투 시 이 거리 (cm) 안의 접촉을 모아서 동시에 해결, 반복 횟수가 0 이면 기존 재귀 처리
+    float ContactSkin = 0.5f;
+    int32 ContactSolverIterations = 4;
+
+    // 강체 물리로 넘기는 조건, 기본값은 모두 비활성 (전체 스텝 시뮬레이션)
+    bool bStopOnRollingContact = false;
+    float MinSpeed = 0.f;
+    int32 MaxAllowedBounce = -1;
+
+    float Radius = 11.f;
+    float InvMass = 1.f;
+    FVector3f InvInertiaTensor = FVector3f::OneVector;
+
+    // 질량, 반지름, 관성 텐서 스케일로 InvMass, InvInertiaTensor 계산 및 감쇠 배율 갱신
+    BALLSIMULATOR_API void SetMassProperties(float BallMass, float BallRadius, const FVector& InertiaTensorScale);
+    BALLSIMULATOR_API void UpdateStepScales();
+};
+
+// 적분 대상 상태 + 접촉 이력 (재시뮬레이션/검증 시 이 값만으로 이어서 진행 가능해야 함)
+// 위치는 FBallSimContext::Origin 기준 단정밀도, 비행 거리 200 m 이내에서 위치 양자화 오차는 0.01 mm 이하
+// 월드 좌표는 Scene Query 와 블루프린트 경계에서만 사용 (FBallSimContext::ToWorld / ToLocal)
+struct FBallSimState
+{
+    FVector3f Position = FVector3f::ZeroVector;
+    FQuat4f Rotation = FQuat4f::Identity;
+    FVector3f LinearVelocity = FVector3f::ZeroVector;
+    FVector3f AngularVelocity = FVector3f::ZeroVector;
+
+    // 현재 (Sub)Step 의 시작 시간 (시뮬레이션 시작 기준)
+    float Time = 0.f;
+
+    // 마지막으로 기록된 스냅샷 인덱스
+    int32 StepIndex = 0;
+
+    int32 BounceCount = 0;
+    int32 LastBounceIndex = INDEX_NONE;
+
+    // 슬라이딩 접촉 상태 확인용
+    float PreviousHitTime = 0.f;
+    FVector3f PreviousHitNormal = FVector3f::ZeroVector;
+
+    // 아직 Rotation 에 반영하지 않은 회전 (축이 바뀌거나 키프레임 기록 시 FlushRotation 으로 반영)
+    // 접촉 사이에서는 감쇠만 있으므로 축이 유지되고 회전각만 누적하면 됨
+    FVector3f PendingSpinAxis = FVector3f::ZeroVector;
+    float PendingSpinAngle = 0.f;
+
+    // None 이 아니면 Run 이 더 이상 진행하지 않음, 이때 상태는 마지막 스냅샷 시점의 정확한 상태
+    EBallHandoffReason HandoffReason = EBallHandoffReason::None;
+};
+
+// 재시뮬레이션 시작점, 이 시점까지의 출력 버퍼 길이를 함께 가짐
+// State 는 FBallSimContext::Origin 기준
+struct FBallSimCheckpoint
+{
+    FBallSimState State;
+    int32 NumSnapshots = 0;
+    int32 NumHits = 0;
+    int32 NumBounces = 0;
+    int32 NumRotationKeys = 0;
+    int32 NumEvents = 0;
+};
+
+// 커널 호출 시 변하지 않는 입력과 출력 버퍼
+struct FBallSimContext
+{
+    UWorld* World = nullptr;
+    FCollisionShape CollisionShape;
+    FCollisionQueryParams QueryParams = FCollisionQueryParams(FName(TEXT("BallSimSweep")), true);
+    FBallSimConstants Constants;
+
+    // 연속 충돌(MultiHit) 판정용 월드 시간
+    float WorldTime = 0.f;
+
+    // 샷 원점 (보통 발사 위치), 상태와 출력 버퍼 (이벤트 제외) 는 이 위치 기준 단정밀도
+    FVector Origin = FVector::ZeroVector;
+
+    FORCEINLINE FVector ToWorld(const FVector3f& Local) const { return Origin + FVector(Local); }
+    FORCEINLINE FVector3f ToLocal(const FVector& World) const { return FVector3f(World - Origin); }
+
+    const FBallObstacleSet* Obstacles = nullptr;
+
+    // 정적 충돌체 거리장과 움직이는 충돌체 경계 구, 여유 거리가 이번 SubStep 이동 거리 + 반지름보다 크고 경계 구와 닿지 않으면 Sweep 생략
+    // 둘 중 하나라도 nullptr 이면 항상 Sweep
+    const FBallDistanceField* DistanceField = nullptr;
+    const TArray<FBallMovableProxy>* MovableProxies = nullptr;
+
+    // nullptr 이 아니면 월드 Sweep 대신 예상 경로 주변에서 미리 모은 충돌체에만 Sweep (벗어나면 다시 모음)
+    FBallCollisionCorridor* Corridor = nullptr;
+
+    // nullptr 이 아니면 재질별 충돌면 응답을 한번만 계산, 충돌마다 갱신되므로 병렬로 진행하는 상태끼리 공유하지 않음
+    FBallSurfaceCache* SurfaceCache = nullptr;
+
+    // nullptr 이면 기록 생략 (배치 경로에서 최종 상태만 필요한 경우)
+    TArray<FBallSimSnapshot>* Snapshots = nullptr;
+    TArray<FBallSimBounce>* Hits = nullptr;
+    TArray<FBallSimBounce>* Bounces = nullptr;
+
+    // RotationKeyInterval 스텝마다 회전 키프레임 기록
+    TArray<FBallRotationKey>* RotationKeys = nullptr;
+    int32 RotationKeyInterval = 16;
+
+    // CheckpointInterval 스텝마다 Run 이 체크포인트 기록 (0 이면 기록 안함)
+    TArray<FBallSimCheckpoint>* Checkpoints = nullptr;
+    int32 CheckpointInterval = 0;
+
+    // nullptr 이 아니면 Step 마다 이벤트 (최고점, 바운스, 트리거 통과 등) 기록, EventQuery 의 정지 조건을 만족하면 종료
+    // 이벤트는 정지 조건 (StopPredicate) 과 블루프린트에서 바로 쓰도록 월드 기준으로 기록
+    TArray<FBallSimEvent>* Events = nullptr;
+    const FBallSimEventQuery* EventQuery = nullptr;
+};
+
+// 기능 조합별로 특수화된 커널 함수 묶음
+struct BALLSIMULATOR_API FBallSimKernel
+{
+    // 한 Step 진행 (충돌, 마그누스, 회전, 스냅샷 기록), 이번 Step 의 Hit 수 반환
+    int32 (*Step)(const FBallSimContext& Context, FBallSimState& State) = nullptr;
+
+    // State.StepIndex 가 LastStep 에 도달하거나 HandoffReason 이 설정될 때까지 Step 반복
+    void (*Run)(const FBallSimContext& Context, FBallSimState& State, int32 LastStep) = nullptr;
+
+    // 중력, 감쇠, Sweep 및 충돌 응답 (재귀 SubStep)
+    int32 (*HandleCollision)(const FBallSimContext& Context, FBallSimState& State, float DeltaTime, int32 Depth) = nullptr;
+
+    EBallSimFeature Features = EBallSimFeature::None;
+
+    static const FBallSimKernel& Get(EBallSimFeature Features);
+
+    // 초기 상태를 스냅샷과 회전 키프레임으로 기록
+    static void RecordInitialSnapshot(const FBallSimContext& Context, const FBallSimState& State);
+
+    // 현재 상태와 출력 버퍼 길이를 체크포인트로 기록
+    static void RecordCheckpoint(const FBallSimContext& Context, const FBallSimState& State);
+
+    // Step 시작 상태와 끝 상태를 비교해서 이벤트 기록, 정지 조건을 만족하면 HandoffReason = StopEvent
+    // PreviousBounceIndex 는 Step 전의 State.LastBounceIndex (슬라이딩 시작 판정용)
+    static void DetectEvents(const FBallSimContext& Context, FBallSimState& State, const FVector3f& StartPosition, const FVector3f& StartVelocity, int32 NumHitsBefore, int32 PreviousBounceIndex);
+
+    // 각속도 (rad/s) 로 DeltaTime 동안 회전, 지수 사상으로 정확히 적분
+    static void ApplySpinToRotation(const FVector3f& AngularVelocity, float DeltaTime, FQuat4f& InOutRotation);
+
+    // 누적된 회전각을 State.Rotation 에 반영
+    static void FlushRotation(FBallSimState& State);
+
+    // 같은 종류의 두 공 사이 접촉 응답, HandleCollision 과 같은 임펄스 / 쿠롱 마찰 모델에 상대 공의 질량과 관성을 더한 형태
+    // Normal 은 B 에서 A 로 향하는 접촉 법선, 두 공은 접촉 위치에 있어야 함, 적용한 법선 임펄스 크기 반환 (멀어지는 중이면 0)
+    static float ResolveBallContact(const FBallSimConstants& Constants, EBallSimFeature Features, FBallSimState& A, FBallSimState& B, const FVector3f& Normal);
+
+    // ResolveBallContact 를 FBallContactBatch 로 묶어서 계산할 때 사용, 입력 구성과 결과 적용 (적용한 법선 임펄스 크기 반환)
+    static FBallContactInput MakeBallContactInput(const FBallSimConstants& Constants, EBallSimFeature Features, const FBallSimState& A, const FBallSimState& B, const FVector3f& Normal);
+    static float ApplyBallContact(const FBallSimConstants& Constants, FBallSimState& A, FBallSimState& B, const FVector3f& Normal, const FBallContactResult& Result);
+
+    // Time 시점의 회전을 가장 가까운 이전 키프레임부터 스냅샷 각속도로 적분해서 복원
+    // Snapshots[i] 는 Step i 의 결과여야 함 (시작 상태부터 기록된 궤적)
+    static FQuat ReconstructRotation(
+        TArrayView<const FBallSimSnapshot> Snapshots,
+        TArrayView<const FBallRotationKey> RotationKeys,
+        float StepInterval,
+        float Time);
+};
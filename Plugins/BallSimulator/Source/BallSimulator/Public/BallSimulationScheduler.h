@@ -0,0 +1,91 @@
+﻿// © 2025 UnrealStudy. All rights reserved.
+// Author: taru00@gmail.com | https://x.com/3devnote
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "UObject/ObjectKey.h"
+#include "BallSimKernel.h"
+#include "BallSimulationScheduler.generated.h"
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Scheduler Queue Depth"), STAT_BallSchedulerQueueDepth, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Scheduler Steps"), STAT_BallSchedulerSteps, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Scheduler Completed"), STAT_BallSchedulerCompleted, STATGROUP_Game);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Scheduler Dropped"), STAT_BallSchedulerDropped, STATGROUP_Game);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Scheduler Budget (ms)"), STAT_BallSchedulerBudget, STATGROUP_Game);
+DECLARE_FLOAT_COUNTER_STAT(TEXT("Scheduler Budget Used (ms)"), STAT_BallSchedulerBudgetUsed, STATGROUP_Game);
+
+UENUM(BlueprintType)
+enum class EBallSimRequestStatus : uint8
+{
+    Completed,
+    Coalesced,      // 같은 키의 새 요청으로 대체됨
+    Expired,        // 기한까지 끝나지 않음
+    Cancelled,
+};
+
+// 스케줄러에 제출하는 시뮬레이션 요청
+// Context 의 출력 버퍼는 요청자가 소유하며 OnComplete 호출 전까지 유지되어야 함 (보통 OnComplete 가 캡처해서 유지)
+struct FBallSimSchedulerRequest
+{
+    FBallSimContext Context;
+    FBallSimState State;
+    EBallSimFeature Features = EBallSimFeature::All;
+    int32 LastStep = 0;
+
+    // 클수록 먼저 진행
+    int32 Priority = 0;
+
+    // 월드 시간 (초), 이 시간까지 끝나지 않으면 Expired 로 버림, 0 이하이면 기한 없음
+    double Deadline = 0.0;
+
+    // 유효하면 같은 키로 대기 중인 이전 요청을 Coalesced 로 대체 (조준 미리보기처럼 최신 결과만 필요한 경우)
+    FObjectKey CoalesceKey;
+
+    // 게임 스레드에서 호출, Completed 일 때 State 는 최종 상태
+    TFunction<void(const FBallSimSchedulerRequest& Request, EBallSimRequestStatus Status)> OnComplete;
+};
+
+// 프레임 예산 기반 시뮬레이션 스케줄러
+// 여러 시스템 (AI 평가, 조준 미리보기, 리플레이, 앙상블) 의 요청을 우선순위, 기한 순으로 정렬해서
+// 프레임당 BallSim.Scheduler.BudgetMs 안에서 스텝 단위 조각으로 나누어 진행한다. (게임 스레드, 게임 월드 Sweep)
+UCLASS()
+class BALLSIMULATOR_API UBallSimulationScheduler : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+
+    // 요청 핸들 반환 (Cancel 용)
+    int32 Submit(FBallSimSchedulerRequest&& Request);
+
+    bool Cancel(int32 Handle);
+
+    UFUNCTION(BlueprintPure, Category = "Ballistic Physics Simulator")
+    int32 GetQueueDepth() const { return Queue.Num(); }
+
+    // 마지막 Tick 에서 사용한 시간 (ms)
+    UFUNCTION(BlueprintPure, Category = "Ballistic Physics Simulator")
+    float GetLastBudgetUsedMs() const { return LastBudgetUsedMs; }
+
+private:
+    struct FEntry
+    {
+        int32 Handle = 0;
+        FBallSimSchedulerRequest Request;
+    };
+
+    // 큐에서 제거된 뒤 호출할 콜백 (콜백 안에서 다시 Submit 할 수 있도록 순회가 끝난 후 호출)
+    void Complete(FEntry&& Entry, EBallSimRequestStatus Status);
+    void FlushCompletions();
+
+    TArray<FEntry> Queue;
+    TArray<TPair<FEntry, EBallSimRequestStatus>> Completions;
+
+    int32 NextHandle = 1;
+    float LastBudgetUsedMs = 0.f;
+};
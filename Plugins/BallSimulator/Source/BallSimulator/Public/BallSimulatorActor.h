@@ -8,7 +8,7 @@
 #include "Components/SplineComponent.h"
 #include "Components/SphereComponent.h"
 #include "BallSimulatorComponent.h"
-//#include "Chaos/ChaosSolver.h"
+#include "BallPlaybackLOD.h"
 #include "BallSimulatorActor.generated.h"
 
 UCLASS()
@@ -20,6 +20,7 @@ public:
     void Tick(float DeltaTime);
 
     virtual void BeginPlay();
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
     UFUNCTION(CallInEditor, BlueprintCallable, Category = "Ball Physics Simulator")
     void SimulateBallPhysics(
@@ -32,9 +33,40 @@ public:
         float StepInterval,
         TArray<FBallSnapshot>& OutSnapshots);
 
+    // 세트피스 발사 조건으로 이 액터만 시뮬레이션하고 스플라인 갱신
+    UFUNCTION(CallInEditor, BlueprintCallable, Category = "Ball Physics Simulator|Set Piece")
+    void SimulateSetPiece();
+
+    // 레벨의 모든 시뮬레이터 액터 세트피스를 병렬로 다시 생성 (튜닝 변경 후), 진행률 표시와 취소 지원
+    UFUNCTION(CallInEditor, Category = "Ball Physics Simulator|Set Piece")
+    void RegenerateLevelSetPieces();
+
+    // Actors 의 세트피스를 워커 스레드에서 병렬로 생성, 액터마다 작업이 끝나는 대로 스플라인 갱신, 완료된 액터 수 반환
+    static int32 RegenerateSetPieces(UWorld* World, TArrayView<ABallSimulatorActor* const> Actors);
+
+    // 마지막 시뮬레이션 결과를 처음부터 재생, Handoff 상태로 끝난 경우 그 시점에 SimSphereComp 강체 물리로 전환
+    UFUNCTION(BlueprintCallable, Category = "Ball Physics Simulator")
+    void PlayTrajectory();
+
+    UFUNCTION(BlueprintCallable, Category = "Ball Physics Simulator")
+    void StopTrajectory();
+
+    // 재생 시간 갱신 후 메시 이동, bFullFidelity 가 아니면 감소 궤적 위치만 갱신 (회전 생략), 재생이 끝나면 false
+    bool UpdatePlayback(bool bFullFidelity);
+
+    // Near 는 액터 Tick 으로 매 프레임 갱신, 그 외는 UBallPlaybackLODSubsystem 이 낮은 빈도로 일괄 갱신
+    void SetPlaybackLOD(EBallPlaybackLOD LOD);
+
+    EBallPlaybackLOD GetPlaybackLOD() const { return PlaybackLOD; }
+    FVector GetBallLocation() const { return BallMeshComp->GetComponentLocation(); }
+    float GetBallRadius() const { return SimulatedRadius; }
+
+    // BallSimulatorComp 가 bUsePredictionScene 이면 예측 전용 물리 씬 (UBallPredictionScene) 연결, BeginPlay 에서 호출됨
     void InitializeSimPhysicsScene();
+
+    // 예측 씬 스텝 요청, 워커가 작업 중이면 건너뜀 (게임 스레드는 대기하지 않음)
     void StepSimPhysicsScene(float DeltaTime);
-    
+
 
 protected:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
@@ -58,10 +90,45 @@ protected:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
     float PlaybackTime;
 
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    EBallPlaybackLOD PlaybackLOD = EBallPlaybackLOD::Near;
+
+    // 예측 전용 월드, 게임 월드의 정적 충돌체 복사본을 가짐 (UBallPredictionScene 소유)
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
     UWorld* SimWorld;
 
-    // 별도 Physics 씬 멤버 변수
-    //TUniquePtr<FPhysScene_Chaos> SimPhysicsScene;
-    //TUniquePtr<FChaosSolver> SimSolver;
+    // 축구공 질량 (kg)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float BallMass = 0.43f;
+
+    // 세트피스 발사 조건 (월드 기준), SimulateSetPiece / RegenerateLevelSetPieces 에서 사용
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ball Physics Simulator|Set Piece")
+    FBallLaunchParams SetPieceLaunch;
+
+    // 세트피스 구체 반지름 (cm)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ball Physics Simulator|Set Piece", meta = (ClampMin = "0.1"))
+    float SetPieceRadius = 11.f;
+
+    // 세트피스 시뮬레이션 길이 (초)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ball Physics Simulator|Set Piece", meta = (ClampMin = "0"))
+    float SetPieceSimulationTime = 3.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ball Physics Simulator|Set Piece", meta = (ClampMin = "0.001"))
+    float SetPieceStepInterval = 0.033f;
+
+    // 강체 물리로 전환된 상태, 전환 전까지 SimSphereComp 는 충돌/바디 없음
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    bool bIsPhysicsHandedOff = false;
+
+private:
+    // 마지막 SimulateBallPhysics 의 구체 반지름, Handoff 시 강체 반지름으로 사용
+    float SimulatedRadius = 11.f;
+
+    // 재생 시작 월드 시간, LOD 별 갱신 빈도와 무관하게 재생 시간은 여기서 계산
+    float PlaybackStartTime = 0.f;
+
+    void FinishPlayback();
+
+    void HandoffToPhysics();
+    void ResetToKinematic();
 };
@@ -6,140 +6,30 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "Components/SplineComponent.h"
+#include "BallSimKernel.h"
+#include "BallTrajectoryLog.h"
+#include "BallTrajectoryValidator.h"
+#include "BallTrajectorySampler.h"
+#include "BallTrajectory.h"
 #include "BallSimulatorComponent.generated.h"
 
-DECLARE_CYCLE_STAT(TEXT("Ballistic Physics Simulator"), STAT_BallPhysicsSimulation, STATGROUP_Game);
-DECLARE_CYCLE_STAT(TEXT("HandleCollision"), STAT_HandleCollision, STATGROUP_Game);
-
-USTRUCT(BlueprintType)
-struct FBallBounce
-{
-    GENERATED_BODY()
-
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
-    int SnapshotIndex;
+class UBallPhysicsProfile;
+class UBallPredictionScene;
+struct FBallSimulationJob;
 
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
-    FVector Direction;
+DECLARE_DYNAMIC_MULTICAST_DELEGATE(FOnBallSimulationComplete);
 
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
-    float Speed;
-
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
-    float Spin;
-    
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
-    FVector AngularVelocity;
-
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
-    FVector BouncedDirection;
-
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
-    float BouncedSpeed;
-    
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
-    float BouncedSpin;   
-
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
-    FVector BouncedAngularVelocity;
-    
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
-    bool bWasStuck;
-
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
-    bool bIsSliding;
-    
-    UPROPERTY(BlueprintReadOnly)
-    FHitResult Hit;
-
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
-    FVector StartPos;
-
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
-    FVector ImpactPoint;
-    
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
-    FVector ImpactNormal;
-
-    // 이번 충돌에 대한 반사 후 추가 충돌이 없을때 사용될 NextPos 후보
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
-    FVector NextPos;
-    
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
-    float TimeToBeforeHit;
-
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
-    float RemainingTime;
-
-    // 접촉점의 상대 속도 ContactVelocity를 히트 노멀 방향 으로 프로젝션해서 얻은 값
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
-    float vRel;
-    
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
-    FVector NormalImpulse;
-
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
-    FVector FrictionImpulse;
-    
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
-    FVector LinearImpulse;
-
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
-    FVector AngularDelta;
-
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
-    float AngularDeltaSize;
-
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
-    FVector FrictionDelta;
-
-    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
-    float PenetrationDepth;
-};
-
-USTRUCT(BlueprintType)
-struct FBallSnapshot
+// SimulateLaunchesParallel 의 발사 하나, Simulator 의 튜닝으로 준비하고 끝나면 Simulator 의 마지막 결과로 반영
+struct FBallParallelLaunch
 {
-    GENERATED_BODY()
-
-	// 디버깅 편의를 위해 저장된 시간값 (고정 프레임율 이므로 시간 간격은 일정함)
-    UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
-    float Time;
-
-    UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
-    FVector Position;
-
-    UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
-    FQuat Rotation;
-
-    // Direction * Speed
-    //UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
-    //FVector LinearVeloticy;
-
-    UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
-    FVector Direction;
-
-    // 축구 기준 2000 cm/s ~ 4000 cm/s or 70 km/h ~ 145 km/h  (100 cm/s = 3.6 km/h)
-    UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
-    float Speed;
-    
-    // SpinAxis * SpinSpeed
-    //UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
-    //FVector AngularVelocity;
-    UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
-    int hitCount;
-
-    UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
-    int BounceIndex;
-
-    UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
-    FVector SpinAxis;
-
-    // 축구 회전 킥 기준 20~90 rad/s
-    UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
-    float SpinSpeed;
+    UBallSimulatorComponent* Simulator = nullptr;
+    FBallLaunchParams Launch;
+    FBallSimSettings Settings;
 };
 
+DECLARE_CYCLE_STAT(TEXT("Ballistic Physics Simulator"), STAT_BallPhysicsSimulation, STATGROUP_Game);
+DECLARE_CYCLE_STAT(TEXT("HandleCollision"), STAT_HandleCollision, STATGROUP_Game);
+
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class BALLSIMULATOR_API UBallSimulatorComponent : public UActorComponent
 {
@@ -171,6 +61,140 @@ public:
         const int32 SimulationSteps,
         const float StepInterval);
 
+    // 발사 조건, 공 설정 구조체를 받는 진입점 (스칼라 인자 버전은 이 경로로 전달)
+    UFUNCTION(BlueprintCallable, Category = "Ballistic Physics Simulator", meta = (WorldContext = "Outer"))
+    void SimulateLaunch(const UObject* WorldContextObject, const FBallLaunchParams& Launch, const FBallSimSettings& Settings);
+
+    // 여러 발사를 이 컴포넌트의 튜닝으로 한번의 호출에서 시뮬레이션 (블루프린트 훈련 장면 등), 컴포넌트의 마지막 결과는 바꾸지 않음
+    // 결과는 배열 복사 없이 핸들로 반환 (UBallTrajectoryLibrary 로 조회), 예측 씬이 있으면 워커 스레드에서 한 작업으로 진행
+    // 예측 씬 작업 안에서는 예측 월드를 워커 스레드에서만 접근하도록 발사를 차례로, 예측 씬이 없으면 발사별로 병렬 진행 (파라미터 그리드)
+    // 결과를 바로 반환하므로 모든 발사가 끝날 때까지 게임 스레드는 대기함
+    UFUNCTION(BlueprintCallable, Category = "Ballistic Physics Simulator", meta = (WorldContext = "Outer"))
+    void SimulateLaunches(
+        const UObject* WorldContextObject,
+        const TArray<FBallLaunchParams>& Launches,
+        const FBallSimSettings& Settings,
+        TArray<FBallTrajectoryHandle>& OutTrajectories);
+
+    // 예측 씬 워커 스레드에서 시뮬레이션 후 게임 스레드에서 결과 반영, OnSimulationComplete 호출
+    // 예측 씬을 쓰지 않거나 (bUsePredictionScene) 준비되지 않은 월드에서는 동기 경로로 처리, 완료 전에 다시 호출하면 이전 요청 결과는 버려짐
+    UFUNCTION(BlueprintCallable, Category = "Ballistic Physics Simulator", meta = (WorldContext = "Outer"))
+    void SimulateBallPhysicsAsync(
+        const UObject* WorldContextObject,
+        const float BallMass,
+        const float BallRadius,
+        const FVector& InitialPosition,
+        const FQuat& InitialRotation,
+        const FVector& InitialDirection,
+        const float InitialSpeed,
+        const FVector& InitialSpinAxis,
+        const float InitialSpinSpeed,
+        const int32 SimulationSteps,
+        const float StepInterval);
+
+    // UBallSimulationScheduler 에 제출해서 프레임 예산 안에서 나누어 진행, 완료되면 OnSimulationComplete 호출
+    // MaxLatency (초) 안에 끝나지 않으면 버려짐 (0 이하이면 기한 없음), 같은 컴포넌트의 이전 대기 요청은 대체됨, 요청 핸들 반환
+    UFUNCTION(BlueprintCallable, Category = "Ballistic Physics Simulator", meta = (WorldContext = "Outer"))
+    int32 SimulateBallPhysicsScheduled(
+        const UObject* WorldContextObject,
+        const float BallMass,
+        const float BallRadius,
+        const FVector& InitialPosition,
+        const FQuat& InitialRotation,
+        const FVector& InitialDirection,
+        const float InitialSpeed,
+        const FVector& InitialSpinAxis,
+        const float InitialSpinSpeed,
+        const int32 SimulationSteps,
+        const float StepInterval,
+        const int32 Priority = 0,
+        const float MaxLatency = 0.f);
+
+    // ChangeTime 이후에 영향을 주는 변경 (장애물 이동, 조준 조정 등) 이 생겼을 때 그 이전 마지막 체크포인트부터 재시뮬레이션
+    // 체크포인트 이후 결과만 새로 계산해서 기존 궤적 뒤에 이어 붙임, 재개한 스텝 번호 반환
+    UFUNCTION(BlueprintCallable, Category = "Ballistic Physics Simulator", meta = (WorldContext = "Outer"))
+    int32 ResimulateFromTime(const UObject* WorldContextObject, const float ChangeTime);
+
+    // 변경된 영역을 궤적이 처음 지나는 스텝부터 재시뮬레이션, 지나지 않으면 INDEX_NONE
+    UFUNCTION(BlueprintCallable, Category = "Ballistic Physics Simulator", meta = (WorldContext = "Outer"))
+    int32 ResimulateInBounds(const UObject* WorldContextObject, const FBox& ChangedBounds);
+
+    // 마지막 시뮬레이션의 체크포인트와 바운스로 서버에 제출할 궤적 구성 (클라이언트)
+    UFUNCTION(BlueprintCallable, Category = "Ballistic Physics Simulator")
+    bool MakeClaimedTrajectory(FBallClaimedTrajectory& OutClaim) const;
+
+    // 클라이언트가 제안한 궤적을 발사 조건과 이 컴포넌트의 튜닝, 서버의 StepInterval 로 구간별 병렬 검증 (서버)
+    // 전체를 재시뮬레이션하지 않고 체크포인트 구간마다 독립적으로 진행, 처음 어긋난 구간에서 거부
+    UFUNCTION(BlueprintCallable, Category = "Ballistic Physics Simulator", meta = (WorldContext = "Outer"))
+    FBallValidationResult ValidateClaimedTrajectory(
+        const UObject* WorldContextObject,
+        const float BallMass,
+        const float BallRadius,
+        const FVector& InitialPosition,
+        const FVector& InitialDirection,
+        const float InitialSpeed,
+        const FVector& InitialSpinAxis,
+        const float InitialSpinSpeed,
+        const float StepInterval,
+        const FBallClaimedTrajectory& Claim);
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ballistic Physics Simulator")
+    FBallValidationSettings ValidationSettings;
+
+    UFUNCTION(BlueprintPure, Category = "Ballistic Physics Simulator")
+    bool IsSimulationPending() const { return bSimulationPending; }
+
+    UPROPERTY(BlueprintAssignable, Category = "Ballistic Physics Simulator")
+    FOnBallSimulationComplete OnSimulationComplete;
+
+    // 마지막 시뮬레이션이 강체 물리로 넘겨야 하는 상태로 끝났으면 그 시점의 정확한 상태 반환
+    UFUNCTION(BlueprintCallable, Category = "Ballistic Physics Simulator")
+    bool GetHandoffState(
+        float& OutTime,
+        FVector& OutPosition,
+        FQuat& OutRotation,
+        FVector& OutLinearVelocity,
+        FVector& OutAngularVelocity) const;
+
+    // 여러 컴포넌트의 발사를 한번에 시뮬레이션 (에디터 세트피스 일괄 생성 등)
+    // 예측 씬이 준비되어 있으면 (Simulator 의 bUsePredictionScene 과 무관) 예측 씬 워커 스레드에서, 없으면 게임 스레드에서 차례로 진행
+    // 끝난 발사는 게임 스레드에서 바로 Simulator 의 마지막 결과로 반영하고 OnLaunchComplete (발사 인덱스) 호출
+    // ShouldCancel 은 예측 씬 경로에서는 대기 중 주기적으로, 게임 스레드 경로에서는 발사 사이에 호출 (진행률 갱신에도 사용)
+    // true 이면 진행 중인 발사는 다음 조각에서 멈추고 결과는 버림
+    // 모든 작업이 끝날 때까지 반환하지 않음, 반영된 발사 수 반환
+    static int32 SimulateLaunchesParallel(
+        UWorld* World,
+        TArrayView<const FBallParallelLaunch> Launches,
+        TFunctionRef<void(int32 LaunchIndex)> OnLaunchComplete,
+        TFunctionRef<bool()> ShouldCancel);
+
+    // 같은 공 종류를 대량으로 시뮬레이션하는 배치 경로 (AI 슈팅 평가 등)
+    // 프로파일에 맞게 특수화된 커널을 한번 선택해서 모든 상태에 적용, OutSnapshots 가 nullptr 이면 최종 상태만 계산
+    // 상태와 스냅샷은 Origin 기준 (경기장 중심 등 모든 상태에 가까운 위치)
+    static void SimulateBallPhysicsBatch(
+        const UObject* WorldContextObject,
+        const UBallPhysicsProfile* Profile,
+        const FVector& Origin,
+        TArrayView<FBallSimState> InOutStates,
+        const int32 SimulationSteps,
+        const float StepInterval,
+        TArray<TArray<FBallSimSnapshot>>* OutSnapshots = nullptr);
+
+    // 같은 프로파일의 공 여러 개를 공끼리의 충돌을 포함해서 함께 시뮬레이션 (훈련, 워밍업 장면)
+    // 공끼리의 후보 쌍은 균일 공간 해시로 찾고, 공 수가 많으면 공별 스텝을 병렬로 진행 (FBallMultiSimulation)
+    // 상태와 스냅샷은 SimulateBallPhysicsBatch 와 같이 Origin 기준
+    static int32 SimulateMultiBallPhysics(
+        const UObject* WorldContextObject,
+        const UBallPhysicsProfile* Profile,
+        const FVector& Origin,
+        TArrayView<FBallSimState> InOutStates,
+        const int32 SimulationSteps,
+        const float StepInterval,
+        TArray<TArray<FBallSimSnapshot>>* OutSnapshots = nullptr);
+
+    // 프로파일이 없을 때 컴포넌트 UPROPERTY 로부터 튜닝 상수 생성
+    FBallSimConstants MakeSimConstants(const float BallMass, const float BallRadius, const float StepInterval) const;
+
     int HandleCollision(
         UWorld* World,
         const float InvMass,
@@ -183,9 +207,13 @@ public:
  
     //bool ResolvePenetration(const FVector& ProposedAdjustment, const FHitResult& Hit, const FQuat& NewRotationQuat);
 
-    // spin 벡터를 회전 쿼터니언으로 변환하는 함수    
+    // 회전 벡터 (축 * 라디안) 만큼 회전 (FBallSimKernel::ApplySpinToRotation)
     void ApplySpinToRotation(const FVector& InAngularDelta, FQuat& OutRotation) const;
 
+    // 회전 키프레임과 스냅샷 각속도로 재생 시점의 회전 복원
+    UFUNCTION(BlueprintCallable, Category = "Ballistic Physics Simulator")
+    FQuat GetBallRotationAtTime(float playbackTime) const;
+
     UFUNCTION(BlueprintCallable, Category = "Ballistic Physics Simulator")
     void ConvertSnapshotsToBezierSpline(const TArray<FBallSnapshot>& Snapshots, USplineComponent* SplineComponent) const;    
 
@@ -203,6 +231,14 @@ public:
         FVector& OutPosition,
         FQuat& OutRotation) const;
   
+    // 원거리 재생용 감소 궤적 구성, DecimationStep 스텝마다 (충돌 스텝은 항상) 위치만 남김
+    UFUNCTION(BlueprintCallable, Category = "Ballistic Physics Simulator")
+    void BuildDecimatedTrajectory(int32 DecimationStep);
+
+    // 감소 궤적의 선형 보간 위치 (회전 없음), 감소 궤적이 없으면 스냅샷 사이 선형 보간
+    UFUNCTION(BlueprintCallable, Category = "Ballistic Physics Simulator")
+    FVector GetDecimatedPositionAtTime(float playbackTime) const;
+
     UFUNCTION(BlueprintCallable, Category = "Ballistic Physics Simulator")
     float GetBallSpeedAtTime(float playbackTime) const;
 
@@ -210,6 +246,70 @@ public:
     void GetBallVelocityAtTime(float playbackTime, FVector& LinearVelocity,
         FVector& AngularVeloticy) const;
 
+    // 여러 시간을 한 번에 샘플링 (궤적 표시, AI 예측, 분석), 시간은 정렬되어 있지 않아도 됨
+    // 출력 뷰는 비어 있으면 해당 채널 생략, 아니면 샘플 수 이상, 회전은 시간이 정렬되어 있을 때 가장 저렴함
+    void SampleTrajectory(
+        const FBallSampleTimes& Times,
+        TArrayView<FVector> OutPositions,
+        TArrayView<FVector> OutLinearVelocities,
+        TArrayView<FVector> OutAngularVelocities = TArrayView<FVector>(),
+        TArrayView<FQuat> OutRotations = TArrayView<FQuat>()) const;
+
+    UFUNCTION(BlueprintCallable, Category = "Ballistic Physics Simulator")
+    void SampleTrajectoryAtTimes(
+        const TArray<float>& Times,
+        bool bWithRotations,
+        TArray<FVector>& OutPositions,
+        TArray<FVector>& OutLinearVelocities,
+        TArray<FQuat>& OutRotations) const;
+
+    // StartTime 부터 DeltaTime 간격으로 Count 개 샘플링
+    UFUNCTION(BlueprintCallable, Category = "Ballistic Physics Simulator")
+    void SampleTrajectoryUniform(
+        float StartTime,
+        float DeltaTime,
+        int32 Count,
+        bool bWithRotations,
+        TArray<FVector>& OutPositions,
+        TArray<FVector>& OutLinearVelocities,
+        TArray<FQuat>& OutRotations) const;
+
+	// 설정 시 아래 튜닝 값 대신 프로파일 값과 프로파일 기능 조합에 맞게 특수화된 커널 사용
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ballistic Physics Simulator")
+    UBallPhysicsProfile* PhysicsProfile = nullptr;
+
+	// 게임 월드 대신 예측 전용 물리 씬 (UBallPredictionScene) 에 Sweep, 게임 월드 물리 락과 경쟁하지 않음
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ballistic Physics Simulator")
+    bool bUsePredictionScene = false;
+
+	// 굴러가기 시작하거나 멈추거나 MaxAllowedBounce 에 도달하면 시뮬레이션을 끝내고 강체 물리로 넘김
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ballistic Physics Simulator")
+    bool bHandoffToPhysics = false;
+
+    // 발사 상태의 예상 경로 주변 정적 충돌체를 미리 모아서 그 충돌체에만 Sweep (FBallCollisionCorridor)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ballistic Physics Simulator")
+    bool bUseCollisionCorridor = false;
+
+    // 마지막 시뮬레이션에서 공이 통로를 벗어나서 다시 모은 횟수
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ballistic Physics Simulator")
+    int32 CorridorRegatherCount = 0;
+
+    // 재시뮬레이션용 체크포인트 간격 (스텝), 0 이면 시작 상태만 저장
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ballistic Physics Simulator")
+    int32 CheckpointInterval = 16;
+
+    // 시뮬레이션 중 검사할 평면 / 영역 트리거와 정지 조건 (골라인 첫 통과 시 종료 등)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ballistic Physics Simulator")
+    FBallSimEventQuery EventQuery;
+
+    // 마지막 시뮬레이션에서 Type 의 첫 이벤트, TriggerIndex 가 INDEX_NONE 이 아니면 해당 트리거만
+    UFUNCTION(BlueprintCallable, Category = "Ballistic Physics Simulator")
+    bool FindFirstEvent(EBallSimEventType Type, int32 TriggerIndex, FBallSimEvent& OutEvent) const;
+
+    // 마지막 시뮬레이션의 종료 이유 (None 이면 전체 스텝 진행)
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ballistic Physics Simulator")
+    EBallHandoffReason HandoffReason = EBallHandoffReason::None;
+
 	// 최소 속도 이하로 떨어지면 시뮬레이션 종료
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ballistic Physics Simulator")
     float MinSpeed = 1.0f;
@@ -238,14 +338,47 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ballistic Physics Simulator")
     float BouncedSpinMultiplier = 0.65f;
 
-    UPROPERTY(BlueprintReadOnly, Category = "Ballistic Physics Simulator")
-    TArray<FBallSnapshot> CachedSnapshots;
-	
-    UPROPERTY(BlueprintReadOnly, Category = "Ballistic Physics Simulator")
-    TArray<FBallBounce> CachedHits;
+    // 마지막 시뮬레이션 결과, 보관하면 다시 시뮬레이션해도 유지됨 (결과가 없으면 nullptr)
+    const FBallTrajectoryPtr& GetTrajectory() const { return Trajectory; }
+
+    UFUNCTION(BlueprintPure, Category = "Ballistic Physics Simulator")
+    FBallTrajectoryHandle GetTrajectoryHandle() const { return FBallTrajectoryHandle(Trajectory); }
+
+    // 마지막 결과 접근자, 결과가 없으면 빈 배열
+    // 위치는 GetSimulationOrigin 기준 단정밀도 (블루프린트 접근자는 월드 기준으로 변환)
+    const TArray<FBallSimSnapshot>& GetSnapshots() const { return GetTrajectoryOrEmpty().Snapshots; }
+    const TArray<FBallSimBounce>& GetHits() const { return GetTrajectoryOrEmpty().Hits; }
+    const TArray<FBallSimBounce>& GetBounces() const { return GetTrajectoryOrEmpty().Bounces; }
+    const FVector& GetSimulationOrigin() const { return GetTrajectoryOrEmpty().Origin; }
+
+    // RotationKeyInterval 스텝마다 기록된 회전, 스냅샷에는 회전을 저장하지 않음
+    const TArray<FBallRotationKey>& GetRotationKeys() const { return GetTrajectoryOrEmpty().RotationKeys; }
+
+    // 마지막 시뮬레이션의 이벤트 (최고점, 바운스, 슬라이딩 시작, 정지, 트리거 통과), 시간 순
+    const TArray<FBallSimEvent>& GetEvents() const { return GetTrajectoryOrEmpty().Events; }
+
+    // 블루프린트 접근자, 결과는 Trajectory 에만 있으므로 호출마다 월드 기준으로 변환한 복사본을 반환 (C++ 는 GetSnapshots 등 사용)
+    UFUNCTION(BlueprintPure, Category = "Ballistic Physics Simulator", meta = (DisplayName = "Get Cached Snapshots"))
+    TArray<FBallSnapshot> K2_GetSnapshots() const { return FBallSimSnapshot::ToSnapshots(GetSnapshots(), GetSimulationOrigin()); }
 
-    UPROPERTY(BlueprintReadOnly, Category = "Ballistic Physics Simulator")
-    TArray<FBallBounce> CachedBounces;
+    UFUNCTION(BlueprintPure, Category = "Ballistic Physics Simulator", meta = (DisplayName = "Get Cached Hits"))
+    TArray<FBallBounce> K2_GetHits() const { return FBallSimBounce::ToBounces(GetHits(), GetSimulationOrigin()); }
+
+    UFUNCTION(BlueprintPure, Category = "Ballistic Physics Simulator", meta = (DisplayName = "Get Cached Bounces"))
+    TArray<FBallBounce> K2_GetBounces() const { return FBallSimBounce::ToBounces(GetBounces(), GetSimulationOrigin()); }
+
+    UFUNCTION(BlueprintPure, Category = "Ballistic Physics Simulator", meta = (DisplayName = "Get Cached Rotation Keys"))
+    TArray<FBallRotationKey> K2_GetRotationKeys() const { return GetRotationKeys(); }
+
+    UFUNCTION(BlueprintPure, Category = "Ballistic Physics Simulator", meta = (DisplayName = "Get Cached Events"))
+    TArray<FBallSimEvent> K2_GetEvents() const { return GetEvents(); }
+
+    UFUNCTION(BlueprintPure, Category = "Ballistic Physics Simulator")
+    int32 GetNumSnapshots() const { return GetSnapshots().Num(); }
+
+	// 회전 키프레임 간격 (스텝), 클수록 메모리는 줄고 재생 시 복원 비용은 늘어남
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ballistic Physics Simulator")
+    int32 RotationKeyInterval = 16;
     
 	// 시뮬레이션 스텝 시간 간격 (0.033 = 30Hz)
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ballistic Physics Simulator")
@@ -305,16 +438,19 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ballistic Physics Simulator")
     float BounceThreshold = 10.f;   
 
+	// 코너, 골대-바닥 사이에 끼었을 때 이 거리 (cm) 안의 접촉을 모아서 동시에 해결
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ballistic Physics Simulator", meta = (ClampMin = "0"))
+    float ContactSkin = 0.5f;
+
+	// 접촉 매니폴드 Sequential Impulse 반복 횟수, 0 이면 충돌마다 재귀 SubStep 으로 처리
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ballistic Physics Simulator", meta = (ClampMin = "0", ClampMax = "16"))
+    int32 ContactSolverIterations = 4;
+
 	// 최대 허용 속도 
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ballistic Physics Simulator")
 	float MaxAllowedSpeed = 10000.f;
 
-    // Damping 만으로 단순화 가능
-    //UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ballistic Physics Simulator")
-    //float CD = 0.5f;           // 항력 계수(튜닝)
-
-    //UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ballistic Physics Simulator")
-    //float Rho = 0.000001225f;   // 공기 밀도 1.225 kg·m⁻³  ( 1.225f / 1e6f kg·cm⁻³ ) 
+    // 컴포넌트 튜닝은 Damping 만으로 단순화, 속도 / 스핀 의존 항력과 양력은 PhysicsProfile 의 공기역학 테이블 사용
 
 	// 슬라이딩 접촉 상태 확인용 내부 변수
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ballistic Physics Simulator")
@@ -324,7 +460,61 @@ public:
     UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ballistic Physics Simulator")
     FVector PreviousHitNormal;
 
+    // 예측 궤적을 가지는 키네마틱 장애물 (수비벽, 골키퍼 등), 월드 Sweep 과 별도로 해석적 충돌 검사
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ballistic Physics Simulator")
+    TArray<FBallKinematicObstacle> KinematicObstacles;
+
+    // 장애물 Broad-phase 시간 윈도우 크기 (초)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ballistic Physics Simulator")
+    float ObstacleTimeWindow = 0.25f;
+
     static constexpr int MaxAllowedSimulationStep = 1000;
     static constexpr float SplineTangentLengh = 50.f;        
-    
+
+private:
+    // 게임 스레드에서 튜닝 상수, 장애물, 초기 상태를 작업으로 구성 (QueryWorld 는 Sweep 대상 월드)
+    void PrepareSimulation(
+        UWorld* World,
+        UWorld* QueryWorld,
+        const FBallLaunchParams& Launch,
+        const FBallSimSettings& Settings,
+        FBallSimulationJob& OutJob);
+
+    // 게임 스레드에서 작업 결과를 캐시에 반영하고 궤적 기록
+    void FinishSimulation(FBallSimulationJob& Job);
+
+    // bUsePredictionScene 이고 예측 씬이 준비된 경우에만 반환
+    UBallPredictionScene* GetPredictionScene(UWorld* World) const;
+
+    // 동기 API (SimulateLaunch 등) 용, 예측 씬이 있으면 워커 스레드에서 실행하고 게임 스레드는 완료까지 대기, 없으면 호출 스레드에서 실행
+    // 예측 씬은 Sweep 을 게임 월드 물리 락과 분리할 뿐 호출 비용은 줄지 않음, 대기 없이 쓰려면 SimulateBallPhysicsAsync
+    void ExecuteSimulation(UBallPredictionScene* PredictionScene, FBallSimulationJob& Job);
+
+    // KinematicObstacles 로부터 시뮬레이션 시작 시 구성
+    FBallObstacleSet ObstacleSet;
+
+    // 마지막 시뮬레이션 결과 (스냅샷, 바운스, 이벤트), 시뮬레이션마다 새 객체로 교체
+    FBallTrajectoryPtr Trajectory;
+
+    const FBallTrajectory& GetTrajectoryOrEmpty() const { return Trajectory.IsValid() ? *Trajectory : FBallTrajectory::Empty(); }
+
+    // 마지막 시뮬레이션의 최종 상태 (Handoff 시 강체 초기 상태)
+    FBallSimState FinalState;
+
+    // 재시뮬레이션용 체크포인트와 마지막 발사 조건
+    TArray<FBallSimCheckpoint> Checkpoints;
+    FBallLogLaunch LastLaunch = {};
+    float SimulationWorldTime = 0.f;
+    FVector SimulationOrigin = FVector::ZeroVector;
+
+    // 원거리 재생용 감소 궤적 (시간 오름차순)
+    TArray<float> DecimatedTimes;
+    TArray<FVector> DecimatedPositions;
+
+    // 일괄 샘플링용 스냅샷 채널, 궤적이 바뀌면 다음 샘플링 시 다시 구성
+    mutable FBallTrajectorySampler TrajectorySampler;
+
+    // 비동기 요청 순번, 완료 시 최신 요청이 아니면 결과를 버림
+    int32 SimulationSerial = 0;
+    bool bSimulationPending = false;
 };
\ No newline at end of file
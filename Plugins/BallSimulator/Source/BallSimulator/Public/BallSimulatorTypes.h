@@ -0,0 +1,464 @@
+﻿// © 2025 UnrealStudy. All rights reserved.
+// Author: taru00@gmail.com | https://x.com/3devnote
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/HitResult.h"
+#include "Chaos/ChaosEngineInterface.h"
+#include "BallSimulatorTypes.generated.h"
+
+// 키네마틱 시뮬레이션을 끝내고 강체 물리로 넘기는 이유
+UENUM(BlueprintType)
+enum class EBallHandoffReason : uint8
+{
+    None,
+    RollingContact,     // 바닥과 접촉한 채로 굴러가기 시작
+    Rest,               // 접촉 중 최소 속도 이하
+    MaxBounce,          // 최대 바운스 횟수 도달
+    StopEvent,          // 이벤트 정지 조건 (FBallSimEventQuery) 충족, 강체 물리로 넘기지 않음
+};
+
+USTRUCT(BlueprintType)
+struct FBallBounce
+{
+    GENERATED_BODY()
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    int SnapshotIndex;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    FVector Direction;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    float Speed;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    float Spin;
+    
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    FVector AngularVelocity;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    FVector BouncedDirection;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    float BouncedSpeed;
+    
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    float BouncedSpin;   
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    FVector BouncedAngularVelocity;
+    
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    bool bWasStuck;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    bool bIsSliding;
+    
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    FVector StartPos;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    FVector ImpactPoint;
+    
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    FVector ImpactNormal;
+
+    // 이번 충돌에 대한 반사 후 추가 충돌이 없을때 사용될 NextPos 후보
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    FVector NextPos;
+    
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    float TimeToBeforeHit;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    float RemainingTime;
+
+    // 접촉점의 상대 속도 ContactVelocity를 히트 노멀 방향 으로 프로젝션해서 얻은 값
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    float vRel;
+    
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    FVector NormalImpulse;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    FVector FrictionImpulse;
+    
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    FVector LinearImpulse;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    FVector AngularDelta;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    float AngularDeltaSize;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    FVector FrictionDelta;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    float PenetrationDepth;
+
+    // 동시에 해결한 접촉 수 (코너, 골대-바닥 등 접촉 매니폴드), 1 이면 단일 충돌
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    int32 NumContacts = 1;
+
+    // 충돌면 종류 (FBallSurfaceTable 인덱스), 장애물 또는 물리 재질이 없으면 SurfaceType_Default
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    TEnumAsByte<EPhysicalSurface> SurfaceType = SurfaceType_Default;
+};
+
+USTRUCT(BlueprintType)
+struct FBallSnapshot
+{
+    GENERATED_BODY()
+
+	// 디버깅 편의를 위해 저장된 시간값 (고정 프레임율 이므로 시간 간격은 일정함)
+    UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
+    float Time;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
+    FVector Position;
+
+    // 회전은 저장하지 않음, FBallRotationKey 와 SpinAxis/SpinSpeed 로 재생 시점에 복원 (FBallSimKernel::ReconstructRotation)
+
+    // Direction * Speed
+    //UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    //FVector LinearVeloticy;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
+    FVector Direction;
+
+    // 축구 기준 2000 cm/s ~ 4000 cm/s or 70 km/h ~ 145 km/h  (100 cm/s = 3.6 km/h)
+    UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
+    float Speed;
+    
+    // SpinAxis * SpinSpeed
+    //UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    //FVector AngularVelocity;
+    UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
+    int hitCount;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
+    int BounceIndex;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
+    FVector SpinAxis;
+
+    // 축구 회전 킥 기준 20~90 rad/s
+    UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
+    float SpinSpeed;
+};
+
+// 드문드문 저장되는 회전 키프레임, 사이 구간은 스냅샷 각속도로 적분해서 복원
+USTRUCT(BlueprintType)
+struct FBallRotationKey
+{
+    GENERATED_BODY()
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    int32 StepIndex = 0;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    FQuat Rotation = FQuat::Identity;
+};
+
+// 커널이 기록하고 궤적 (FBallTrajectory) 이 보관하는 스냅샷, 위치는 샷 원점 (FBallSimContext::Origin) 기준 단정밀도
+// 블루프린트에 넘길 때만 ToSnapshot 으로 월드 기준 FBallSnapshot 으로 변환
+struct FBallSimSnapshot
+{
+    float Time = 0.f;
+    FVector3f Position = FVector3f::ZeroVector;
+    FVector3f Direction = FVector3f::ZeroVector;
+    float Speed = 0.f;
+    int32 hitCount = 0;
+    int32 BounceIndex = INDEX_NONE;
+    FVector3f SpinAxis = FVector3f::ZeroVector;
+    float SpinSpeed = 0.f;
+
+    FVector GetWorldPosition(const FVector& Origin) const { return Origin + FVector(Position); }
+
+    FBallSnapshot ToSnapshot(const FVector& Origin) const
+    {
+        FBallSnapshot Snapshot;
+        Snapshot.Time = Time;
+        Snapshot.Position = GetWorldPosition(Origin);
+        Snapshot.Direction = FVector(Direction);
+        Snapshot.Speed = Speed;
+        Snapshot.hitCount = hitCount;
+        Snapshot.BounceIndex = BounceIndex;
+        Snapshot.SpinAxis = FVector(SpinAxis);
+        Snapshot.SpinSpeed = SpinSpeed;
+        return Snapshot;
+    }
+
+    static TArray<FBallSnapshot> ToSnapshots(TArrayView<const FBallSimSnapshot> Snapshots, const FVector& Origin)
+    {
+        TArray<FBallSnapshot> Result;
+        Result.Reserve(Snapshots.Num());
+        for (const FBallSimSnapshot& Snapshot : Snapshots)
+        {
+            Result.Add(Snapshot.ToSnapshot(Origin));
+        }
+        return Result;
+    }
+};
+
+// 커널이 기록하는 충돌, 위치 (StartPos, ImpactPoint, NextPos) 는 FBallSimSnapshot 과 같이 샷 원점 기준 단정밀도
+// 필드 의미는 FBallBounce 와 같음, 블루프린트에 넘길 때만 ToBounce 로 변환
+struct FBallSimBounce
+{
+    int32 SnapshotIndex = 0;
+    FVector3f Direction = FVector3f::ZeroVector;
+    float Speed = 0.f;
+    float Spin = 0.f;
+    FVector3f AngularVelocity = FVector3f::ZeroVector;
+    FVector3f BouncedDirection = FVector3f::ZeroVector;
+    float BouncedSpeed = 0.f;
+    float BouncedSpin = 0.f;
+    FVector3f BouncedAngularVelocity = FVector3f::ZeroVector;
+    bool bWasStuck = false;
+    bool bIsSliding = false;
+    FVector3f StartPos = FVector3f::ZeroVector;
+    FVector3f ImpactPoint = FVector3f::ZeroVector;
+    FVector3f ImpactNormal = FVector3f::ZeroVector;
+    FVector3f NextPos = FVector3f::ZeroVector;
+    float TimeToBeforeHit = 0.f;
+    float RemainingTime = 0.f;
+    float vRel = 0.f;
+    FVector3f NormalImpulse = FVector3f::ZeroVector;
+    FVector3f FrictionImpulse = FVector3f::ZeroVector;
+    FVector3f LinearImpulse = FVector3f::ZeroVector;
+    FVector3f AngularDelta = FVector3f::ZeroVector;
+    float AngularDeltaSize = 0.f;
+    FVector3f FrictionDelta = FVector3f::ZeroVector;
+    float PenetrationDepth = 0.f;
+    int32 NumContacts = 1;
+    TEnumAsByte<EPhysicalSurface> SurfaceType = SurfaceType_Default;
+
+    FVector GetWorldImpactPoint(const FVector& Origin) const { return Origin + FVector(ImpactPoint); }
+
+    FBallBounce ToBounce(const FVector& Origin) const
+    {
+        FBallBounce Bounce;
+        Bounce.SnapshotIndex = SnapshotIndex;
+        Bounce.Direction = FVector(Direction);
+        Bounce.Speed = Speed;
+        Bounce.Spin = Spin;
+        Bounce.AngularVelocity = FVector(AngularVelocity);
+        Bounce.BouncedDirection = FVector(BouncedDirection);
+        Bounce.BouncedSpeed = BouncedSpeed;
+        Bounce.BouncedSpin = BouncedSpin;
+        Bounce.BouncedAngularVelocity = FVector(BouncedAngularVelocity);
+        Bounce.bWasStuck = bWasStuck;
+        Bounce.bIsSliding = bIsSliding;
+        Bounce.StartPos = Origin + FVector(StartPos);
+        Bounce.ImpactPoint = GetWorldImpactPoint(Origin);
+        Bounce.ImpactNormal = FVector(ImpactNormal);
+        Bounce.NextPos = Origin + FVector(NextPos);
+        Bounce.TimeToBeforeHit = TimeToBeforeHit;
+        Bounce.RemainingTime = RemainingTime;
+        Bounce.vRel = vRel;
+        Bounce.NormalImpulse = FVector(NormalImpulse);
+        Bounce.FrictionImpulse = FVector(FrictionImpulse);
+        Bounce.LinearImpulse = FVector(LinearImpulse);
+        Bounce.AngularDelta = FVector(AngularDelta);
+        Bounce.AngularDeltaSize = AngularDeltaSize;
+        Bounce.FrictionDelta = FVector(FrictionDelta);
+        Bounce.PenetrationDepth = PenetrationDepth;
+        Bounce.NumContacts = NumContacts;
+        Bounce.SurfaceType = SurfaceType;
+        return Bounce;
+    }
+
+    static TArray<FBallBounce> ToBounces(TArrayView<const FBallSimBounce> Bounces, const FVector& Origin)
+    {
+        TArray<FBallBounce> Result;
+        Result.Reserve(Bounces.Num());
+        for (const FBallSimBounce& Bounce : Bounces)
+        {
+            Result.Add(Bounce.ToBounce(Origin));
+        }
+        return Result;
+    }
+};
+
+// 시뮬레이션 중에 발생하는 이벤트 종류, FBallSimEventQuery::StopOnEvents 의 비트 번호
+UENUM(BlueprintType)
+enum class EBallSimEventType : uint8
+{
+    Apex,               // 상승에서 하강으로 전환 (최고점)
+    Bounce,             // 바운스 (슬라이딩이 아닌 충돌)
+    SlideStart,         // 슬라이딩 (구름) 접촉 시작
+    Rest,               // 접촉 중 최소 속도 이하
+    PlaneCrossing,      // 평면 통과 (TriggerIndex = Planes 인덱스)
+    VolumeEnter,        // 영역 진입 (TriggerIndex = Volumes 인덱스)
+    VolumeExit,         // 영역 이탈 (TriggerIndex = Volumes 인덱스)
+};
+
+USTRUCT(BlueprintType)
+struct FBallSimEvent
+{
+    GENERATED_BODY()
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    EBallSimEventType Type = EBallSimEventType::Apex;
+
+    // 시뮬레이션 시작 기준 시간, 스텝 안에서 보간된 값
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    float Time = 0.f;
+
+    // 이벤트가 발생한 스텝 (이 스텝의 스냅샷 직전 구간)
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    int32 StepIndex = 0;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    FVector Position = FVector::ZeroVector;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    FVector LinearVelocity = FVector::ZeroVector;
+
+    // PlaneCrossing / VolumeEnter / VolumeExit 의 트리거 인덱스, 그 외 INDEX_NONE
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    int32 TriggerIndex = INDEX_NONE;
+};
+
+// 통과 이벤트를 만드는 평면 (골라인, 터치라인 등), 양방향 모두 통과로 기록
+USTRUCT(BlueprintType)
+struct FBallSimEventPlane
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FVector Origin = FVector::ZeroVector;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FVector Normal = FVector::ForwardVector;
+
+    // 처음 통과하는 스텝에서 시뮬레이션 종료
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bStopOnCrossing = false;
+};
+
+// 진입 / 이탈 이벤트를 만드는 영역 (골대 안, 경기장 밖 등)
+USTRUCT(BlueprintType)
+struct FBallSimEventVolume
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FBox Bounds = FBox(ForceInit);
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bStopOnEnter = false;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    bool bStopOnExit = false;
+};
+
+// 시뮬레이션 중 검사할 트리거와 정지 조건
+// 정지 조건을 만족하는 이벤트가 발생하면 그 스텝까지만 진행 (HandoffReason = StopEvent)
+USTRUCT(BlueprintType)
+struct FBallSimEventQuery
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TArray<FBallSimEventPlane> Planes;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    TArray<FBallSimEventVolume> Volumes;
+
+    // 이 종류의 이벤트가 처음 발생하면 종료 (EBallSimEventType 비트 마스크)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (Bitmask, BitmaskEnum = "/Script/BallSimulator.EBallSimEventType"))
+    int32 StopOnEvents = 0;
+
+    // C++ 전용 정지 조건, true 를 반환하면 종료 (워커 스레드에서 호출될 수 있음)
+    TFunction<bool(const FBallSimEvent& Event)> StopPredicate;
+
+    bool ShouldStop(const FBallSimEvent& Event) const
+    {
+        if (StopOnEvents & (1 << (int32)Event.Type))
+        {
+            return true;
+        }
+
+        switch (Event.Type)
+        {
+        case EBallSimEventType::PlaneCrossing:
+            if (Planes[Event.TriggerIndex].bStopOnCrossing) return true;
+            break;
+        case EBallSimEventType::VolumeEnter:
+            if (Volumes[Event.TriggerIndex].bStopOnEnter) return true;
+            break;
+        case EBallSimEventType::VolumeExit:
+            if (Volumes[Event.TriggerIndex].bStopOnExit) return true;
+            break;
+        default:
+            break;
+        }
+
+        return StopPredicate && StopPredicate(Event);
+    }
+};
+
+// 발사 조건, 스칼라 인자 대신 구조체 하나로 전달 (블루프린트 호출 시 인자 마샬링 감소)
+USTRUCT(BlueprintType)
+struct FBallLaunchParams
+{
+    GENERATED_BODY()
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FVector Position = FVector::ZeroVector;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FQuat Rotation = FQuat::Identity;
+
+    // 단위 벡터
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FVector Direction = FVector::ForwardVector;
+
+    // cm/s
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float Speed = 0.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    FVector SpinAxis = FVector::UpVector;
+
+    // rad/s
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float SpinSpeed = 0.f;
+
+    FBallLaunchParams() = default;
+
+    FBallLaunchParams(const FVector& InPosition, const FQuat& InRotation, const FVector& InDirection, float InSpeed, const FVector& InSpinAxis, float InSpinSpeed)
+        : Position(InPosition), Rotation(InRotation), Direction(InDirection), Speed(InSpeed), SpinAxis(InSpinAxis), SpinSpeed(InSpinSpeed) {}
+};
+
+// 공 종류와 시뮬레이션 길이, 같은 공으로 여러 발사를 시뮬레이션할 때 공유
+USTRUCT(BlueprintType)
+struct FBallSimSettings
+{
+    GENERATED_BODY()
+
+    // kg
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float Mass = 0.43f;
+
+    // cm
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float Radius = 11.f;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "1"))
+    int32 SimulationSteps = 300;
+
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = "0.001"))
+    float StepInterval = 1.f / 60.f;
+
+    FBallSimSettings() = default;
+
+    FBallSimSettings(float InMass, float InRadius, int32 InSimulationSteps, float InStepInterval)
+        : Mass(InMass), Radius(InRadius), SimulationSteps(InSimulationSteps), StepInterval(InStepInterval) {}
+};
@@ -0,0 +1,58 @@
+﻿// © 2025 UnrealStudy. All rights reserved.
+// Author: taru00@gmail.com | https://x.com/3devnote
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BallSimulatorTypes.h"
+#include "BallTrajectory.generated.h"
+
+// 한번의 시뮬레이션 결과, 만든 뒤에는 변경하지 않으므로 여러 스레드에서 복사 없이 공유
+// 재생, AI, 리플레이, 네트워크 등 소비자는 FBallTrajectoryPtr 를 보관하면 컴포넌트가 다시 시뮬레이션해도 그대로 유지됨
+// 스냅샷과 충돌은 Origin 기준 단정밀도, 월드 위치는 GetPosition 또는 블루프린트 경계 (UBallTrajectoryLibrary) 에서 변환
+struct FBallTrajectory
+{
+    TArray<FBallSimSnapshot> Snapshots;
+    TArray<FBallSimBounce> Hits;
+    TArray<FBallSimBounce> Bounces;
+    TArray<FBallRotationKey> RotationKeys;
+    TArray<FBallSimEvent> Events;
+
+    float StepInterval = 0.f;
+
+    // 시뮬레이션 종료 시간 (Handoff / 정지 조건이면 마지막 스냅샷 시간)
+    float EndTime = 0.f;
+
+    // 발사 위치 (시뮬레이션 원점), 월드 시간
+    FVector Origin = FVector::ZeroVector;
+    float WorldTime = 0.f;
+
+    EBallHandoffReason HandoffReason = EBallHandoffReason::None;
+
+    FVector GetPosition(int32 SnapshotIndex) const { return Snapshots[SnapshotIndex].GetWorldPosition(Origin); }
+
+    // 결과가 없을 때 접근자가 반환하는 빈 궤적
+    static const FBallTrajectory& Empty()
+    {
+        static const FBallTrajectory EmptyTrajectory;
+        return EmptyTrajectory;
+    }
+};
+
+using FBallTrajectoryPtr = TSharedPtr<const FBallTrajectory, ESPMode::ThreadSafe>;
+using FBallTrajectoryRef = TSharedRef<const FBallTrajectory, ESPMode::ThreadSafe>;
+
+// 블루프린트에 배열을 복사하지 않고 궤적을 넘기는 핸들 (UBallTrajectoryLibrary 로 조회)
+USTRUCT(BlueprintType)
+struct FBallTrajectoryHandle
+{
+    GENERATED_BODY()
+
+    FBallTrajectoryPtr Trajectory;
+
+    FBallTrajectoryHandle() = default;
+    FBallTrajectoryHandle(FBallTrajectoryPtr InTrajectory) : Trajectory(MoveTemp(InTrajectory)) {}
+
+    bool IsValid() const { return Trajectory.IsValid(); }
+    const FBallTrajectory& Get() const { return Trajectory.IsValid() ? *Trajectory : FBallTrajectory::Empty(); }
+};
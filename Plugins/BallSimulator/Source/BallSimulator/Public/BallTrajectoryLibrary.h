@@ -0,0 +1,51 @@
+﻿// © 2025 UnrealStudy. All rights reserved.
+// Author: taru00@gmail.com | https://x.com/3devnote
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "BallTrajectory.h"
+#include "BallTrajectoryLibrary.generated.h"
+
+// FBallTrajectoryHandle 조회, 필요한 값만 꺼내므로 궤적 배열 전체를 블루프린트로 복사하지 않음
+UCLASS()
+class BALLSIMULATOR_API UBallTrajectoryLibrary : public UBlueprintFunctionLibrary
+{
+    GENERATED_BODY()
+
+public:
+    UFUNCTION(BlueprintPure, Category = "Ballistic Physics Simulator")
+    static bool IsValidTrajectory(const FBallTrajectoryHandle& Trajectory) { return Trajectory.IsValid(); }
+
+    UFUNCTION(BlueprintPure, Category = "Ballistic Physics Simulator")
+    static float GetTrajectoryEndTime(const FBallTrajectoryHandle& Trajectory) { return Trajectory.Get().EndTime; }
+
+    UFUNCTION(BlueprintPure, Category = "Ballistic Physics Simulator")
+    static EBallHandoffReason GetTrajectoryHandoffReason(const FBallTrajectoryHandle& Trajectory) { return Trajectory.Get().HandoffReason; }
+
+    UFUNCTION(BlueprintPure, Category = "Ballistic Physics Simulator")
+    static int32 GetTrajectoryNumSnapshots(const FBallTrajectoryHandle& Trajectory) { return Trajectory.Get().Snapshots.Num(); }
+
+    UFUNCTION(BlueprintPure, Category = "Ballistic Physics Simulator")
+    static int32 GetTrajectoryNumBounces(const FBallTrajectoryHandle& Trajectory) { return Trajectory.Get().Bounces.Num(); }
+
+    UFUNCTION(BlueprintPure, Category = "Ballistic Physics Simulator")
+    static bool GetTrajectorySnapshot(const FBallTrajectoryHandle& Trajectory, int32 Index, FBallSnapshot& OutSnapshot);
+
+    // 시뮬레이션 마지막 위치, 궤적이 없으면 원점
+    UFUNCTION(BlueprintPure, Category = "Ballistic Physics Simulator")
+    static FVector GetTrajectoryFinalPosition(const FBallTrajectoryHandle& Trajectory);
+
+    // 스냅샷 사이 선형 보간, 구간 밖의 시간은 양 끝으로 클램프
+    UFUNCTION(BlueprintPure, Category = "Ballistic Physics Simulator")
+    static FVector GetTrajectoryPositionAtTime(const FBallTrajectoryHandle& Trajectory, float Time);
+
+    // Type 의 첫 이벤트, TriggerIndex 가 INDEX_NONE 이 아니면 해당 트리거만
+    UFUNCTION(BlueprintCallable, Category = "Ballistic Physics Simulator")
+    static bool FindFirstTrajectoryEvent(const FBallTrajectoryHandle& Trajectory, EBallSimEventType Type, int32 TriggerIndex, FBallSimEvent& OutEvent);
+
+    // 전체 스냅샷이 필요한 경우에만 사용 (배열 복사)
+    UFUNCTION(BlueprintCallable, Category = "Ballistic Physics Simulator")
+    static TArray<FBallSnapshot> CopyTrajectorySnapshots(const FBallTrajectoryHandle& Trajectory);
+};
@@ -0,0 +1,228 @@
+﻿// © 2025 UnrealStudy. All rights reserved.
+// Author: taru00@gmail.com | https://x.com/3devnote
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/Runnable.h"
+#include "Containers/Queue.h"
+#include "BallSimKernel.h"
+
+class IFileHandle;
+class IMappedFileHandle;
+class IMappedFileRegion;
+class FRunnableThread;
+class FEvent;
+
+/*
+ * 경기 단위 궤적 기록 파일 포맷 (Append-only)
+ *
+ * [FBallLogFileHeader]
+ * [FBallLogShotHeader][FBallLogSnapshot x NumSnapshots][FBallLogBounce x NumBounces]   ← 슈팅 1회 = 청크 1개
+ * ...
+ * [FBallLogIndexHeader][uint64 ChunkOffset x NumShots]                                 ← 종료 시 기록
+ * [FBallLogFooter]
+ *
+ * 모든 레코드는 고정 크기 POD 이므로 메모리 맵 후 포인터 연산만으로 접근 가능
+ * FHitResult 는 기록하지 않음 (충돌 정보는 FBallLogBounce 의 필드로 충분)
+ * Footer 가 없으면 (비정상 종료) 청크 헤더를 따라가며 인덱스를 다시 구성
+ */
+
+namespace BallTrajectoryLog
+{
+    static constexpr uint32 FileMagic = 0x4C545342;     // 'BSTL'
+    static constexpr uint32 ShotMagic = 0x544F4853;     // 'SHOT'
+    static constexpr uint32 IndexMagic = 0x58444E49;    // 'INDX'
+    static constexpr uint32 FooterMagic = 0x444E4542;   // 'BEND'
+    static constexpr uint32 Version = 1;
+}
+
+struct FBallLogFileHeader
+{
+    uint32 Magic = BallTrajectoryLog::FileMagic;
+    uint32 Version = BallTrajectoryLog::Version;
+    uint32 SnapshotSize = 0;
+    uint32 BounceSize = 0;
+};
+
+struct FBallLogLaunch
+{
+    double Position[3];
+    float Rotation[4];
+    float Direction[3];
+    float Speed;
+    float SpinAxis[3];
+    float SpinSpeed;
+    float Mass;
+    float Radius;
+    int32 SimulationSteps;
+    float StepInterval;
+};
+
+struct FBallLogTuning
+{
+    float Gravity[3];
+    float LinearDamping;
+    float AngularDamping;
+    float MinSpinForMagnus;
+    float SpinMagnusFactor;
+    float BouncedSpinMultiplier;
+    float SpinToRotateMultiply;
+    float DefaultRestitution;
+    float DefaultFriction;
+    float MaxAllowedImpulse;
+    float BounceThreshold;
+    uint32 Features;
+};
+
+struct FBallLogShotHeader
+{
+    uint32 Magic;
+    uint32 ShotIndex;
+    uint32 NumSnapshots;
+    uint32 NumBounces;
+
+    // 헤더 포함 청크 전체 크기
+    uint64 ChunkSize;
+
+    // 기록 시점의 월드 시간
+    double MatchTime;
+
+    FBallLogLaunch Launch;
+    FBallLogTuning Tuning;
+};
+
+struct FBallLogSnapshot
+{
+    double Position[3];
+    float Rotation[4];
+    float Direction[3];
+    float SpinAxis[3];
+    float Time;
+    float Speed;
+    float SpinSpeed;
+    int32 hitCount;
+    int32 BounceIndex;
+    uint32 Reserved;
+};
+
+struct FBallLogBounce
+{
+    double ImpactPoint[3];
+    int32 SnapshotIndex;
+    float Speed;
+    float Spin;
+    float BouncedSpeed;
+    float BouncedSpin;
+    float vRel;
+    float PenetrationDepth;
+    float TimeToBeforeHit;
+    uint32 Flags;   // 1 : bWasStuck, 2 : bIsSliding, 8 ~ 15 비트 : 충돌면 종류 (EPhysicalSurface)
+    float ImpactNormal[3];
+    float Direction[3];
+    float BouncedDirection[3];
+    float AngularVelocity[3];
+    float BouncedAngularVelocity[3];
+    float NormalImpulse[3];
+    float FrictionImpulse[3];
+};
+
+struct FBallLogIndexHeader
+{
+    uint32 Magic = BallTrajectoryLog::IndexMagic;
+    uint32 NumShots = 0;
+};
+
+struct FBallLogFooter
+{
+    uint64 IndexOffset = 0;
+    uint32 Magic = BallTrajectoryLog::FooterMagic;
+    uint32 Reserved = 0;
+};
+
+static_assert(sizeof(FBallLogFileHeader) == 16, "Ball trajectory log layout changed");
+static_assert(sizeof(FBallLogLaunch) == 88, "Ball trajectory log layout changed");
+static_assert(sizeof(FBallLogTuning) == 56, "Ball trajectory log layout changed");
+static_assert(sizeof(FBallLogShotHeader) == 176, "Ball trajectory log layout changed");
+static_assert(sizeof(FBallLogSnapshot) == 88, "Ball trajectory log layout changed");
+static_assert(sizeof(FBallLogBounce) == 144, "Ball trajectory log layout changed");
+static_assert(sizeof(FBallLogFooter) == 16, "Ball trajectory log layout changed");
+
+// 게임 스레드에서 청크를 만들어 넘기면 백그라운드 스레드가 파일에 추가 기록
+class BALLSIMULATOR_API FBallTrajectoryLogWriter : public FRunnable
+{
+public:
+    FBallTrajectoryLogWriter();
+    virtual ~FBallTrajectoryLogWriter();
+
+    bool Open(const FString& InFilePath);
+
+    // 대기 중인 청크를 모두 기록한 뒤 인덱스와 Footer 를 기록하고 파일을 닫음
+    void Close();
+
+    bool IsOpen() const { return Thread != nullptr; }
+    const FString& GetFilePath() const { return FilePath; }
+
+    // Snapshots, Bounces 는 Origin 기준, 파일에는 월드 기준으로 기록
+    // 반환값은 파일 내 슈팅 번호
+    int32 AppendShot(
+        double MatchTime,
+        const FBallLogLaunch& Launch,
+        const FBallSimConstants& Constants,
+        EBallSimFeature Features,
+        const FVector& Origin,
+        TArrayView<const FBallSimSnapshot> Snapshots,
+        TArrayView<const FBallSimBounce> Bounces);
+
+    // FRunnable
+    virtual uint32 Run() override;
+    virtual void Stop() override;
+
+private:
+    void WritePendingChunks();
+
+    FString FilePath;
+    TUniquePtr<IFileHandle> FileHandle;
+    FRunnableThread* Thread = nullptr;
+    FEvent* WakeEvent = nullptr;
+    TAtomic<bool> bStopRequested;
+
+    TQueue<TArray<uint8>, EQueueMode::Mpsc> PendingChunks;
+    TArray<uint64> ChunkOffsets;
+    int32 NextShotIndex = 0;
+};
+
+// 메모리 맵으로 열어서 슈팅 N, 시간 T 를 인덱스 조회만으로 접근
+class BALLSIMULATOR_API FBallTrajectoryLogReader
+{
+public:
+    FBallTrajectoryLogReader();
+    ~FBallTrajectoryLogReader();
+
+    bool Open(const FString& InFilePath);
+    void Close();
+
+    int32 GetNumShots() const { return ChunkOffsets.Num(); }
+
+    const FBallLogShotHeader* GetShot(int32 ShotIndex) const;
+    TArrayView<const FBallLogSnapshot> GetSnapshots(int32 ShotIndex) const;
+    TArrayView<const FBallLogBounce> GetBounces(int32 ShotIndex) const;
+
+    // 슈팅 ShotIndex 의 Time 시점 위치/회전 (스냅샷 간 보간)
+    bool SampleShot(int32 ShotIndex, float Time, FVector& OutPosition, FQuat& OutRotation) const;
+
+private:
+    bool ReadIndexFromFooter();
+    void RebuildIndexByScan();
+
+    // Offset 의 청크 헤더가 파일 안에 있고, ChunkSize 가 스냅샷/바운스 수와 맞으며 청크 전체가 파일 안에 있는지
+    // 인덱스에는 이 검사를 통과한 청크만 들어가므로 GetSnapshots, GetBounces 는 따로 검사하지 않음
+    bool IsValidChunk(uint64 Offset) const;
+
+    TUniquePtr<IMappedFileHandle> MappedHandle;
+    TUniquePtr<IMappedFileRegion> MappedRegion;
+    const uint8* Data = nullptr;
+    int64 DataSize = 0;
+
+    TArray<uint64> ChunkOffsets;
+};
@@ -0,0 +1,43 @@
+﻿// © 2025 UnrealStudy. All rights reserved.
+// Author: taru00@gmail.com | https://x.com/3devnote
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "BallTrajectoryLog.h"
+#include "BallTrajectoryRecorder.generated.h"
+
+// 경기 중 시뮬레이션된 모든 슈팅을 궤적 기록 파일에 남기는 월드 서브시스템
+// 기록 중일 때 UBallSimulatorComponent 가 시뮬레이션 완료 시 자동으로 추가함
+UCLASS()
+class BALLSIMULATOR_API UBallTrajectoryRecorder : public UWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+    virtual void Deinitialize() override;
+
+    // FileName 은 Saved/BallTrajectories 기준 상대 경로
+    UFUNCTION(BlueprintCallable, Category = "Ballistic Physics Simulator")
+    bool StartRecording(const FString& FileName);
+
+    UFUNCTION(BlueprintCallable, Category = "Ballistic Physics Simulator")
+    void StopRecording();
+
+    UFUNCTION(BlueprintPure, Category = "Ballistic Physics Simulator")
+    bool IsRecording() const { return Writer.IsValid() && Writer->IsOpen(); }
+
+    int32 RecordShot(
+        const FBallLogLaunch& Launch,
+        const FBallSimConstants& Constants,
+        EBallSimFeature Features,
+        const FVector& Origin,
+        TArrayView<const FBallSimSnapshot> Snapshots,
+        TArrayView<const FBallSimBounce> Bounces);
+
+    static FString GetRecordingDirectory();
+
+private:
+    TUniquePtr<FBallTrajectoryLogWriter> Writer;
+};
@@ -0,0 +1,79 @@
+﻿// © 2025 UnrealStudy. All rights reserved.
+// Author: taru00@gmail.com | https://x.com/3devnote
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BallSimulatorTypes.h"
+
+// 샘플링할 시간 목록, Times 를 지정하지 않으면 StartTime 부터 DeltaTime 간격으로 Count 개
+struct FBallSampleTimes
+{
+    TArrayView<const float> Times;
+    float StartTime = 0.f;
+    float DeltaTime = 0.f;
+    int32 Count = 0;
+
+    FBallSampleTimes(TArrayView<const float> InTimes)
+        : Times(InTimes), Count(InTimes.Num()) {}
+
+    FBallSampleTimes(float InStartTime, float InDeltaTime, int32 InCount)
+        : StartTime(InStartTime), DeltaTime(InDeltaTime), Count(FMath::Max(InCount, 0)) {}
+
+    FORCEINLINE float Get(int32 Index) const { return Times.Num() > 0 ? Times[Index] : StartTime + Index * DeltaTime; }
+
+    bool IsSorted() const;
+};
+
+// 스냅샷을 채널별 연속 배열 (SoA) 로 변환해서 여러 시간을 한 번에 보간 (궤적 표시, AI 예측, 분석)
+// 스텝 간격이 고정이므로 구간 탐색은 곱셈 한 번, 시간 정렬 여부와 무관하게 분기 없는 루프로 처리
+// 위치 채널은 스냅샷과 같이 궤적 원점 기준 단정밀도, 샘플링 결과만 월드 기준으로 변환
+class BALLSIMULATOR_API FBallTrajectorySampler
+{
+public:
+    // Snapshots 는 InOrigin 기준 (FBallTrajectory::Snapshots, Origin)
+    void Build(TArrayView<const FBallSimSnapshot> Snapshots, const FVector& InOrigin, float InStepInterval);
+    void Reset();
+
+    bool IsBuiltFor(int32 NumSnapshots, float InStepInterval) const
+    {
+        return Speed.Num() == NumSnapshots && StepInterval == InStepInterval;
+    }
+
+    // 출력 뷰가 비어 있으면 해당 채널 생략, 아니면 Times.Count 이상이어야 함
+    // 구간 밖의 시간은 궤적 양 끝으로 클램프 (GetBallVelocityAtTime 등 단일 샘플 함수와 같은 결과)
+    void Sample(
+        const FBallSampleTimes& Times,
+        TArrayView<FVector> OutPositions,
+        TArrayView<FVector> OutLinearVelocities,
+        TArrayView<FVector> OutAngularVelocities) const;
+
+    // 회전 키프레임과 스냅샷 각속도로 회전 복원, 시간이 정렬되어 있으면 키프레임을 한 번만 훑으며 이어서 적분
+    void SampleRotations(
+        const FBallSampleTimes& Times,
+        TArrayView<const FBallSimSnapshot> Snapshots,
+        TArrayView<const FBallRotationKey> RotationKeys,
+        TArrayView<FQuat> OutRotations) const;
+
+private:
+    // 한 번에 처리하는 샘플 수 (구간 인덱스, 보간 비율 임시 버퍼 크기)
+    static constexpr int32 ChunkSize = 256;
+
+    // 샘플마다 구간 시작 스냅샷 인덱스와 보간 비율
+    void Locate(const FBallSampleTimes& Times, int32 Start, int32 Num, int32* OutIndices, float* OutAlphas) const;
+
+    float StepInterval = 0.f;
+    float InvStepInterval = 0.f;
+    FVector Origin = FVector::ZeroVector;
+
+    TArray<float> PositionX;
+    TArray<float> PositionY;
+    TArray<float> PositionZ;
+    TArray<float> DirectionX;
+    TArray<float> DirectionY;
+    TArray<float> DirectionZ;
+    TArray<float> Speed;
+    TArray<float> AngularX;
+    TArray<float> AngularY;
+    TArray<float> AngularZ;
+};
@@ -0,0 +1,164 @@
+﻿// © 2025 UnrealStudy. All rights reserved.
+// Author: taru00@gmail.com | https://x.com/3devnote
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "BallSimKernel.h"
+#include "BallTrajectoryValidator.generated.h"
+
+DECLARE_CYCLE_STAT(TEXT("Trajectory Validation"), STAT_BallTrajectoryValidation, STATGROUP_Game);
+
+// 클라이언트가 보낸 궤적의 체크포인트, 검증 시 이 상태에서 다음 체크포인트까지 독립적으로 재시뮬레이션
+// 회전은 궤적에 영향을 주지 않으므로 포함하지 않음
+USTRUCT(BlueprintType)
+struct FBallTrajectoryCheckpoint
+{
+    GENERATED_BODY()
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
+    int32 StepIndex = 0;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
+    FVector Position = FVector::ZeroVector;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
+    FVector LinearVelocity = FVector::ZeroVector;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
+    FVector AngularVelocity = FVector::ZeroVector;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
+    int32 BounceCount = 0;
+
+    // 같은 시뮬레이션 안에서 이미 충돌이 있었는지 (연속 충돌 판정용, 월드 시간 대신 전달)
+    UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
+    bool bHasPreviousHit = false;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
+    FVector PreviousHitNormal = FVector::ZeroVector;
+};
+
+USTRUCT(BlueprintType)
+struct FBallClaimedBounce
+{
+    GENERATED_BODY()
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
+    int32 StepIndex = 0;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
+    FVector ImpactPoint = FVector::ZeroVector;
+};
+
+// 클라이언트가 제안하는 궤적 (K 스텝마다의 상태 + 바운스 목록)
+// Checkpoints[0] 은 발사 상태, 마지막 체크포인트는 궤적의 끝
+USTRUCT(BlueprintType)
+struct FBallClaimedTrajectory
+{
+    GENERATED_BODY()
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
+    float StepInterval = 0.f;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
+    TArray<FBallTrajectoryCheckpoint> Checkpoints;
+
+    // StepIndex 오름차순
+    UPROPERTY(VisibleAnywhere, BlueprintReadWrite)
+    TArray<FBallClaimedBounce> Bounces;
+};
+
+// 검증 허용 오차와 비용 상한
+USTRUCT(BlueprintType)
+struct FBallValidationSettings
+{
+    GENERATED_BODY()
+
+    // 구간 끝 체크포인트와의 위치 오차 (cm)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float PositionTolerance = 1.f;
+
+    // 선속도 오차 (cm/s)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float VelocityTolerance = 5.f;
+
+    // 각속도 오차 (rad/s)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float AngularVelocityTolerance = 0.5f;
+
+    // 바운스 충돌 지점 오차 (cm), 바운스 스텝은 정확히 일치해야 함
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    float BouncePositionTolerance = 2.f;
+
+    // 한 구간의 최대 스텝 수, 이보다 체크포인트가 드문 궤적은 거부 (구간당 비용 상한)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    int32 MaxSegmentSteps = 64;
+
+    // 궤적 전체 최대 스텝 수 (슈팅당 비용 상한)
+    UPROPERTY(EditAnywhere, BlueprintReadWrite)
+    int32 MaxTotalSteps = 1000;
+};
+
+UENUM(BlueprintType)
+enum class EBallValidationFailure : uint8
+{
+    None,
+    Malformed,          // 체크포인트 순서, 간격, 스텝 간격이 규칙에 맞지 않음
+    LaunchMismatch,     // 첫 체크포인트가 발사 상태와 다름
+    BounceMismatch,     // 구간 내 바운스 스텝 또는 지점이 다름
+    StateMismatch,      // 구간 끝 상태가 다름
+};
+
+USTRUCT(BlueprintType)
+struct FBallValidationResult
+{
+    GENERATED_BODY()
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    bool bAccepted = false;
+
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    EBallValidationFailure Failure = EBallValidationFailure::None;
+
+    // 처음 일치하지 않는 구간 (거부 시), 구간 i 는 Checkpoints[i] ~ Checkpoints[i + 1]
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    int32 FailedSegment = INDEX_NONE;
+
+    // 궤적이 어긋나기 시작한 시간 (발사 기준 초)
+    // 바운스 불일치는 해당 바운스 스텝, 상태 불일치는 구간 시작 (마지막으로 일치가 확인된 체크포인트)
+    UPROPERTY(VisibleAnywhere, BlueprintReadOnly)
+    float DivergenceTime = -1.f;
+};
+
+// 체크포인트 구간별 병렬 재시뮬레이션으로 클라이언트 궤적을 검증
+// 각 구간은 클라이언트 체크포인트에서 시작하므로 서로 독립적이고, 비용은 MaxSegmentSteps * 구간 수 로 제한되며 코어 수만큼 나뉨
+// 앞 구간이 실패하면 뒤 구간은 진행을 멈춤 (가장 앞의 실패 구간만 결과로 사용)
+struct BALLSIMULATOR_API FBallTrajectoryValidator
+{
+    // Context 의 World, 상수, 장애물, 거리장으로 재시뮬레이션 (출력 버퍼는 사용하지 않음), 호출 스레드는 모든 구간이 끝날 때까지 대기
+    // Context.Corridor, SurfaceCache 는 사용 여부만 보고 구간마다 따로 만들어 사용 (진행 중 갱신되므로 구간끼리 공유하지 않음)
+    static FBallValidationResult Validate(
+        const FBallSimContext& Context,
+        EBallSimFeature Features,
+        const FBallSimState& LaunchState,
+        const FBallClaimedTrajectory& Claim,
+        const FBallValidationSettings& Settings);
+
+    // 시뮬레이션 결과 (Run 이 기록한 체크포인트, 바운스, 최종 상태) 로 제출용 궤적 구성
+    // WorldTime, Origin 은 시뮬레이션에 사용한 Context.WorldTime, Context.Origin
+    static void MakeClaim(
+        TArrayView<const FBallSimCheckpoint> Checkpoints,
+        const FVector& Origin,
+        TArrayView<const FBallSimBounce> Bounces,
+        const FBallSimState& FinalState,
+        float WorldTime,
+        float StepInterval,
+        FBallClaimedTrajectory& OutClaim);
+
+    // 체크포인트는 월드 기준, 상태는 Origin 기준
+    static FBallTrajectoryCheckpoint MakeCheckpoint(const FBallSimState& State, const FVector& Origin, float WorldTime);
+
+    // 검증용 시작 상태, bHasPreviousHit 는 WorldTime 과 같은 PreviousHitTime 으로 복원
+    static FBallSimState MakeState(const FBallTrajectoryCheckpoint& Checkpoint, const FVector& Origin, float WorldTime);
+};
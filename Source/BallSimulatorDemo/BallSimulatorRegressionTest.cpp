@@ -0,0 +1,579 @@
+﻿// © 2025 UnrealStudy. All rights reserved.
+// Author: taru00@gmail.com | https://x.com/3devnote
+
+#include "CoreMinimal.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/StaticMeshActor.h"
+#include "Components/StaticMeshComponent.h"
+#include "BallSimulatorComponent.h"
+#include "BallPhysicsProfile.h"
+#include "BallDistanceField.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/*
+ * 정확도 대비 비용 회귀 테스트
+ * 대표 슈팅 매트릭스를 각 시뮬레이터 모드로 실행해서 두 기준과 비교하고 실행 시간을 기준값과 비교한다.
+ *  - 참조 적분기 : 테스트 안에서 같은 운동 방정식 (중력, 감쇠, 마그누스) 을 RK4 미세 스텝으로 적분하고 지면 / 골대 포스트 첫 접촉을 해석적으로 구함
+ *    커널의 반암시적 오일러 오차 한계 (0.5 × 가속도 × 스텝 × 시간) 안에 있는지 첫 접촉 전까지의 비행과 첫 접촉 시점으로 검사 (커널 자체와 독립)
+ *  - Generic 모드 : 접촉 이후를 포함한 전체 궤적으로 최적화 모드 (프로파일, 배치, 이어가기, 통로, 거리장) 가 같은 결과인지 검사
+ * 기준 파일이 필요 없으므로 항상 실행됨, 비용 기준값만 장비마다 다르므로 Test/BallSimRegression 에 없으면 비교를 생략 (BallSim.Regression.RecordCostBaseline 1 로 기록)
+ */
+
+static TAutoConsoleVariable<int32> CVarBallSimRecordCostBaseline(
+	TEXT("BallSim.Regression.RecordCostBaseline"),
+	0,
+	TEXT("1 : 비용 기준값을 현재 장비의 실행 시간으로 다시 기록"));
+
+static TAutoConsoleVariable<float> CVarBallSimCostTolerance(
+	TEXT("BallSim.Regression.CostTolerance"),
+	0.5f,
+	TEXT("비용 기준값 대비 허용 증가율 (0.5 = 50%)"));
+
+namespace BallSimRegression
+{
+	struct FShotCase
+	{
+		const TCHAR* Name;
+		FVector Position;
+		FVector Direction;
+		float Speed;
+		FVector SpinAxis;
+		float SpinSpeed;
+	};
+
+	struct FModeOutput
+	{
+		TArray<FBallSnapshot> Snapshots;
+		TArray<FBallBounce> Bounces;
+		bool bHasBounces = true;
+	};
+
+	struct FSimulatorMode
+	{
+		const TCHAR* Name;
+
+		// Generic 모드 대비 허용 오차 (cm, cm, 초)
+		float MaxPositionError;
+		float RmsPositionError;
+		float BounceTimeError;
+
+		TFunction<void(UWorld*, const FShotCase&, FModeOutput&)> Run;
+	};
+
+	static constexpr float BallMass = 0.43f;
+	static constexpr float BallRadius = 11.0f;
+	static constexpr int32 SimulationSteps = 300;
+	static constexpr float StepInterval = 1.f / 60.f;
+	static constexpr int32 CostIterations = 20;
+
+	// 지면 Z = 0, 골대 포스트 X = 1100 (반지름 6cm, 높이 244cm)
+	static constexpr float PostX = 1100.f;
+	static constexpr float PostRadius = 6.f;
+	static constexpr float PostHeight = 244.f;
+
+	// 참조 적분기 스텝 = StepInterval / ReferenceSubsteps
+	static constexpr int32 ReferenceSubsteps = 64;
+
+	// 비행 오차 한계 배율과 여유 (cm), 첫 접촉 시점 허용 오차 (커널은 스텝 끝 위치로 Sweep 하므로 한 스텝)
+	static constexpr float FlightErrorScale = 1.25f;
+	static constexpr float FlightErrorSlack = 0.05f;
+	static constexpr float ContactTimeError = StepInterval;
+	static const FShotCase ShotCases[] =
+	{
+		{ TEXT("DrivenPass"),     FVector(0, 0, 11.f),    FVector(1, 0, 0.05f),     2200.f, FVector(0, 1, 0),  20.f },
+		{ TEXT("CurledFreeKick"), FVector(0, -300, 11.f), FVector(0.9f, 0.1f, 0.25f), 2600.f, FVector(0, 0, 1), 60.f },
+		{ TEXT("Lob"),            FVector(0, 0, 11.f),    FVector(0.6f, 0, 0.8f),   1800.f, FVector(0, -1, 0), 15.f },
+		{ TEXT("Knuckleball"),    FVector(0, 0, 11.f),    FVector(0.95f, 0, 0.2f),  3000.f, FVector(0, 1, 0),  2.f },
+		{ TEXT("GroundRoll"),     FVector(0, 0, 11.1f),   FVector(1, 0, 0),          800.f, FVector(0, 1, 0),  0.f },
+		{ TEXT("PostHit"),        FVector(0, 0, 11.f),    FVector(1, 0, 0.12f),     2500.f, FVector(0, 0, 1),  0.f },
+	};
+
+	static void RunComponent(UWorld* World, UBallPhysicsProfile* Profile, const FShotCase& Shot, FModeOutput& Out)
+	{
+		UBallSimulatorComponent* Simulator = NewObject<UBallSimulatorComponent>(World);
+		Simulator->PhysicsProfile = Profile;
+		Simulator->SimulateBallPhysics(World, BallMass, BallRadius, Shot.Position, FQuat::Identity,
+			Shot.Direction.GetSafeNormal(), Shot.Speed, Shot.SpinAxis, Shot.SpinSpeed, SimulationSteps, StepInterval);
+		Out.Snapshots = Simulator->K2_GetSnapshots();
+		Out.Bounces = Simulator->K2_GetBounces();
+	}
+
+	// BallSim.DistanceField.Enable 을 범위 안에서만 바꿈 (거리장 모드 외에는 매 스텝 전체 Sweep)
+	struct FScopedDistanceField
+	{
+		IConsoleVariable* Variable;
+		int32 Previous;
+
+		explicit FScopedDistanceField(bool bEnable)
+			: Variable(IConsoleManager::Get().FindConsoleVariable(TEXT("BallSim.DistanceField.Enable")))
+			, Previous(Variable ? Variable->GetInt() : 1)
+		{
+			if (Variable)
+			{
+				Variable->Set(bEnable ? 1 : 0, ECVF_SetByCode);
+			}
+		}
+
+		~FScopedDistanceField()
+		{
+			if (Variable)
+			{
+				Variable->Set(Previous, ECVF_SetByCode);
+			}
+		}
+	};
+
+	// 컴포넌트 기본값과 같은 튜닝의 프로파일 (특수화 커널 경로 검증용)
+	static UBallPhysicsProfile* MakeDefaultProfile()
+	{
+		UBallPhysicsProfile* Profile = NewObject<UBallPhysicsProfile>();
+		Profile->Mass = BallMass;
+		Profile->Radius = BallRadius;
+		return Profile;
+	}
+
+	static TArray<FSimulatorMode> MakeSimulatorModes()
+	{
+		TArray<FSimulatorMode> Modes;
+
+		Modes.Add({ TEXT("Generic"), 0.01f, 0.01f, 0.0001f,
+			[](UWorld* World, const FShotCase& Shot, FModeOutput& Out)
+			{
+				RunComponent(World, nullptr, Shot, Out);
+			} });
+
+		Modes.Add({ TEXT("Profile"), 0.01f, 0.01f, 0.0001f,
+			[](UWorld* World, const FShotCase& Shot, FModeOutput& Out)
+			{
+				RunComponent(World, MakeDefaultProfile(), Shot, Out);
+			} });
+
+		Modes.Add({ TEXT("Batch"), 0.01f, 0.01f, 0.0001f,
+			[](UWorld* World, const FShotCase& Shot, FModeOutput& Out)
+			{
+				// 발사 위치를 원점으로 시작
+				FBallSimState State;
+				State.LinearVelocity = FVector3f(Shot.Direction.GetSafeNormal() * Shot.Speed);
+				State.AngularVelocity = FVector3f(Shot.SpinAxis.GetSafeNormal() * Shot.SpinSpeed);
+
+				TArray<TArray<FBallSimSnapshot>> Snapshots;
+				UBallSimulatorComponent::SimulateBallPhysicsBatch(World, MakeDefaultProfile(), Shot.Position, MakeArrayView(&State, 1), SimulationSteps, StepInterval, &Snapshots);
+				Out.Snapshots = FBallSimSnapshot::ToSnapshots(Snapshots[0], Shot.Position);
+				Out.bHasBounces = false;
+			} });
+
+		// 변경 없이 중간 체크포인트부터 재시뮬레이션한 결과가 전체 시뮬레이션과 같아야 함
+		// 체크포인트는 샷 원점 기준 단정밀도로 저장되므로 배정밀도 경로 대비 양자화 오차도 함께 검증됨
+		Modes.Add({ TEXT("Resume"), 0.01f, 0.01f, 0.0001f,
+			[](UWorld* World, const FShotCase& Shot, FModeOutput& Out)
+			{
+				UBallSimulatorComponent* Simulator = NewObject<UBallSimulatorComponent>(World);
+				Simulator->SimulateBallPhysics(World, BallMass, BallRadius, Shot.Position, FQuat::Identity,
+					Shot.Direction.GetSafeNormal(), Shot.Speed, Shot.SpinAxis, Shot.SpinSpeed, SimulationSteps, StepInterval);
+				Simulator->ResimulateFromTime(World, SimulationSteps * StepInterval * 0.5f);
+				Out.Snapshots = Simulator->K2_GetSnapshots();
+				Out.Bounces = Simulator->K2_GetBounces();
+			} });
+
+		// 예상 경로 주변 후보 충돌체에만 Sweep, 후보 밖 충돌체를 놓치면 골든과 달라짐
+		Modes.Add({ TEXT("Corridor"), 0.01f, 0.01f, 0.0001f,
+			[](UWorld* World, const FShotCase& Shot, FModeOutput& Out)
+			{
+				UBallSimulatorComponent* Simulator = NewObject<UBallSimulatorComponent>(World);
+				Simulator->bUseCollisionCorridor = true;
+				Simulator->SimulateBallPhysics(World, BallMass, BallRadius, Shot.Position, FQuat::Identity,
+					Shot.Direction.GetSafeNormal(), Shot.Speed, Shot.SpinAxis, Shot.SpinSpeed, SimulationSteps, StepInterval);
+				Out.Snapshots = Simulator->K2_GetSnapshots();
+				Out.Bounces = Simulator->K2_GetBounces();
+			} });
+
+		// 거리장으로 정적 충돌체 Sweep 생략, 여유 거리가 보수적이면 결과는 같아야 함
+		Modes.Add({ TEXT("DistanceField"), 0.01f, 0.01f, 0.0001f,
+			[](UWorld* World, const FShotCase& Shot, FModeOutput& Out)
+			{
+				const FScopedDistanceField EnableDistanceField(true);
+				RunComponent(World, nullptr, Shot, Out);
+			} });
+
+		return Modes;
+	}
+
+	static FString GetCostBaselinePath()
+	{
+		return FPaths::ProjectDir() / TEXT("Test/BallSimRegression/CostBaseline.csv");
+	}
+
+	// 참조 적분기 결과, 첫 접촉 전까지 StepInterval 간격 위치
+	struct FReferenceFlight
+	{
+		TArray<FVector> Positions;
+		float ContactTime = -1.f;
+
+		// 비행 중 가속도 크기 최대값 (오차 한계 계산용)
+		float MaxAcceleration = 0.f;
+	};
+
+	// 테스트 월드 정적 충돌체까지의 간격 (공 표면 기준), 0 이하이면 접촉
+	static float GetReferenceGap(const FVector& Position)
+	{
+		const float GroundGap = (float)Position.Z - BallRadius;
+		const float PostGap = Position.Z <= PostHeight
+			? (float)FVector2D::Distance(FVector2D(Position.X, Position.Y), FVector2D(PostX, 0.f)) - PostRadius - BallRadius
+			: TNumericLimits<float>::Max();
+		return FMath::Min(GroundGap, PostGap);
+	}
+
+	// 커널과 같은 운동 방정식 (중력, 선형 / 회전 감쇠, 마그누스) 을 RK4 로 적분
+	static FReferenceFlight IntegrateReference(const FBallSimConstants& C, const FShotCase& Shot)
+	{
+		struct FDerivative
+		{
+			FVector Velocity;
+			FVector Acceleration;
+			FVector AngularAcceleration;
+		};
+
+		auto Evaluate = [&C](const FVector& Velocity, const FVector& AngularVelocity)
+		{
+			FDerivative D;
+			D.Velocity = Velocity;
+			D.Acceleration = FVector(C.Gravity) - Velocity * C.LinearDamping;
+			if (AngularVelocity.Size() > C.MinSpinForMagnus)
+			{
+				D.Acceleration += FVector::CrossProduct(AngularVelocity, Velocity) * C.SpinMagnusFactor;
+			}
+			D.AngularAcceleration = -AngularVelocity * C.AngularDamping;
+			return D;
+		};
+
+		FReferenceFlight Flight;
+		FVector X = Shot.Position;
+		FVector V = Shot.Direction.GetSafeNormal() * Shot.Speed;
+		FVector W = Shot.SpinAxis.GetSafeNormal() * Shot.SpinSpeed;
+		Flight.Positions.Add(X);
+
+		const float H = StepInterval / ReferenceSubsteps;
+		float Gap = GetReferenceGap(X);
+		for (int32 Substep = 1; Substep <= SimulationSteps * ReferenceSubsteps; ++Substep)
+		{
+			const FDerivative K1 = Evaluate(V, W);
+			const FDerivative K2 = Evaluate(V + K1.Acceleration * (0.5f * H), W + K1.AngularAcceleration * (0.5f * H));
+			const FDerivative K3 = Evaluate(V + K2.Acceleration * (0.5f * H), W + K2.AngularAcceleration * (0.5f * H));
+			const FDerivative K4 = Evaluate(V + K3.Acceleration * H, W + K3.AngularAcceleration * H);
+
+			const FVector NextX = X + (K1.Velocity + 2.f * K2.Velocity + 2.f * K3.Velocity + K4.Velocity) * (H / 6.f);
+			V += (K1.Acceleration + 2.f * K2.Acceleration + 2.f * K3.Acceleration + K4.Acceleration) * (H / 6.f);
+			W += (K1.AngularAcceleration + 2.f * K2.AngularAcceleration + 2.f * K3.AngularAcceleration + K4.AngularAcceleration) * (H / 6.f);
+			Flight.MaxAcceleration = FMath::Max(Flight.MaxAcceleration, (float)K1.Acceleration.Size());
+
+			// 미세 스텝 안에서는 간격이 선형으로 변한다고 보고 접촉 시점 보간
+			const float NextGap = GetReferenceGap(NextX);
+			if (NextGap <= 0.f)
+			{
+				Flight.ContactTime = (Substep - 1 + Gap / FMath::Max(Gap - NextGap, UE_SMALL_NUMBER)) * H;
+				return Flight;
+			}
+
+			X = NextX;
+			Gap = NextGap;
+			if (Substep % ReferenceSubsteps == 0)
+			{
+				Flight.Positions.Add(X);
+			}
+		}
+		return Flight;
+	}
+
+	// 고정 스텝 스냅샷의 Time 시점 위치 (스냅샷 간 선형 보간)
+	static FVector SampleSnapshots(const TArray<FBallSnapshot>& Snapshots, float Time)
+	{
+		if (Snapshots.Num() == 0)
+		{
+			return FVector::ZeroVector;
+		}
+
+		const float Index = FMath::Clamp((Time - Snapshots[0].Time) / StepInterval, 0.f, (float)(Snapshots.Num() - 1));
+		const int32 IndexA = FMath::Min((int32)Index, Snapshots.Num() - 2);
+		if (IndexA < 0)
+		{
+			return Snapshots[0].Position;
+		}
+		return FMath::Lerp(Snapshots[IndexA].Position, Snapshots[IndexA + 1].Position, Index - IndexA);
+	}
+
+	static TMap<FString, double> LoadCostBaseline()
+	{
+		TMap<FString, double> Baseline;
+		TArray<FString> Lines;
+		if (FFileHelper::LoadFileToStringArray(Lines, *GetCostBaselinePath()))
+		{
+			for (const FString& Line : Lines)
+			{
+				FString Key, Value;
+				if (Line.Split(TEXT(","), &Key, &Value, ESearchCase::IgnoreCase, ESearchDir::FromEnd))
+				{
+					Baseline.Add(Key, FCString::Atod(*Value));
+				}
+			}
+		}
+		return Baseline;
+	}
+
+	static void SaveCostBaseline(const TMap<FString, double>& Baseline)
+	{
+		TArray<FString> Lines;
+		for (const TPair<FString, double>& Pair : Baseline)
+		{
+			Lines.Add(FString::Printf(TEXT("%s,%.3f"), *Pair.Key, Pair.Value));
+		}
+		Lines.Sort();
+		FFileHelper::SaveStringArrayToFile(Lines, *GetCostBaselinePath());
+	}
+
+	static float GetBounceTime(int32 SnapshotIndex, float TimeToBeforeHit)
+	{
+		return (SnapshotIndex - 1) * StepInterval + TimeToBeforeHit;
+	}
+
+	// 지면과 골대 포스트만 있는 테스트 월드
+	static UWorld* CreateTestWorld()
+	{
+		UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+		FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+		WorldContext.SetCurrentWorld(World);
+
+		World->InitializeActorsForPlay(FURL());
+		World->BeginPlay();
+
+		UStaticMesh* Cube = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+		UStaticMesh* Cylinder = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cylinder.Cylinder"));
+
+		AStaticMeshActor* Ground = World->SpawnActor<AStaticMeshActor>(FVector(0, 0, -50.f), FRotator::ZeroRotator);
+		Ground->GetStaticMeshComponent()->SetStaticMesh(Cube);
+		Ground->SetActorScale3D(FVector(100.f, 100.f, 1.f));
+
+		AStaticMeshActor* Post = World->SpawnActor<AStaticMeshActor>(FVector(1100.f, 0, 122.f), FRotator::ZeroRotator);
+		Post->GetStaticMeshComponent()->SetStaticMesh(Cylinder);
+		Post->SetActorScale3D(FVector(0.12f, 0.12f, 2.44f));
+
+		// 정적 충돌체가 Scene Query 구조에 반영되도록 한 프레임 진행
+		World->Tick(LEVELTICK_All, StepInterval);
+
+		// DistanceField 모드용, 다른 모드는 FScopedDistanceField 로 끔
+		if (UBallDistanceFieldSubsystem* DistanceField = World->GetSubsystem<UBallDistanceFieldSubsystem>())
+		{
+			DistanceField->BakeDistanceField(FBox(FVector(-1000.f, -1500.f, -100.f), FVector(4000.f, 1500.f, 2000.f)));
+		}
+		return World;
+	}
+
+	static void DestroyTestWorld(UWorld* World)
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBallSimAccuracyRegressionTest, "BallSimulator.Regression.AccuracyVsCost",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FBallSimAccuracyRegressionTest::RunTest(const FString& Parameters)
+{
+	using namespace BallSimRegression;
+
+	UWorld* World = CreateTestWorld();
+	const FScopedDistanceField DisableDistanceField(false);
+	const TArray<FSimulatorMode> Modes = MakeSimulatorModes();
+	const bool bRecordCost = CVarBallSimRecordCostBaseline.GetValueOnGameThread() != 0;
+
+	// 참조 적분기와 모드 간 비교 기준 (Generic 모드, 접촉 이후 포함) 은 슈팅마다 한번만 계산
+	const FBallSimConstants Constants = NewObject<UBallSimulatorComponent>(World)->MakeSimConstants(BallMass, BallRadius, StepInterval);
+	TArray<FReferenceFlight> References;
+	TArray<FModeOutput> Baselines;
+	for (const FShotCase& Shot : ShotCases)
+	{
+		References.Add(IntegrateReference(Constants, Shot));
+		Modes[0].Run(World, Shot, Baselines.AddDefaulted_GetRef());
+	}
+
+	TMap<FString, double> CostBaseline = LoadCostBaseline();
+	if (CostBaseline.Num() == 0 && !bRecordCost)
+	{
+		AddInfo(FString::Printf(TEXT("No cost baseline at %s, cost checks skipped (record with BallSim.Regression.RecordCostBaseline 1)"), *GetCostBaselinePath()));
+	}
+	const double CostTolerance = CVarBallSimCostTolerance.GetValueOnGameThread();
+
+	AddInfo(TEXT("Mode           Shot             RefErr(cm)  RefBudget  ContactErr(s)  MaxErr(cm)  RmsErr(cm)  BounceErr(s)  Cost(us)"));
+
+	for (const FSimulatorMode& Mode : Modes)
+	{
+		for (int32 ShotIndex = 0; ShotIndex < UE_ARRAY_COUNT(ShotCases); ++ShotIndex)
+		{
+			const FShotCase& Shot = ShotCases[ShotIndex];
+			const FReferenceFlight& Reference = References[ShotIndex];
+			const FModeOutput& Baseline = Baselines[ShotIndex];
+
+			// 비용은 반복 실행 중 최소값 사용 (스케줄링 노이즈 제거)
+			FModeOutput Output;
+			double BestSeconds = TNumericLimits<double>::Max();
+			for (int32 Iteration = 0; Iteration < CostIterations; ++Iteration)
+			{
+				Output = FModeOutput();
+				const double StartSeconds = FPlatformTime::Seconds();
+				Mode.Run(World, Shot, Output);
+				BestSeconds = FMath::Min(BestSeconds, FPlatformTime::Seconds() - StartSeconds);
+			}
+			const double CostMicroseconds = BestSeconds * 1e6;
+
+			// 참조 적분기 대비 비행 오차 : 첫 접촉 전 스냅샷만, 한계는 반암시적 오일러의 전역 오차 0.5 × a × dt × t
+			bool bFlightExceeded = false;
+			double ReferenceError = 0.0;
+			double ReferenceBudget = 0.0;
+			for (const FBallSnapshot& Snapshot : Output.Snapshots)
+			{
+				// 어느 쪽이든 먼저 접촉하면 이후는 접촉 모델 비교이므로 중단
+				const int32 ReferenceIndex = FMath::RoundToInt(Snapshot.Time / StepInterval);
+				if (Snapshot.hitCount > 0 || !Reference.Positions.IsValidIndex(ReferenceIndex))
+				{
+					break;
+				}
+
+				const double Error = FVector::Dist(Reference.Positions[ReferenceIndex], Snapshot.Position);
+				const double Budget = FlightErrorScale * 0.5 * Reference.MaxAcceleration * StepInterval * Snapshot.Time + FlightErrorSlack;
+				bFlightExceeded |= Error > Budget;
+				if (Error > ReferenceError)
+				{
+					ReferenceError = Error;
+					ReferenceBudget = Budget;
+				}
+			}
+
+			// 첫 접촉 시점 (참조 적분기는 해석적 충돌면, 커널은 첫 바운스)
+			double ContactError = 0.0;
+			if (Output.bHasBounces && Reference.ContactTime >= 0.f)
+			{
+				ContactError = Output.Bounces.Num() > 0
+					? FMath::Abs(GetBounceTime(Output.Bounces[0].SnapshotIndex, Output.Bounces[0].TimeToBeforeHit) - Reference.ContactTime)
+					: TNumericLimits<float>::Max();
+			}
+
+			// Generic 모드 대비 위치 오차 : 모드의 스냅샷 시간에서 Generic 궤적 샘플과 비교
+			double MaxError = 0.0;
+			double SumSquaredError = 0.0;
+			for (const FBallSnapshot& Snapshot : Output.Snapshots)
+			{
+				const double Error = FVector::Dist(SampleSnapshots(Baseline.Snapshots, Snapshot.Time), Snapshot.Position);
+				MaxError = FMath::Max(MaxError, Error);
+				SumSquaredError += Error * Error;
+			}
+			const double RmsError = Output.Snapshots.Num() > 0 ? FMath::Sqrt(SumSquaredError / Output.Snapshots.Num()) : 0.0;
+
+			// Generic 모드 대비 바운스 타이밍 오차 : 순서대로 짝지어 비교, 개수가 다르면 실패
+			double BounceError = 0.0;
+			if (Output.bHasBounces)
+			{
+				if (Baseline.Bounces.Num() != Output.Bounces.Num())
+				{
+					AddError(FString::Printf(TEXT("%s/%s : bounce count %d, Generic %d"), Mode.Name, Shot.Name, Output.Bounces.Num(), Baseline.Bounces.Num()));
+				}
+
+				const int32 NumPairs = FMath::Min(Baseline.Bounces.Num(), Output.Bounces.Num());
+				for (int32 i = 0; i < NumPairs; ++i)
+				{
+					const float BaselineTime = GetBounceTime(Baseline.Bounces[i].SnapshotIndex, Baseline.Bounces[i].TimeToBeforeHit);
+					const float ModeTime = GetBounceTime(Output.Bounces[i].SnapshotIndex, Output.Bounces[i].TimeToBeforeHit);
+					BounceError = FMath::Max(BounceError, (double)FMath::Abs(BaselineTime - ModeTime));
+				}
+			}
+
+			AddInfo(FString::Printf(TEXT("%-14s %-16s %10.4f  %9.4f  %13.5f  %10.4f  %10.4f  %12.5f  %8.1f"),
+				Mode.Name, Shot.Name, ReferenceError, ReferenceBudget, ContactError, MaxError, RmsError, BounceError, CostMicroseconds));
+
+			if (bFlightExceeded || ContactError > ContactTimeError)
+			{
+				AddError(FString::Printf(TEXT("%s/%s diverges from the reference integrator (flight %.4f/%.4f cm, contact %.5f/%.5f s)"),
+					Mode.Name, Shot.Name, ReferenceError, ReferenceBudget, ContactError, ContactTimeError));
+			}
+
+			if (MaxError > Mode.MaxPositionError || RmsError > Mode.RmsPositionError || BounceError > Mode.BounceTimeError)
+			{
+				AddError(FString::Printf(TEXT("%s/%s exceeds error budget against Generic (max %.4f/%.4f, rms %.4f/%.4f, bounce %.5f/%.5f)"),
+					Mode.Name, Shot.Name, MaxError, Mode.MaxPositionError, RmsError, Mode.RmsPositionError, BounceError, Mode.BounceTimeError));
+			}
+
+			const FString CostKey = FString::Printf(TEXT("%s/%s"), Mode.Name, Shot.Name);
+			const double* BaselineCost = CostBaseline.Find(CostKey);
+			if (bRecordCost)
+			{
+				CostBaseline.Add(CostKey, CostMicroseconds);
+			}
+			else if (BaselineCost && CostMicroseconds > *BaselineCost * (1.0 + CostTolerance))
+			{
+				AddError(FString::Printf(TEXT("%s cost regressed : %.1f us (baseline %.1f us)"), *CostKey, CostMicroseconds, *BaselineCost));
+			}
+		}
+	}
+
+	if (bRecordCost)
+	{
+		AddInfo(FString::Printf(TEXT("Recorded cost baseline : %s"), *GetCostBaselinePath()));
+		SaveCostBaseline(CostBaseline);
+	}
+
+	DestroyTestWorld(World);
+	return !HasAnyErrors();
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBallSimTrajectoryValidationTest, "BallSimulator.Regression.TrajectoryValidation",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FBallSimTrajectoryValidationTest::RunTest(const FString& Parameters)
+{
+	using namespace BallSimRegression;
+
+	UWorld* World = CreateTestWorld();
+
+	for (const FShotCase& Shot : ShotCases)
+	{
+		const FVector Direction = Shot.Direction.GetSafeNormal();
+
+		// 클라이언트 시뮬레이션 결과로 만든 궤적은 서버에서 그대로 통과해야 함
+		UBallSimulatorComponent* Client = NewObject<UBallSimulatorComponent>(World);
+		Client->SimulateBallPhysics(World, BallMass, BallRadius, Shot.Position, FQuat::Identity,
+			Direction, Shot.Speed, Shot.SpinAxis, Shot.SpinSpeed, SimulationSteps, StepInterval);
+
+		FBallClaimedTrajectory Claim;
+		if (!TestTrue(FString::Printf(TEXT("%s claim"), Shot.Name), Client->MakeClaimedTrajectory(Claim)))
+		{
+			continue;
+		}
+
+		UBallSimulatorComponent* Server = NewObject<UBallSimulatorComponent>(World);
+		const FBallValidationResult Accepted = Server->ValidateClaimedTrajectory(World, BallMass, BallRadius, Shot.Position,
+			Direction, Shot.Speed, Shot.SpinAxis, Shot.SpinSpeed, StepInterval, Claim);
+		TestTrue(FString::Printf(TEXT("%s accepted"), Shot.Name), Accepted.bAccepted);
+
+		// 중간 체크포인트를 조작하면 그 체크포인트로 끝나는 구간에서 거부되어야 함
+		const int32 Tampered = Claim.Checkpoints.Num() / 2;
+		Claim.Checkpoints[Tampered].Position.Z += 50.f;
+
+		const FBallValidationResult Rejected = Server->ValidateClaimedTrajectory(World, BallMass, BallRadius, Shot.Position,
+			Direction, Shot.Speed, Shot.SpinAxis, Shot.SpinSpeed, StepInterval, Claim);
+		TestFalse(FString::Printf(TEXT("%s tampered accepted"), Shot.Name), Rejected.bAccepted);
+		TestEqual(FString::Printf(TEXT("%s failed segment"), Shot.Name), Rejected.FailedSegment, Tampered - 1);
+		TestEqual(FString::Printf(TEXT("%s divergence time"), Shot.Name), Rejected.DivergenceTime,
+			Claim.Checkpoints[Tampered - 1].StepIndex * StepInterval, 1.e-4f);
+	}
+
+	DestroyTestWorld(World);
+	return !HasAnyErrors();
+}
+
+#endif // WITH_DEV_AUTOMATION_TESTS
@@ -29,7 +29,6 @@ void ABallSimulatorTest::StartTest()
 
     SetupSpline();
 
-    TArray<FBallSnapshot> Snapshots;
     FVector InitPos(0, 0, 300);
     FVector InitDir(0.5, 0, 0.5);
     FVector IntAngVel(0, 0, 200);    
@@ -42,7 +41,7 @@ void ABallSimulatorTest::StartTest()
     float Radius = 11.0f;
     BallSimulatorComp->SimulateBallPhysics(GetWorld(), Mass, Radius, InitPos, InitRot, InitDir, Speed, InitSpinAxis, SpinSpeed, 100, 0.016f);
 
-    if (Snapshots.Num() == 0)
+    if (BallSimulatorComp->GetSnapshots().Num() == 0)
     {
         FinishTest(EFunctionalTestResult::Failed, TEXT("No snapshots generated."));
         return;
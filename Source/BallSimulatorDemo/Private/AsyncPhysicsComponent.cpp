@@ -1,34 +1,160 @@
-// Fill out your copyright notice in the Description page of Project Settings.
-
+﻿// © 2025 UnrealStudy. All rights reserved.
+// Author: taru00@gmail.com | https://x.com/3devnote
 
 #include "AsyncPhysicsComponent.h"
+#include "BallPhysicsProfile.h"
+#include "Engine/World.h"
 
 // Sets default values for this component's properties
 UAsyncPhysicsComponent::UAsyncPhysicsComponent()
 {
-	// Set this component to be initialized when the game starts, and to be ticked every frame.  You can turn these features
-	// off to improve performance if you don't need them.
+	// 게임 월드 물리 결과가 반영된 뒤 Sweep 하도록 물리 이후에 진행
 	PrimaryComponentTick.bCanEverTick = true;
-
-	// ...
+	PrimaryComponentTick.TickGroup = TG_PostPhysics;
 }
 
-
 // Called when the game starts
 void UAsyncPhysicsComponent::BeginPlay()
 {
 	Super::BeginPlay();
 
-	// ...
-	
+	LatestState.Position = GetComponentLocation();
+	LatestState.Rotation = GetComponentQuat();
+	PreviousState = LatestState;
+}
+
+void UAsyncPhysicsComponent::LaunchBall(
+	const FVector& InitialPosition,
+	const FQuat& InitialRotation,
+	const FVector& InitialDirection,
+	const float InitialSpeed,
+	const FVector& InitialSpinAxis,
+	const float InitialSpinSpeed)
+{
+	UWorld* World = GetWorld();
+	if (!World || StepInterval <= 0.f)
+	{
+		return;
+	}
+
+	FBallSimConstants Constants;
+	EBallSimFeature Features = EBallSimFeature::All;
+	if (PhysicsProfile)
+	{
+		Constants = PhysicsProfile->MakeConstants(StepInterval, BallMass, BallRadius);
+		Features = PhysicsProfile->GetFeatures();
+	}
+	else
+	{
+		Constants.StepInterval = StepInterval;
+		Constants.SetMassProperties(BallMass, BallRadius, FVector(0.5f));
+		Constants.UpdateStepScales();
+	}
+
+	// 키네마틱 장애물은 예측 전용
+	Features &= ~EBallSimFeature::Obstacles;
+
+	// 넘겨받을 강체가 없으므로 구름 접촉, 바운스 수로는 멈추지 않고 정지 (Rest) 까지 진행
+	Constants.bStopOnRollingContact = false;
+	Constants.MaxAllowedBounce = -1;
+
+	// 커널 상태는 발사 위치 기준
+	Context = FBallSimContext();
+	Context.World = World;
+	Context.Constants = Constants;
+	Context.Origin = InitialPosition;
+	Context.CollisionShape = FCollisionShape::MakeSphere(Constants.Radius);
+	Context.QueryParams.bReturnPhysicalMaterial = EnumHasAnyFlags(Features, EBallSimFeature::PhysMaterial);
+	Context.QueryParams.AddIgnoredActor(GetOwner());
+
+	// 발사마다 튜닝이 바뀔 수 있으므로 재질별 응답도 다시 계산
+	SurfaceCache.Reset();
+	Context.SurfaceCache = &SurfaceCache;
+
+	State = FBallSimState();
+	State.Rotation = FQuat4f(InitialRotation);
+	State.LinearVelocity = FVector3f(InitialDirection.GetSafeNormal() * InitialSpeed);
+	State.AngularVelocity = FVector3f(InitialSpinAxis.GetSafeNormal() * InitialSpinSpeed);
+	Kernel = &FBallSimKernel::Get(Features);
+
+	SimTime = World->GetTimeSeconds();
+	StepAccumulator = 0.f;
+
+	// 발사 상태에서 바로 보간 시작
+	LatestState = MakeBallState();
+	PreviousState = LatestState;
+	SetWorldLocationAndRotation(LatestState.Position, LatestState.Rotation);
 }
 
+void UAsyncPhysicsComponent::StopBall()
+{
+	Kernel = nullptr;
+}
+
+FAsyncBallState UAsyncPhysicsComponent::MakeBallState() const
+{
+	FAsyncBallState Result;
+	Result.Position = Context.ToWorld(State.Position);
+	Result.Rotation = FQuat(State.Rotation);
+	Result.LinearVelocity = FVector(State.LinearVelocity);
+	Result.AngularVelocity = FVector(State.AngularVelocity);
+	return Result;
+}
 
 // Called every frame
 void UAsyncPhysicsComponent::TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction)
 {
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 
-	// ...
+	// 정지했거나 발사 전이면 마지막 상태 유지
+	if (!Kernel || !Context.World)
+	{
+		return;
+	}
+
+	TRACE_CPUPROFILER_EVENT_SCOPE(UAsyncPhysicsComponent::TickComponent);
+
+	const float Step = Context.Constants.StepInterval;
+	StepAccumulator += DeltaTime;
+	for (int32 NumSteps = 0; StepAccumulator >= Step; ++NumSteps)
+	{
+		// 따라잡으려고 스텝이 계속 늘어나지 않도록 남은 시간은 버림
+		if (NumSteps >= MaxStepsPerFrame)
+		{
+			StepAccumulator = 0.f;
+			break;
+		}
+		StepAccumulator -= Step;
+
+		Context.WorldTime = SimTime;
+		Kernel->Step(Context, State);
+		SimTime += Step;
+
+		// 커널은 회전을 지연 반영하므로 매 스텝 렌더링용 회전 확정
+		FBallSimKernel::FlushRotation(State);
+
+		PreviousState = LatestState;
+		LatestState = MakeBallState();
+
+		// 정지했거나 이벤트로 종료되면 마지막 상태를 유지하고 다음 발사까지 진행하지 않음
+		if (State.HandoffReason != EBallHandoffReason::None)
+		{
+			Kernel = nullptr;
+			SetWorldLocationAndRotation(LatestState.Position, LatestState.Rotation);
+			return;
+		}
+	}
+
+	// 남은 시간 비율로 마지막 두 스텝 사이를 보간 (렌더링은 최대 한 스텝 뒤처짐)
+	const float Alpha = FMath::Clamp(StepAccumulator / Step, 0.f, 1.f);
+	const FVector Position = FMath::Lerp(PreviousState.Position, LatestState.Position, Alpha);
+	const FQuat Rotation = FQuat::Slerp(PreviousState.Rotation, LatestState.Rotation, Alpha).GetNormalized();
+	SetWorldLocationAndRotation(Position, Rotation);
 }
 
+void UAsyncPhysicsComponent::GetLatestPhysicsState(FVector& OutPosition, FVector& OutLinearVelocity, FVector& OutAngularVelocity) const
+{
+	OutPosition = LatestState.Position;
+	OutLinearVelocity = LatestState.LinearVelocity;
+	OutAngularVelocity = LatestState.AngularVelocity;
+}
@@ -1,18 +1,34 @@
-// Fill out your copyright notice in the Description page of Project Settings.
+﻿// © 2025 UnrealStudy. All rights reserved.
+// Author: taru00@gmail.com | https://x.com/3devnote
 
 #pragma once
 
 #include "CoreMinimal.h"
 #include "Components/SceneComponent.h"
+#include "BallSimKernel.h"
 #include "AsyncPhysicsComponent.generated.h"
 
+class UBallPhysicsProfile;
 
+// 고정 스텝 1회 진행 후의 공 상태 (월드 기준)
+struct FAsyncBallState
+{
+	FVector Position = FVector::ZeroVector;
+	FQuat Rotation = FQuat::Identity;
+	FVector LinearVelocity = FVector::ZeroVector;
+	FVector AngularVelocity = FVector::ZeroVector;
+};
+
+// 실제 경기 중인 공을 시뮬레이터 커널로 움직이는 컴포넌트
+// 게임 스레드 Tick 에서 프레임 시간을 고정 스텝으로 나눠 진행하고 (정지하면 다음 발사까지 멈춤), 마지막 두 스텝 사이를 보간해서 렌더링
+// 커널은 게임 월드에 Scene Query 를 수행하므로 물리 스레드 (Async Physics Tick) 에서는 진행하지 않음
+// 예측 궤적과 같은 적분/접촉 모델을 사용하므로 예측과 실제 공의 움직임이 일치함
 UCLASS( ClassGroup=(Custom), meta=(BlueprintSpawnableComponent) )
 class BALLSIMULATORDEMO_API UAsyncPhysicsComponent : public USceneComponent
 {
 	GENERATED_BODY()
 
-public:	
+public:
 	// Sets default values for this component's properties
 	UAsyncPhysicsComponent();
 
@@ -20,9 +36,60 @@ protected:
 	// Called when the game starts
 	virtual void BeginPlay() override;
 
-public:	
+public:
 	// Called every frame
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 
-		
+	// 다음 Tick 부터 주어진 초기 상태로 시뮬레이션 시작
+	UFUNCTION(BlueprintCallable, Category = "Ballistic Physics Simulator")
+	void LaunchBall(
+		const FVector& InitialPosition,
+		const FQuat& InitialRotation,
+		const FVector& InitialDirection,
+		const float InitialSpeed,
+		const FVector& InitialSpinAxis,
+		const float InitialSpinSpeed);
+
+	UFUNCTION(BlueprintCallable, Category = "Ballistic Physics Simulator")
+	void StopBall();
+
+	// 가장 최근 스텝의 상태 (렌더링 위치는 이보다 최대 한 스텝 뒤)
+	UFUNCTION(BlueprintPure, Category = "Ballistic Physics Simulator")
+	void GetLatestPhysicsState(FVector& OutPosition, FVector& OutLinearVelocity, FVector& OutAngularVelocity) const;
+
+	// 설정 시 프로파일 튜닝 값과 기능 조합 사용, 없으면 커널 기본값
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ballistic Physics Simulator")
+	UBallPhysicsProfile* PhysicsProfile = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ballistic Physics Simulator")
+	float BallMass = 0.43f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ballistic Physics Simulator")
+	float BallRadius = 11.0f;
+
+	// 커널 고정 스텝 간격 (초), 프레임 시간과 무관하게 같은 궤적을 만듦 (발사 시점에 확정)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ballistic Physics Simulator")
+	float StepInterval = 1.f / 30.f;
+
+	// 한 프레임에 진행할 최대 스텝 수, 프레임이 이보다 길면 남은 시간은 버림 (공이 잠시 느려짐)
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ballistic Physics Simulator")
+	int32 MaxStepsPerFrame = 4;
+
+private:
+	FAsyncBallState MakeBallState() const;
+
+	FBallSimContext Context;
+	FBallSimState State;
+	FBallSurfaceCache SurfaceCache;
+	const FBallSimKernel* Kernel = nullptr;
+
+	// 커널 월드 시간 (발사 시 월드 시간부터 스텝마다 진행)
+	double SimTime = 0.0;
+
+	// 아직 스텝으로 진행하지 않은 프레임 시간
+	float StepAccumulator = 0.f;
+
+	// 직전 / 최신 스텝 결과, 렌더링은 그 사이를 StepAccumulator 비율로 보간
+	FAsyncBallState PreviousState;
+	FAsyncBallState LatestState;
 };